@@ -56,6 +56,9 @@ struct Celllib {
   std::unordered_map<std::string, Cell> cells;
 
   void read(const std::filesystem::path&);
+  void read(const std::filesystem::path&, const std::filesystem::path&);
+  bool load_cache(const std::filesystem::path&, uint64_t);
+  bool save_cache(const std::filesystem::path&, uint64_t) const;
   void scale_time(float);
   void scale_resistance(float);
   void scale_power(float);
@@ -85,6 +88,10 @@ struct Celllib {
 // Operator <<
 std::ostream& operator << (std::ostream&, const Celllib&);
 
+// Function: celllib_fingerprint
+// Content hash of a liberty file, the key of its binary cache.
+std::optional<uint64_t> celllib_fingerprint(const std::filesystem::path&);
+
 
 };  // end of namespace ot. -----------------------------------------------------------------------
 
@@ -0,0 +1,434 @@
+#include <ot/liberty/celllib.hpp>
+
+namespace ot {
+
+// Binary cache layout (native byte order):
+//
+//   magic[8] | version:u32 | byte order:u32 | key:u64 | payload size:u64 | payload
+//
+// The payload lists the library attributes, the lut templates and the cells
+// in the order written by CelllibCacheWriter. Strings and float arrays are
+// stored as a u64 length followed by the raw bytes, optionals as a u8 flag
+// followed by the value, and units as their value in SI base units.
+
+static constexpr char celllib_cache_magic[8] = {'O', 'T', 'C', 'L', 'I', 'B', 0, 0};
+static constexpr uint32_t celllib_cache_version = 1;
+static constexpr uint32_t celllib_cache_byte_order = 0x01020304;
+
+// Struct: CelllibCacheHeader
+struct CelllibCacheHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t byte_order;
+  uint64_t key;
+  uint64_t size;
+};
+
+// ------------------------------------------------------------------------------------------------
+
+// Struct: CelllibCacheWriter
+struct CelllibCacheWriter {
+
+  std::string buffer;
+
+  template <typename T>
+  void pod(const T& v) {
+    buffer.append(reinterpret_cast<const char*>(&v), sizeof(T));
+  }
+
+  void str(const std::string& s) {
+    pod<uint64_t>(s.size());
+    buffer.append(s);
+  }
+
+  void floats(const std::vector<float>& v) {
+    pod<uint64_t>(v.size());
+    buffer.append(reinterpret_cast<const char*>(v.data()), v.size() * sizeof(float));
+  }
+
+  template <typename T>
+  void opt(const std::optional<T>& v) {
+    pod<uint8_t>(v.has_value());
+    if(v) {
+      pod(*v);
+    }
+  }
+
+  template <typename U>
+  void unit(const std::optional<U>& v) {
+    pod<uint8_t>(v.has_value());
+    if(v) {
+      pod<double>(v->value());
+    }
+  }
+
+  void lut(const std::optional<Lut>& lut) {
+    pod<uint8_t>(lut.has_value());
+    if(lut) {
+      str(lut->name);
+      floats(lut->indices1);
+      floats(lut->indices2);
+      floats(lut->table);
+      pod<uint8_t>(lut->lut_template != nullptr);
+    }
+  }
+};
+
+// Struct: CelllibCacheReader
+// Bounds-checked reader; a truncated or corrupt payload clears the ok flag.
+struct CelllibCacheReader {
+
+  const char* itr;
+  const char* end;
+  bool ok {true};
+
+  template <typename T>
+  T pod() {
+    T v {};
+    if(static_cast<size_t>(end - itr) < sizeof(T)) {
+      ok = false;
+      itr = end;
+      return v;
+    }
+    std::memcpy(&v, itr, sizeof(T));
+    itr += sizeof(T);
+    return v;
+  }
+
+  // number of elements, each taking at least the given number of bytes
+  size_t count(size_t bytes) {
+    auto n = pod<uint64_t>();
+    if(n > static_cast<size_t>(end - itr) / bytes) {
+      ok = false;
+      itr = end;
+      return 0;
+    }
+    return n;
+  }
+
+  std::string str() {
+    auto n = count(1);
+    std::string s(itr, n);
+    itr += n;
+    return s;
+  }
+
+  std::vector<float> floats() {
+    auto n = count(sizeof(float));
+    std::vector<float> v(n);
+    std::memcpy(v.data(), itr, n * sizeof(float));
+    itr += n * sizeof(float);
+    return v;
+  }
+
+  template <typename T>
+  std::optional<T> opt() {
+    if(pod<uint8_t>()) {
+      return pod<T>();
+    }
+    return std::nullopt;
+  }
+
+  template <typename U>
+  std::optional<U> unit() {
+    if(pod<uint8_t>()) {
+      return U(pod<double>());
+    }
+    return std::nullopt;
+  }
+
+  std::optional<Lut> lut(const Celllib& lib) {
+    if(!pod<uint8_t>()) {
+      return std::nullopt;
+    }
+    Lut lut;
+    lut.name = str();
+    lut.indices1 = floats();
+    lut.indices2 = floats();
+    lut.table = floats();
+    if(pod<uint8_t>()) {
+      lut.lut_template = lib.lut_template(lut.name);
+    }
+    return lut;
+  }
+};
+
+// ------------------------------------------------------------------------------------------------
+
+// Function: celllib_fingerprint
+std::optional<uint64_t> celllib_fingerprint(const std::filesystem::path& path) {
+
+  MappedFile file(path);
+
+  if(!file.is_open()) {
+    return std::nullopt;
+  }
+
+  constexpr uint64_t prime = 0x9e3779b97f4a7c15ull;
+
+  const char* beg = file.data();
+  size_t size = file.size();
+  uint64_t h = 0xcbf29ce484222325ull ^ size;
+
+  size_t i = 0;
+
+  for(; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+    uint64_t w;
+    std::memcpy(&w, beg + i, sizeof(w));
+    h = (h ^ w) * prime;
+    h ^= h >> 32;
+  }
+
+  for(; i < size; ++i) {
+    h = (h ^ static_cast<uint8_t>(beg[i])) * prime;
+    h ^= h >> 32;
+  }
+
+  return h;
+}
+
+// Procedure: read
+// Reads the library from the binary cache in the given directory if it holds an entry for the
+// content of the liberty file; otherwise parses the file and adds it to the cache.
+void Celllib::read(const std::filesystem::path& path, const std::filesystem::path& cache_dir) {
+
+  auto key = celllib_fingerprint(path);
+
+  if(!key) {
+    read(path);
+    return;
+  }
+
+  std::ostringstream oss;
+  oss << std::hex << std::setw(16) << std::setfill('0') << *key << ".otlib";
+  auto cache = cache_dir / oss.str();
+
+  if(load_cache(cache, *key)) {
+    OT_LOGI("loaded celllib ", path, " from cache ", cache);
+    return;
+  }
+
+  read(path);
+
+  if(!save_cache(cache, *key)) {
+    OT_LOGW("failed to write celllib cache ", cache);
+  }
+}
+
+// Function: save_cache
+bool Celllib::save_cache(const std::filesystem::path& path, uint64_t key) const {
+
+  CelllibCacheWriter w;
+
+  w.str(name);
+  w.opt(delay_model);
+
+  w.unit(time_unit);
+  w.unit(power_unit);
+  w.unit(resistance_unit);
+  w.unit(capacitance_unit);
+  w.unit(current_unit);
+  w.unit(voltage_unit);
+
+  w.opt(default_cell_leakage_power);
+  w.opt(default_inout_pin_cap);
+  w.opt(default_input_pin_cap);
+  w.opt(default_output_pin_cap);
+  w.opt(default_fanout_load);
+  w.opt(default_max_fanout);
+  w.opt(default_max_transition);
+
+  w.pod<uint64_t>(lut_templates.size());
+  for(const auto& [lname, lt] : lut_templates) {
+    w.str(lname);
+    w.str(lt.name);
+    w.opt(lt.variable1);
+    w.opt(lt.variable2);
+    w.floats(lt.indices1);
+    w.floats(lt.indices2);
+  }
+
+  w.pod<uint64_t>(cells.size());
+  for(const auto& [cname, cell] : cells) {
+    w.str(cname);
+    w.str(cell.name);
+    w.str(cell.cell_footprint);
+    w.opt(cell.leakage_power);
+    w.opt(cell.area);
+    w.pod<uint64_t>(cell.cellpins.size());
+    for(const auto& [pname, cpin] : cell.cellpins) {
+      w.str(pname);
+      w.str(cpin.name);
+      w.str(cpin.original_pin);
+      w.opt(cpin.direction);
+      w.opt(cpin.capacitance);
+      w.opt(cpin.max_capacitance);
+      w.opt(cpin.min_capacitance);
+      w.opt(cpin.max_transition);
+      w.opt(cpin.min_transition);
+      w.opt(cpin.fall_capacitance);
+      w.opt(cpin.rise_capacitance);
+      w.opt(cpin.fanout_load);
+      w.opt(cpin.max_fanout);
+      w.opt(cpin.min_fanout);
+      w.opt(cpin.is_clock);
+      w.pod<uint64_t>(cpin.timings.size());
+      for(const auto& timing : cpin.timings) {
+        w.str(timing.related_pin);
+        w.opt(timing.sense);
+        w.opt(timing.type);
+        w.lut(timing.cell_rise);
+        w.lut(timing.cell_fall);
+        w.lut(timing.rise_transition);
+        w.lut(timing.fall_transition);
+        w.lut(timing.rise_constraint);
+        w.lut(timing.fall_constraint);
+      }
+    }
+  }
+
+  CelllibCacheHeader header;
+  std::memcpy(header.magic, celllib_cache_magic, sizeof(header.magic));
+  header.version = celllib_cache_version;
+  header.byte_order = celllib_cache_byte_order;
+  header.key = key;
+  header.size = w.buffer.size();
+
+  std::error_code ec;
+
+  if(path.has_parent_path()) {
+    std::filesystem::create_directories(path.parent_path(), ec);
+  }
+
+  // write to a private file first so that concurrent runs never see a partial cache
+  auto tmp = path;
+  tmp += ".tmp" + std::to_string(::getpid());
+
+  {
+    std::ofstream ofs(tmp, std::ios::binary);
+    ofs.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    ofs.write(w.buffer.data(), w.buffer.size());
+    if(!ofs) {
+      ofs.close();
+      std::filesystem::remove(tmp, ec);
+      return false;
+    }
+  }
+
+  std::filesystem::rename(tmp, path, ec);
+
+  if(ec) {
+    std::filesystem::remove(tmp, ec);
+    return false;
+  }
+
+  return true;
+}
+
+// Function: load_cache
+// Replaces the library with the content of a cache file. Returns false, leaving the library
+// empty, if the file is missing, corrupt, of another format version, or not keyed by the
+// given fingerprint.
+bool Celllib::load_cache(const std::filesystem::path& path, uint64_t key) {
+
+  *this = Celllib();
+
+  MappedFile file(path);
+
+  if(!file.is_open() || file.size() < sizeof(CelllibCacheHeader)) {
+    return false;
+  }
+
+  CelllibCacheHeader header;
+  std::memcpy(&header, file.data(), sizeof(header));
+
+  if(std::memcmp(header.magic, celllib_cache_magic, sizeof(header.magic)) != 0 ||
+     header.version != celllib_cache_version ||
+     header.byte_order != celllib_cache_byte_order ||
+     header.key != key ||
+     header.size != file.size() - sizeof(header)) {
+    return false;
+  }
+
+  CelllibCacheReader r {file.data() + sizeof(header), file.data() + file.size()};
+
+  name = r.str();
+  delay_model = r.opt<DelayModel>();
+
+  time_unit = r.unit<second_t>();
+  power_unit = r.unit<watt_t>();
+  resistance_unit = r.unit<ohm_t>();
+  capacitance_unit = r.unit<farad_t>();
+  current_unit = r.unit<ampere_t>();
+  voltage_unit = r.unit<volt_t>();
+
+  default_cell_leakage_power = r.opt<float>();
+  default_inout_pin_cap = r.opt<float>();
+  default_input_pin_cap = r.opt<float>();
+  default_output_pin_cap = r.opt<float>();
+  default_fanout_load = r.opt<float>();
+  default_max_fanout = r.opt<float>();
+  default_max_transition = r.opt<float>();
+
+  // lut templates precede the cells so that luts can link to them
+  auto num_lut_templates = r.count(1);
+  lut_templates.reserve(num_lut_templates);
+  for(size_t i=0; i<num_lut_templates && r.ok; ++i) {
+    auto& lt = lut_templates[r.str()];
+    lt.name = r.str();
+    lt.variable1 = r.opt<LutVar>();
+    lt.variable2 = r.opt<LutVar>();
+    lt.indices1 = r.floats();
+    lt.indices2 = r.floats();
+  }
+
+  auto num_cells = r.count(1);
+  cells.reserve(num_cells);
+  for(size_t i=0; i<num_cells && r.ok; ++i) {
+    auto& cell = cells[r.str()];
+    cell.name = r.str();
+    cell.cell_footprint = r.str();
+    cell.leakage_power = r.opt<float>();
+    cell.area = r.opt<float>();
+    auto num_cellpins = r.count(1);
+    cell.cellpins.reserve(num_cellpins);
+    for(size_t j=0; j<num_cellpins && r.ok; ++j) {
+      auto& cpin = cell.cellpins[r.str()];
+      cpin.name = r.str();
+      cpin.original_pin = r.str();
+      cpin.direction = r.opt<CellpinDirection>();
+      cpin.capacitance = r.opt<float>();
+      cpin.max_capacitance = r.opt<float>();
+      cpin.min_capacitance = r.opt<float>();
+      cpin.max_transition = r.opt<float>();
+      cpin.min_transition = r.opt<float>();
+      cpin.fall_capacitance = r.opt<float>();
+      cpin.rise_capacitance = r.opt<float>();
+      cpin.fanout_load = r.opt<float>();
+      cpin.max_fanout = r.opt<float>();
+      cpin.min_fanout = r.opt<float>();
+      cpin.is_clock = r.opt<bool>();
+      cpin.timings.resize(r.count(1));
+      for(auto& timing : cpin.timings) {
+        timing.related_pin = r.str();
+        timing.sense = r.opt<TimingSense>();
+        timing.type = r.opt<TimingType>();
+        timing.cell_rise = r.lut(*this);
+        timing.cell_fall = r.lut(*this);
+        timing.rise_transition = r.lut(*this);
+        timing.fall_transition = r.lut(*this);
+        timing.rise_constraint = r.lut(*this);
+        timing.fall_constraint = r.lut(*this);
+      }
+    }
+  }
+
+  if(!r.ok || r.itr != r.end) {
+    *this = Celllib();
+    return false;
+  }
+
+  return true;
+}
+
+};  // end of namespace ot. -----------------------------------------------------------------------
@@ -79,6 +79,24 @@ void Shell::_set_num_threads() {
 
 // ------------------------------------------------------------------------------------------------
 
+// Procedure: set_level_chunk_size
+void Shell::_set_level_chunk_size() {
+  if(size_t N = 0; _is >> N) {
+    _timer.set_level_chunk_size(N);
+  }
+}
+
+// ------------------------------------------------------------------------------------------------
+
+// Procedure: set_celllib_cache
+void Shell::_set_celllib_cache() {
+  if(std::filesystem::path path; _is >> path) {
+    _timer.set_celllib_cache(std::move(path));
+  }
+}
+
+// ------------------------------------------------------------------------------------------------
+
 // Procedure: read_verilog
 void Shell::_read_verilog() {
   if(std::filesystem::path path; _is >> path) {
@@ -50,6 +50,8 @@ void Shell::_dump_help() {
 List of commonly used commands:\n\
 \n[Builder] operations to build the timer\n\n\
   set_num_threads    <N>\n\
+  set_level_chunk_size <N>\n\
+  set_celllib_cache  <dir>\n\
   read_celllib       [-min|-max] <file>\n\
   read_verilog       <file>\n\
   read_spef          <file>\n\
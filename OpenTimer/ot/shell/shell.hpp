@@ -45,6 +45,8 @@ class Shell {
     // builder
     void _set_units              ();
     void _set_num_threads        ();
+    void _set_level_chunk_size   ();
+    void _set_celllib_cache      ();
     void _read_verilog           ();      
     void _read_spef              ();         
     void _read_celllib           ();
@@ -120,6 +122,8 @@ class Shell {
       // Builder
       {"set_units",               &Shell::_set_units},
       {"set_num_threads",         &Shell::_set_num_threads},
+      {"set_level_chunk_size",    &Shell::_set_level_chunk_size},
+      {"set_celllib_cache",       &Shell::_set_celllib_cache},
       {"read_verilog",            &Shell::_read_verilog},
       {"read_spef",               &Shell::_read_spef},
       {"read_celllib",            &Shell::_read_celllib},
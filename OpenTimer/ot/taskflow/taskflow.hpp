@@ -1184,6 +1184,8 @@ class BasicTaskflow : public FlowBuilder {
     size_t num_workers() const;
     size_t num_topologies() const;
 
+    void num_workers(unsigned);
+
     std::string dump() const;
     std::string dump_topologies() const;
 
@@ -1355,6 +1357,16 @@ size_t BasicTaskflow<E>::num_workers() const {
   return _executor->num_workers();
 }
 
+// Procedure: num_workers
+// Replaces the executor by one with N workers. Dispatched topologies are
+// finished first, the graph that has not been dispatched yet is kept.
+template <template <typename...> typename E>
+void BasicTaskflow<E>::num_workers(unsigned N) {
+  wait_for_topologies();
+  _executor = std::make_shared<Executor>(N);
+  _partition_factor = N;
+}
+
 // Function: num_topologies
 template <template <typename...> typename E>
 size_t BasicTaskflow<E>::num_topologies() const {
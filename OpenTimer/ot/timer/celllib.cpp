@@ -22,6 +22,15 @@ bool Timer::_is_redundant_timing(const Timing& timing, Split el) const {
   return false;
 }
 
+// Function: set_celllib_cache
+// Keeps binary copies of the parsed libraries in the given directory, keyed by the content
+// hash of the liberty file, and loads later reads of the same file from there.
+Timer& Timer::set_celllib_cache(std::filesystem::path dir) {
+  std::scoped_lock lock(_mutex);
+  _celllib_cache = std::move(dir);
+  return *this;
+}
+
 // Function: read_celllib
 Timer& Timer::read_celllib(std::filesystem::path path, std::optional<Split> el) {
   
@@ -36,8 +45,13 @@ Timer& Timer::read_celllib(std::filesystem::path path, std::optional<Split> el)
     true
   );
 
-  parser.work([path=std::move(path), lib] () {
-    lib->read(path);
+  parser.work([path=std::move(path), cache=_celllib_cache, lib] () {
+    if(cache) {
+      lib->read(path, *cache);
+    }
+    else {
+      lib->read(path);
+    }
   });
 
   // Placeholder to add_lineage
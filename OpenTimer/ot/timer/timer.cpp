@@ -5,12 +5,22 @@ namespace ot {
 // ------------------------------------------------------------------------------------------------
 
 // Function: set_num_threads
+// The caller only waits for the propagation tasks, so n threads are n workers.
+// Zero uses all hardware threads.
 Timer& Timer::set_num_threads(unsigned n) {
   std::scoped_lock lock(_mutex);
-  unsigned w = (n == 0) ? 0 : n-1;
-  OT_LOGI("using ", n, " threads (", w, " worker)");
-  // TODO
-  //_taskflow.num_workers(w);
+  unsigned w = (n == 0) ? std::max(1u, std::thread::hardware_concurrency()) : n;
+  OT_LOGI("using ", w, " threads");
+  _taskflow.num_workers(w);
+  return *this;
+}
+
+// Function: set_level_chunk_size
+// Propagates pins of the same level in chunks of n pins per task. Zero
+// creates one task per pin, with one dependency per timing arc.
+Timer& Timer::set_level_chunk_size(size_t n) {
+  std::scoped_lock lock(_mutex);
+  _level_chunk_size = n;
   return *this;
 }
 
@@ -33,6 +43,17 @@ tf::Task Timer::_insert_action(const std::string& name) {
                   .name(to_string("[A", A++, "] ", name));
 }
 
+// Function: _insert_prop_task
+// Propagation tasks are created for every candidate pin at every update and
+// are named only when the task graph is dumped for debugging.
+tf::Task Timer::_insert_prop_task([[maybe_unused]] const char* prefix, [[maybe_unused]] const std::string& name) {
+#ifdef OT_DEBUG_TASKFLOW
+  return _insert_action(prefix + name);
+#else
+  return _taskflow.placeholder();
+#endif
+}
+
 // Function: _max_pin_name_size
 size_t Timer::_max_pin_name_size() const {
   if(_pins.empty()) {
@@ -923,6 +944,11 @@ void Timer::_build_prop_tasks() {
   // explore propagation candidates
   _build_prop_cands();
 
+  if(_level_chunk_size > 0) {
+    _build_level_prop_tasks();
+    return;
+  }
+
   // Emplace the fprop task
   // (1) propagate the rc timing
   // (2) propagate the slew 
@@ -930,7 +956,7 @@ void Timer::_build_prop_tasks() {
   // (4) propagate the arrival time.
   for(auto pin : _fprop_cands) {
     assert(!pin->_ftask);
-    pin->_ftask = _insert_action("fprop_"s + pin->_name).work([this, pin] () {
+    pin->_ftask = _insert_prop_task("fprop_", pin->_name).work([this, pin] () {
       _fprop_rc_timing(*pin);
       _fprop_slew(*pin);
       _fprop_delay(*pin);
@@ -955,7 +981,7 @@ void Timer::_build_prop_tasks() {
   // (1) propagate the required arrival time
   for(auto pin : _bprop_cands) {
     assert(!pin->_btask);
-    pin->_btask = _insert_action("bprop_"s + pin->_name).work([this, pin] () {
+    pin->_btask = _insert_prop_task("bprop_", pin->_name).work([this, pin] () {
       _bprop_rat(*pin);
     });
   }
@@ -981,6 +1007,105 @@ void Timer::_build_prop_tasks() {
 
 }
 
+// Function: _levelize
+// Groups the candidates by their distance from the sources of the
+// propagation, forward along the fanout arcs or backward along the fanin
+// arcs. Loop breakers are skipped, so the candidate graph is acyclic.
+std::vector<std::vector<Pin*>> Timer::_levelize(const std::deque<Pin*>& cands, int state, bool forward) {
+
+  std::vector<std::vector<Pin*>> levels;
+
+  if(_prop_pending.size() < _idx2pin.size()) {
+    _prop_pending.resize(_idx2pin.size());
+    _prop_level.resize(_idx2pin.size());
+  }
+
+  auto is_dep = [state] (const Arc* arc, const Pin& other) {
+    return !arc->_has_state(Arc::LOOP_BREAKER) && other._has_state(state);
+  };
+
+  std::vector<Pin*> queue;
+  queue.reserve(cands.size());
+
+  for(auto pin : cands) {
+    size_t n = 0;
+    for(auto arc : forward ? pin->_fanin : pin->_fanout) {
+      n += is_dep(arc, forward ? arc->_from : arc->_to);
+    }
+    _prop_pending[pin->_idx] = n;
+    _prop_level[pin->_idx] = 0;
+    if(n == 0) {
+      queue.push_back(pin);
+    }
+  }
+
+  for(size_t i=0; i<queue.size(); ++i) {
+    auto pin = queue[i];
+    auto l = _prop_level[pin->_idx];
+    if(l >= levels.size()) {
+      levels.resize(l + 1);
+    }
+    levels[l].push_back(pin);
+    for(auto arc : forward ? pin->_fanout : pin->_fanin) {
+      if(auto& next = forward ? arc->_to : arc->_from; is_dep(arc, next)) {
+        _prop_level[next._idx] = std::max(_prop_level[next._idx], l + 1);
+        if(--_prop_pending[next._idx] == 0) {
+          queue.push_back(&next);
+        }
+      }
+    }
+  }
+
+  assert(queue.size() == cands.size());
+
+  return levels;
+}
+
+// Procedure: _build_level_prop_tasks
+// Creates one task per chunk of pins of the same level, separated by one
+// synchronization task per level. The task graph then has about
+// #pins/chunk tasks and no per-arc dependencies. All forward propagation
+// finishes before the backward propagation starts.
+void Timer::_build_level_prop_tasks() {
+
+  _fprop_levels = _levelize(_fprop_cands, Pin::FPROP_CAND, true);
+  _bprop_levels = _levelize(_bprop_cands, Pin::BPROP_CAND, false);
+
+  std::optional<tf::Task> barrier;
+
+  auto emplace = [&] (const char* prefix, auto& levels, auto&& prop) {
+    for(size_t l=0; l<levels.size(); ++l) {
+      auto sync = _insert_prop_task(prefix, "sync_"s + std::to_string(l));
+      for(size_t b=0; b<levels[l].size(); b+=_level_chunk_size) {
+        auto e = std::min(b + _level_chunk_size, levels[l].size());
+        auto task = _insert_prop_task(prefix, std::to_string(l) + "_"s + std::to_string(b))
+                      .work([&pins=levels[l], b, e, prop] () {
+                        for(size_t i=b; i<e; ++i) {
+                          prop(*pins[i]);
+                        }
+                      });
+        if(barrier) {
+          barrier->precede(task);
+        }
+        task.precede(sync);
+      }
+      barrier = sync;
+    }
+  };
+
+  emplace("fprop_", _fprop_levels, [this] (Pin& pin) {
+    _fprop_rc_timing(pin);
+    _fprop_slew(pin);
+    _fprop_delay(pin);
+    _fprop_at(pin);
+    _fprop_test(pin);
+  });
+
+  emplace("bprop_", _bprop_levels, [this] (Pin& pin) {
+    _bprop_rat(pin);
+  });
+}
+
 // Procedure: _clear_prop_tasks
 void Timer::_clear_prop_tasks() {
   
@@ -993,6 +1118,8 @@ void Timer::_clear_prop_tasks() {
 
   _fprop_cands.clear();
   _bprop_cands.clear();
+  _fprop_levels.clear();
+  _bprop_levels.clear();
 }
 
 // Function: update_timing
@@ -1026,7 +1153,9 @@ void Timer::_update_timing() {
   _build_prop_tasks();
 
   // debug the graph
-  //_taskflow.dump(std::cout);
+#ifdef OT_DEBUG_TASKFLOW
+  _taskflow.dump(std::cout);
+#endif
 
   // Execute the task
   _taskflow.wait_for_all();
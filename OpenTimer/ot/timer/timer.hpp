@@ -35,6 +35,8 @@ class Timer {
     
     // Builder
     Timer& set_num_threads(unsigned);
+    Timer& set_level_chunk_size(size_t);
+    Timer& set_celllib_cache(std::filesystem::path);
     Timer& read_celllib(std::filesystem::path, std::optional<Split> = {});
     Timer& read_verilog(std::filesystem::path);
     Timer& read_spef(std::filesystem::path);
@@ -130,6 +132,10 @@ class Timer {
     
     bool _scc_analysis {false};
 
+    size_t _level_chunk_size {0};
+
+    std::optional<std::filesystem::path> _celllib_cache;
+
     std::optional<tf::Task> _lineage;
     std::optional<CpprAnalysis> _cppr_analysis;
     std::optional<second_t> _time_unit;
@@ -164,6 +170,11 @@ class Timer {
     std::deque<Pin*> _fprop_cands;
     std::deque<Pin*> _bprop_cands;
 
+    std::vector<std::vector<Pin*>> _fprop_levels;
+    std::vector<std::vector<Pin*>> _bprop_levels;
+    std::vector<size_t> _prop_pending;
+    std::vector<size_t> _prop_level;
+
     IndexGenerator<size_t> _pin_idx_gen {0u};
     IndexGenerator<size_t> _arc_idx_gen {0u};
     
@@ -202,7 +213,9 @@ class Timer {
     void _build_fprop_cands(Pin&);
     void _build_bprop_cands(Pin&);
     void _build_prop_tasks();
+    void _build_level_prop_tasks();
     void _clear_prop_tasks();
+    std::vector<std::vector<Pin*>> _levelize(const std::deque<Pin*>&, int, bool);
     void _read_spef(spef::Spef&);;
     void _verilog(vlog::Module&);
     void _timing(tau15::Timing&);
@@ -263,6 +276,7 @@ class Timer {
     
     tf::Task _insert_builder(const std::string&, bool);
     tf::Task _insert_action(const std::string&);
+    tf::Task _insert_prop_task(const char*, const std::string&);
 
     SfxtCache _sfxt_cache(const Endpoint&) const;
     SfxtCache _sfxt_cache(const PrimaryOutput&, Split, Tran) const;
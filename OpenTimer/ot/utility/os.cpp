@@ -1,5 +1,9 @@
 #include <ot/utility/os.hpp>
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
 namespace ot {
 
 // Function: user_home
@@ -39,4 +43,62 @@ std::unique_ptr<char*, std::function<void(char**)>> c_args(
   return ptr;
 }
 
+// ------------------------------------------------------------------------------------------------
+
+// Constructor
+MappedFile::MappedFile(const std::filesystem::path& path) {
+  open(path);
+}
+
+// Destructor
+MappedFile::~MappedFile() {
+  close();
+}
+
+// Function: open
+// Maps the whole file. An empty file is open with a null data pointer.
+bool MappedFile::open(const std::filesystem::path& path) {
+
+  close();
+
+  int fd = ::open(path.c_str(), O_RDONLY);
+
+  if(fd == -1) {
+    return false;
+  }
+
+  struct stat st;
+
+  if(::fstat(fd, &st) == -1) {
+    ::close(fd);
+    return false;
+  }
+
+  if(st.st_size > 0) {
+    auto addr = ::mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if(addr == MAP_FAILED) {
+      ::close(fd);
+      return false;
+    }
+    _addr = addr;
+    _size = st.st_size;
+  }
+
+  // the mapping stays valid after the descriptor is closed
+  ::close(fd);
+  _open = true;
+
+  return true;
+}
+
+// Procedure: close
+void MappedFile::close() {
+  if(_addr) {
+    ::munmap(_addr, _size);
+  }
+  _addr = nullptr;
+  _size = 0;
+  _open = false;
+}
+
 };  // end of namespace ot. -----------------------------------------------------------------------
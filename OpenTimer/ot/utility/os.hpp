@@ -9,6 +9,7 @@
 #include <cstring>
 #include <pwd.h>
 #include <experimental/filesystem>
+#include <string_view>
 
 namespace std {
   namespace filesystem = experimental::filesystem;
@@ -22,6 +23,53 @@ std::filesystem::path user_home();
 // Function: c_args
 std::unique_ptr<char*, std::function<void(char**)>> c_args(const std::vector<std::string>&);
 
+// Class: MappedFile
+// Read-only memory mapping of a file, unmapped on destruction.
+class MappedFile {
+
+  public:
+
+    MappedFile() = default;
+    MappedFile(const std::filesystem::path&);
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator = (const MappedFile&) = delete;
+    ~MappedFile();
+
+    bool open(const std::filesystem::path&);
+    void close();
+
+    inline bool is_open() const;
+    inline const char* data() const;
+    inline size_t size() const;
+    inline std::string_view view() const;
+
+  private:
+
+    void* _addr {nullptr};
+    size_t _size {0};
+    bool _open {false};
+};
+
+// Function: is_open
+inline bool MappedFile::is_open() const {
+  return _open;
+}
+
+// Function: data
+inline const char* MappedFile::data() const {
+  return static_cast<const char*>(_addr);
+}
+
+// Function: size
+inline size_t MappedFile::size() const {
+  return _size;
+}
+
+// Function: view
+inline std::string_view MappedFile::view() const {
+  return {data(), _size};
+}
+
 
 };  // end of namespace ot. -----------------------------------------------------------------------
 
@@ -0,0 +1,33 @@
+#include <percy/percy.hpp>
+#include <mockturtle/algorithms/node_resynthesis/exact.hpp>
+
+namespace mockturtle::detail
+{
+
+std::optional<exact_chain> percy_synthesize( kitty::dynamic_truth_table const& tt, int32_t conflict_limit )
+{
+  percy::spec spec;
+  spec.conflict_limit = conflict_limit;
+  spec.set_output( 0, tt );
+
+  percy::chain c;
+  percy::bsat_wrapper solver;
+  percy::knuth_encoder encoder( solver );
+  if ( percy::synthesize( spec, c, solver, encoder ) != percy::success )
+  {
+    return std::nullopt;
+  }
+
+  exact_chain chain;
+  chain.num_inputs = tt.num_vars();
+  for ( auto i = 0; i < c.get_nr_steps(); ++i )
+  {
+    auto const& step = c.get_step( i );
+    chain.steps.push_back( {static_cast<uint32_t>( step[0] ), static_cast<uint32_t>( step[1] ),
+                            static_cast<uint32_t>( *c.get_operator( i ).cbegin() & 0xf )} );
+  }
+  chain.output = c.get_outputs()[0];
+  return chain;
+}
+
+} /* namespace mockturtle::detail */
@@ -0,0 +1,164 @@
+/********************************************
+ *  Source file: gia_bridge.hpp             *
+ *  Description: In-memory conversion       *
+ *               between mockturtle         *
+ *               networks and ABC's GIA     *
+ ********************************************
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <aig/gia/gia.h>
+#include <aig/gia/giaAig.h>
+#include <opt/dar/dar.h>
+
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/traits.hpp>
+#include <mockturtle/views/topo_view.hpp>
+
+namespace alice{
+
+  /* Builds a GIA with the same inputs, outputs and registers as ntk. Registers are the last
+     combinational inputs and outputs of both networks, so they map onto GIA's register
+     convention directly, and their reset values are kept in vRegInits. Gates are visited in
+     topological order and AND, XOR and majority gates are strashed into AND nodes. */
+  template<class Ntk>
+  abc::Gia_Man_t* ntk_to_gia(Ntk const& ntk, std::string const& name = ""){
+    abc::Gia_Man_t* gia = abc::Gia_ManStart(4 * ntk.size() + 1);
+    gia->pName = abc::Abc_UtilStrsav((char*)name.c_str());
+    abc::Gia_ManHashAlloc(gia);
+
+    std::vector<int> lits(ntk.size(), 0);
+    auto lit = [&](auto const& f){
+      return abc::Abc_LitNotCond(lits[ntk.node_to_index(ntk.get_node(f))], ntk.is_complemented(f));
+    };
+
+    ntk.foreach_ci([&](auto const& n){
+      lits[ntk.node_to_index(n)] = abc::Gia_ManAppendCi(gia);
+    });
+    //starts from all combinational outputs, topo_view would miss logic that only feeds XAG registers
+    for(auto const& n : mockturtle::combinational_topo_order(ntk)){
+      std::vector<int> fanins;
+      ntk.foreach_fanin(n, [&](auto const& f){
+        fanins.push_back(lit(f));
+      });
+
+      int result = 0;
+      if(fanins.size() == 3u){
+        result = abc::Gia_ManHashMaj(gia, fanins[0], fanins[1], fanins[2]);
+      }
+      else if constexpr(mockturtle::has_is_xor_v<Ntk>){
+        result = ntk.is_xor(n) ? abc::Gia_ManHashXor(gia, fanins[0], fanins[1]) : abc::Gia_ManHashAnd(gia, fanins[0], fanins[1]);
+      }
+      else{
+        result = abc::Gia_ManHashAnd(gia, fanins[0], fanins[1]);
+      }
+      lits[ntk.node_to_index(n)] = result;
+    }
+    ntk.foreach_co([&](auto const& f){
+      abc::Gia_ManAppendCo(gia, lit(f));
+    });
+
+    abc::Gia_ManHashStop(gia);
+    abc::Gia_ManSetRegNum(gia, ntk.num_latches());
+    if(ntk.num_latches() > 0){
+      gia->vRegInits = abc::Vec_IntAlloc(ntk.num_latches());
+      for(uint32_t i = 0; i < ntk.num_latches(); i++){
+        abc::Vec_IntPush(gia->vRegInits, ntk.latch_reset(i));
+      }
+    }
+    return gia;
+  }
+
+  /* Inverse of ntk_to_gia. Registers take their reset values from vRegInits, or zero, as ABC
+     assumes, when the GIA does not carry any. */
+  inline mockturtle::aig_network gia_to_aig(abc::Gia_Man_t* gia){
+    using signal = mockturtle::aig_network::signal;
+
+    mockturtle::aig_network aig;
+    aig._storage->nodes.reserve(abc::Gia_ManObjNum(gia));
+    if(gia->pName){
+      aig._storage->net_name = gia->pName;
+    }
+
+    std::vector<signal> signals(abc::Gia_ManObjNum(gia), aig.get_constant(false));
+    auto fanin = [&](abc::Gia_Obj_t* obj, int index){
+      const auto id = index == 0 ? abc::Gia_ObjFaninId0p(gia, obj) : abc::Gia_ObjFaninId1p(gia, obj);
+      const auto compl_ = index == 0 ? abc::Gia_ObjFaninC0(obj) : abc::Gia_ObjFaninC1(obj);
+      return compl_ ? aig.create_not(signals[id]) : signals[id];
+    };
+
+    abc::Gia_Obj_t* obj;
+    int i;
+    Gia_ManForEachObj1(gia, obj, i){
+      if(abc::Gia_ObjIsCi(obj)){
+        signals[i] = abc::Gia_ObjIsPi(gia, obj) ? aig.create_pi() : aig.create_ro();
+      }
+      else if(abc::Gia_ObjIsAnd(obj)){
+        signals[i] = aig.create_and(fanin(obj, 0), fanin(obj, 1));
+      }
+    }
+    Gia_ManForEachPo(gia, obj, i){
+      aig.create_po(fanin(obj, 0));
+    }
+    const bool has_resets = gia->vRegInits && abc::Vec_IntSize(gia->vRegInits) == abc::Gia_ManRegNum(gia);
+    Gia_ManForEachRi(gia, obj, i){
+      aig.create_ri(fanin(obj, 0), has_resets ? abc::Vec_IntEntry(gia->vRegInits, i) : 0);
+    }
+    return aig;
+  }
+
+  /* Runs a sequence of ABC GIA engines separated by ';', for example "dc2;syn3". Returns
+     false and leaves gia untouched if the script names an unknown engine. */
+  inline bool run_gia_script(abc::Gia_Man_t*& gia, std::string const& script){
+    std::vector<std::string> passes;
+    std::size_t start = 0;
+    while(start <= script.size()){
+      auto end = script.find(';', start);
+      if(end == std::string::npos){
+        end = script.size();
+      }
+      auto pass = script.substr(start, end - start);
+      pass.erase(0, pass.find_first_not_of(" &"));
+      pass.erase(pass.find_last_not_of(' ') + 1);
+      if(!pass.empty()){
+        if(pass != "dc2" && pass != "syn2" && pass != "syn3" && pass != "syn4"){
+          std::cerr << "[e] unknown ABC engine " << pass << " (dc2, syn2, syn3 and syn4 are supported)\n";
+          return false;
+        }
+        passes.push_back(pass);
+      }
+      start = end + 1;
+    }
+
+    //dc2 rewrites with ABC's 4-input subgraph library, which is only loaded once
+    abc::Dar_LibStart();
+    for(auto const& pass : passes){
+      abc::Gia_Man_t* result = nullptr;
+      if(pass == "dc2"){
+        result = abc::Gia_ManCompress2(gia, 1, 0);
+      }
+      else if(pass == "syn2"){
+        result = abc::Gia_ManAigSyn2(gia, 0, 1, 0, 20, 0, 0, 0);
+      }
+      else if(pass == "syn3"){
+        result = abc::Gia_ManAigSyn3(gia, 0, 0);
+      }
+      else{
+        result = abc::Gia_ManAigSyn4(gia, 0, 0);
+      }
+      //the engines only rewrite the combinational logic, so register reset values carry over
+      if(gia->vRegInits && !result->vRegInits && abc::Gia_ManRegNum(result) == abc::Gia_ManRegNum(gia)){
+        result->vRegInits = gia->vRegInits;
+        gia->vRegInits = nullptr;
+      }
+      abc::Gia_ManStop(gia);
+      gia = result;
+    }
+    return true;
+  }
+
+} // namespace alice
@@ -13,18 +13,28 @@
 #include <iostream>
 #include <string>
 #include <algorithm>
+#include <optional>
 #include <queue>
 #include <unordered_map>
 #include <vector>
 #include <time.h>
+#include <cerrno>
+#include <cstring>
 #include <fmt/format.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <aig/gia/gia.h>
 #include <aig/gia/giaAig.h>
 #include <base/wlc/wlc.h>
+#include "gia_bridge.hpp"
 #include <sys/stat.h>
 #include <sys/types.h>
+#include <sys/wait.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <filesystem>
+#include <fstream>
+#include <thread>
 #include <iomanip>
 #include <ot/timer/timer.hpp>
 
@@ -321,6 +331,28 @@ namespace alice{
     os << "partition number: " << part_man.get_part_num() << std::endl;
   }//end partition manager<aig_network> print store statistics
 
+  ALICE_ADD_STORE( oracle::partition_manager<mockturtle::xag_network>, "part_man_xag", "pm_x", "part_man_xag", "PART_MAN_XAGs")
+
+  /* Implements the short string to describe a store element in store -a */
+  ALICE_DESCRIBE_STORE( oracle::partition_manager<mockturtle::xag_network>, part_man ){
+
+    const auto name = "partition manager for XAG networks";
+    const auto part_num = part_man.get_part_num();
+
+    return fmt::format( "{} # partitions = {}", name, part_num );
+  }//end partition manager<xag_network> describe store
+
+  ALICE_LOG_STORE_STATISTICS( oracle::partition_manager<mockturtle::xag_network>, part_man){
+
+    return {
+            {"partition number", part_man.get_part_num()}};
+  }//end partition manager<xag_network> log store statistics
+
+  /* Implements the functionality of ps -b */
+  ALICE_PRINT_STORE_STATISTICS( oracle::partition_manager<mockturtle::xag_network>, os, part_man ){
+    os << "partition number: " << part_man.get_part_num() << std::endl;
+  }//end partition manager<xag_network> print store statistics
+
 
 
 
@@ -452,6 +484,57 @@ namespace alice{
     gia = aig_new;
   }
 
+  /* Implements convert --aig_to_gia without going through an AIGER file */
+  ALICE_CONVERT( mockturtle::aig_network, element, abc::Gia_Man_t* ) {
+    return ntk_to_gia( element, element._storage->net_name );
+  }
+
+  /* Implements convert --gia_to_aig */
+  ALICE_CONVERT( abc::Gia_Man_t*, element, mockturtle::aig_network ) {
+    return gia_to_aig( element );
+  }
+
+  class giaopt_command : public alice::command{
+
+    public:
+      explicit giaopt_command( const environment::ptr& env )
+          : command( env, "Optimizes the stored AIG in memory with ABC's GIA engines" ){
+
+        opts.add_option( "--script,-s", script, "ABC engines separated by ';', any of dc2, syn2, syn3 and syn4 [DEFAULT = dc2]" );
+      }
+
+    protected:
+      void execute(){
+        if(store<mockturtle::aig_network>().empty()){
+          std::cout << "There is not an AIG network stored.\n";
+          return;
+        }
+        auto& aig = store<mockturtle::aig_network>().current();
+        auto start = std::chrono::high_resolution_clock::now();
+        std::cout << "Initial ntk size = " << aig.num_gates() << "\n";
+
+        auto gia = ntk_to_gia(aig, aig._storage->net_name);
+        if(run_gia_script(gia, script)){
+          auto opt = gia_to_aig(gia);
+          opt._storage->inputNames = aig._storage->inputNames;
+          opt._storage->outputNames = aig._storage->outputNames;
+          aig = opt;
+        }
+        abc::Gia_ManStop(gia);
+
+        mockturtle::depth_view aig_depth{aig};
+        std::cout << "Final ntk size = " << aig.num_gates() << " and depth = " << aig_depth.depth() << "\n";
+        auto stop = std::chrono::high_resolution_clock::now();
+        auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(stop - start);
+        std::cout << "Full Optimization: " << duration.count() << "ms\n";
+      }
+
+    private:
+      std::string script{"dc2"};
+    };
+
+  ALICE_ADD_COMMAND(giaopt, "Optimization");
+
   /*Reads an blif file and stores the CBA network in a store*/
   ALICE_COMMAND( get_blif, "Input", "Uses the lorina library to read in a blif file" ){
 
@@ -973,6 +1056,76 @@ namespace alice{
     // });
   }
 
+  class find_arith_command : public alice::command{
+
+    public:
+      explicit find_arith_command( const environment::ptr& env )
+          : command( env, "Finds XOR, majority and adder structures with 3-input cuts in one pass" ){
+
+        add_flag("--mig,-m", "Look at stored MIG (AIG is default)");
+        add_flag("--xag,-x", "Look at stored XAG (AIG is default)");
+        add_flag("--verbose,-v", "List the XOR trees and adders");
+      }
+
+    protected:
+      void execute(){
+        if(is_set("mig")){
+          if(!store<mockturtle::mig_network>().empty()){
+            detect(store<mockturtle::mig_network>().current());
+          }
+          else{
+            std::cout << "No MIG stored\n";
+          }
+        }
+        else if(is_set("xag")){
+          if(!store<mockturtle::xag_network>().empty()){
+            detect(store<mockturtle::xag_network>().current());
+          }
+          else{
+            std::cout << "No XAG stored\n";
+          }
+        }
+        else{
+          if(!store<mockturtle::aig_network>().empty()){
+            detect(store<mockturtle::aig_network>().current());
+          }
+          else{
+            std::cout << "No AIG stored\n";
+          }
+        }
+      }
+
+    private:
+      template<class Ntk>
+      void detect(Ntk const& ntk){
+        mockturtle::xor_maj_detection_stats st;
+        const auto result = mockturtle::detect_xor_maj(ntk, {}, &st);
+
+        uint32_t largest = 0u;
+        for(auto const& tree : result.xor_trees){
+          largest = std::max(largest, static_cast<uint32_t>(tree.leaves.size()));
+          if(is_set("verbose")){
+            std::cout << "XOR tree at " << tree.root << " over " << tree.leaves.size() << " inputs (" << tree.num_xors << " XORs)\n";
+          }
+        }
+        if(is_set("verbose")){
+          for(auto const& fa : result.full_adders){
+            std::cout << "Full adder sum = " << fa.sum << " carry = " << fa.carry << "\n";
+          }
+          for(auto const& ha : result.half_adders){
+            std::cout << "Half adder sum = " << ha.sum << " carry = " << ha.carry << "\n";
+          }
+        }
+
+        std::cout << "XOR2 = " << result.xor2.size() << " XOR3 = " << result.xor3.size() << " MAJ3 = " << result.maj3.size() << "\n";
+        std::cout << "XOR trees = " << result.xor_trees.size() << " (largest has " << largest << " inputs)\n";
+        std::cout << "Full adders = " << result.full_adders.size() << " half adders = " << result.half_adders.size() << "\n";
+        std::cout << "Detection: " << std::chrono::duration_cast<std::chrono::milliseconds>(st.time_total).count() << "ms\n";
+      }
+    };
+
+  ALICE_ADD_COMMAND(find_arith, "Test");
+
   ALICE_COMMAND( test_aig_conv, "Test", "Test aig to mig and then mig to aig"){
     mockturtle::direct_resynthesis<mockturtle::aig_network> resyn_aig;
 
@@ -1259,19 +1412,117 @@ namespace alice{
                 add_flag("--high,-b", "Uses a high effort approach instead of classification");
                 add_flag("--aig,-a", "Perform only AIG optimization on all partitions");
                 add_flag("--mig,-m", "Perform only MIG optimization on all partitions");
+                add_flag("--xag,-x", "Perform only XAG optimization on all partitions (optimizes the stored XAG when it was partitioned with partitioning --xag)");
                 add_flag("--combine,-c", "Combine adjacent partitions that have been classified for the same optimization");
+                opts.add_option( "--workers,-w", num_workers, "Optimize the partitions in this many worker processes, started from /proc/self/exe on this machine (Linux only) [DEFAULT = 1]" );
+                opts.add_option( "--spill_dir,-s", spill_dir, "Write the partitions to this directory, release the network and keep only the partition being optimized in memory (out-of-core mode)" );
+                opts.add_option( "--worker", worker_job, "Optimize the one partition described by this job file, used by the processes started with --workers" );
+                opts.add_option( "--abc", abc_script, "Optimize AIG partitions in memory with these ABC engines instead, e.g. \"dc2;syn3\"" );
+                add_flag("--seams", "Rewrite windows across partition boundaries after the partitions are merged");
+                opts.add_option( "--time_budget", time_budget, "Seconds shared by all partition optimizations, larger partitions get larger shares [DEFAULT = no budget]" );
+                opts.add_option( "--seam_depth", seam_depth, "Levels of a seam window, half of them behind the boundary [DEFAULT = 6]" );
+                opts.add_option( "--cost", cost, "Cost that selects the script of a partition with --high: adp (size * depth) or power (switching activity) [DEFAULT = adp]" );
+#if defined(LSORACLE_USE_PERCY)
+                add_flag("--exact,-e", "Follow the partition scripts with exact resynthesis of small cut functions");
+                opts.add_option( "--exact_db", exact_db, "Exact synthesis database to load and update" );
+                opts.add_option( "--exact_inputs", exact_inputs, "Largest cut function resynthesized exactly [DEFAULT = 4]" );
+                opts.add_option( "--exact_threads", exact_threads, "Background exact synthesis workers [DEFAULT = 1]" );
+#endif
         }
 
     protected:
       void execute(){
 
+        //alice keeps option values between runs, the cost applies to the run it is given for
+        if(!is_set("cost")){
+          cost = "adp";
+        }
+        if(cost != "adp" && cost != "power"){
+          std::cout << "Unknown cost " << cost << ", use adp or power\n";
+          return;
+        }
+        if(!worker_job.empty()){
+          run_worker(std::exchange(worker_job, std::string{}));
+          return;
+        }
         mockturtle::direct_resynthesis<mockturtle::mig_network> resyn_mig;
         mockturtle::direct_resynthesis<mockturtle::aig_network> resyn_aig;
         std::vector<int> aig_parts;
         std::vector<int> mig_parts;
+        std::vector<int> xag_parts;
         std::vector<int> comb_aig_parts;
         std::vector<int> comb_mig_parts;
-        if(!store<mockturtle::aig_network>().empty()){
+#if defined(LSORACLE_USE_PERCY)
+        if(is_set("exact")){
+          mockturtle::exact_resynthesis_params exact_ps;
+          exact_ps.database = exact_db;
+          exact_ps.max_inputs = std::min(exact_inputs, 6u);
+          exact_ps.num_threads = exact_threads;
+          exact = std::make_unique<mockturtle::exact_database>(exact_ps);
+        }
+#endif
+        if(is_set("xag") && !store<mockturtle::xag_network>().empty() && !store<oracle::partition_manager<mockturtle::xag_network>>().empty()){
+
+          auto start = std::chrono::high_resolution_clock::now();
+
+          //work on a copy so that the stored XAG is left untouched by the partition synchronization
+          mockturtle::xag_network ntk_xag(std::make_shared<mockturtle::xag_storage>(*store<mockturtle::xag_network>().current()._storage));
+          auto partitions_xag = store<oracle::partition_manager<mockturtle::xag_network>>().current();
+          int num_parts = partitions_xag.get_part_num();
+
+          std::cout << "Scheduled optimization\n";
+          std::cout << num_parts << " XAGs\n";
+
+          std::vector<uint32_t> sizes;
+          for(int i = 0; i < num_parts; i++){
+            sizes.push_back(partitions_xag.get_part_context(i).size());
+          }
+          oracle::partition_budget budget(is_set("time_budget") ? time_budget : 0.0, sizes);
+
+          for(int i = 0; i < num_parts; i++){
+
+            oracle::partition_view<mockturtle::xag_network> part = partitions_xag.create_part(ntk_xag, i);
+
+            auto opt = part_to_xag(part);
+
+            mockturtle::xag_script xagopt;
+            xagopt.time_limit = budget.start(i);
+            opt = xagopt.run(opt);
+#if defined(LSORACLE_USE_PERCY)
+            if(exact){
+              run_exact(opt, *exact);
+            }
+#endif
+
+            partitions_xag.synchronize_part(part, opt, ntk_xag);
+          }
+
+          partitions_xag.connect_outputs(ntk_xag);
+          if(is_set("seams")){
+            optimize_seams<mockturtle::xag_npn_resynthesis<mockturtle::xag_network>>(ntk_xag, partitions_xag);
+          }
+
+          ntk_xag = mockturtle::cleanup_dangling( ntk_xag );
+          mockturtle::depth_view ntk_depth{ntk_xag};
+          std::cout << "Final ntk size = " << ntk_xag.num_gates() << " and depth = " << ntk_depth.depth() << "\n";
+          std::cout << "Area Delay Product = " << ntk_xag.num_gates() * ntk_depth.depth() << "\n";
+          auto stop = std::chrono::high_resolution_clock::now();
+          auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(stop - start);
+          std::cout << "Full Optimization: " << duration.count() << "ms\n";
+          std::cout << "Finished optimization\n";
+#if defined(LSORACLE_USE_PERCY)
+          if(exact){
+            exact->stats().report();
+          }
+#endif
+          store<mockturtle::xag_network>().extend() = ntk_xag;
+
+          if(out_file != ""){
+            mockturtle::write_verilog(ntk_xag, out_file);
+            std::cout << "Resulting Verilog written to " << out_file << "\n";
+          }
+        }
+        else if(!store<mockturtle::aig_network>().empty()){
 
           auto ntk_aig = store<mockturtle::aig_network>().current();
           std::string file_base = ntk_aig._storage->net_name;
@@ -1294,28 +1545,36 @@ namespace alice{
                 mig_parts.push_back(i);
               }
             }
+            else if(is_set("xag")){
+              for(int i = 0; i < num_parts; i++){
+                xag_parts.push_back(i);
+              }
+            }
             else if(is_set("high")){
 
               for(int i = 0; i < num_parts; i++){
                 oracle::partition_view<mockturtle::aig_network> part_aig = partitions_aig.create_part(ntk_aig, i);
 
                 auto opt_aig = mockturtle::node_resynthesis<mockturtle::aig_network>( part_aig, resyn_aig );
-                mockturtle::depth_view part_aig_depth{opt_aig};
                 mockturtle::aig_script aigopt;
                 opt_aig = aigopt.run(opt_aig);
-                mockturtle::depth_view part_aig_opt_depth{opt_aig};
-                int aig_opt_size = opt_aig.num_gates();
-                int aig_opt_depth = part_aig_opt_depth.depth();
+                double aig_opt_cost = script_cost(opt_aig);
 
                 auto opt_mig = mockturtle::node_resynthesis<mockturtle::mig_network>( part_aig, resyn_mig );
-                mockturtle::depth_view part_mig_depth{opt_mig};
                 mockturtle::mig_script migopt;
                 opt_mig = migopt.run(opt_mig);
-                mockturtle::depth_view part_mig_opt_depth{opt_mig};
-                int mig_opt_size = opt_mig.num_gates();
-                int mig_opt_depth = part_mig_opt_depth.depth();
+                double mig_opt_cost = script_cost(opt_mig);
 
-                if((aig_opt_size * aig_opt_depth) <= (mig_opt_size * mig_opt_depth)){
+                auto opt_xag = aig_to_xag(mockturtle::node_resynthesis<mockturtle::aig_network>( part_aig, resyn_aig ));
+                mockturtle::xag_script xagopt;
+                opt_xag = xagopt.run(opt_xag);
+                //the partition ends up in the MIG as three majority gates per XOR, so it is compared in that form
+                double xag_opt_cost = script_cost(xag_to_mig(opt_xag));
+
+                if(xag_opt_cost < aig_opt_cost && xag_opt_cost < mig_opt_cost){
+                  xag_parts.push_back(i);
+                }
+                else if(aig_opt_cost <= mig_opt_cost){
                   aig_parts.push_back(i);
                 }
                 else{
@@ -1330,6 +1589,28 @@ namespace alice{
 
                 aig_parts = partitions_aig.get_aig_parts();
                 mig_parts = partitions_aig.get_mig_parts();
+
+                //XOR dominated partitions skip the CNN, they stay XAG only when that beats the MIG script after conversion
+                for(auto i : partitions_aig.get_xag_parts()){
+                  oracle::partition_view<mockturtle::aig_network> part_aig = partitions_aig.create_part(ntk_aig, i);
+
+                  auto opt_mig = mockturtle::node_resynthesis<mockturtle::mig_network>( part_aig, resyn_mig );
+                  mockturtle::mig_script migopt;
+                  opt_mig = migopt.run(opt_mig);
+                  double mig_opt_cost = script_cost(opt_mig);
+
+                  auto opt_xag = aig_to_xag(mockturtle::node_resynthesis<mockturtle::aig_network>( part_aig, resyn_aig ));
+                  mockturtle::xag_script xagopt;
+                  opt_xag = xagopt.run(opt_xag);
+                  double xag_opt_cost = script_cost(xag_to_mig(opt_xag));
+
+                  if(xag_opt_cost < mig_opt_cost){
+                    xag_parts.push_back(i);
+                  }
+                  else{
+                    mig_parts.push_back(i);
+                  }
+                }
               }
               else{
                 std::cout << "Must include CNN model json file\n";
@@ -1338,12 +1619,15 @@ namespace alice{
             }
 
             std::cout << "Scheduled optimization\n";
-            std::cout << aig_parts.size() << " AIGs and " << mig_parts.size() << " MIGs\n";
+            std::cout << aig_parts.size() << " AIGs, " << mig_parts.size() << " MIGs and " << xag_parts.size() << " XAGs\n";
 
             if(is_set("combine")){
               std::vector<int> visited;
               std::unordered_map<int, int> comb_part;
               for(int i = 0; i < num_parts; i++){
+                //XAG partitions are optimized on their own
+                if(std::find(xag_parts.begin(), xag_parts.end(), i) != xag_parts.end())
+                  continue;
                 if(std::find(visited.begin(), visited.end(), i) == visited.end()){
                   std::vector<int> parts_to_combine;
                   
@@ -1453,51 +1737,61 @@ namespace alice{
               aig_parts = comb_aig_parts;
               mig_parts = comb_mig_parts;
               std::cout << "Scheduled optimization after partition merging\n";
-              std::cout << aig_parts.size() << " AIGs and " << mig_parts.size() << " MIGs\n";
+              std::cout << aig_parts.size() << " AIGs, " << mig_parts.size() << " MIGs and " << xag_parts.size() << " XAGs\n";
             }
             
             mockturtle::mig_network ntk_mig = aig_to_mig(ntk_aig, 1);
             oracle::partition_manager<mockturtle::mig_network> partitions_mig(ntk_mig, partitions_aig.get_all_part_connections(), 
                     partitions_aig.get_all_partition_inputs(), partitions_aig.get_all_partition_outputs(), partitions_aig.get_part_num());
 
-            // std::cout << "AIG Optimization\n";
-            for(int i = 0; i < aig_parts.size(); i++){
-              
-              oracle::partition_view<mockturtle::mig_network> part = partitions_mig.create_part(ntk_mig, aig_parts.at(i));
-              mockturtle::depth_view part_depth{part};
-
-              auto opt_part = part_to_mig(part, 1);
-              auto opt = mig_to_aig(opt_part);
-
-              mockturtle::depth_view opt_part_depth{opt};
-
-              mockturtle::aig_script aigopt;
-              opt = aigopt.run(opt);
-
-              auto opt_mig = aig_to_mig(opt, 0);
-              mockturtle::depth_view part_opt_depth{opt_mig};
-
-              partitions_mig.synchronize_part(part, opt_mig, ntk_mig);
+            //jobs are numbered in the order AIG, MIG, XAG partitions
+            std::vector<uint32_t> sizes;
+            for(auto const& parts : {aig_parts, mig_parts, xag_parts}){
+              for(auto i : parts){
+                sizes.push_back(partitions_mig.get_part_context(i).size());
+              }
             }
-            // std::cout << "MIG Optimization\n";
-            for(int i = 0; i < mig_parts.size(); i++){
-              
-              oracle::partition_view<mockturtle::mig_network> part = partitions_mig.create_part(ntk_mig, mig_parts.at(i));
-              mockturtle::depth_view part_depth{part};
+            oracle::partition_budget budget(is_set("time_budget") ? time_budget : 0.0, sizes, {}, std::max(1u, num_workers));
 
-              auto opt = part_to_mig(part, 0);
-
-              mockturtle::depth_view opt_part_depth{opt};
-              
-              mockturtle::mig_script migopt;
-              opt = migopt.run(opt);
-              
-              mockturtle::depth_view part_opt_depth{opt};
-
-              partitions_mig.synchronize_part(part, opt, ntk_mig);
+            if(!spill_dir.empty()){
+              try{
+                ntk_mig = optimize_out_of_core(ntk_mig, partitions_mig, aig_parts, mig_parts, xag_parts, budget);
+              }
+              catch(std::exception const& e){
+                std::cout << "Out-of-core optimization failed: " << e.what() << "\n";
+                spill_dir.clear();
+                return;
+              }
+            }
+            else if(num_workers <= 1){
+              std::size_t job = 0;
+              // std::cout << "AIG Optimization\n";
+              for(int i = 0; i < aig_parts.size(); i++){
+                oracle::partition_view<mockturtle::mig_network> part = partitions_mig.create_part(ntk_mig, aig_parts.at(i));
+                partitions_mig.synchronize_part(part, optimize_aig_part(part_to_mig(part, 1), budget.start(job++)), ntk_mig);
+              }
+              // std::cout << "MIG Optimization\n";
+              for(int i = 0; i < mig_parts.size(); i++){
+                oracle::partition_view<mockturtle::mig_network> part = partitions_mig.create_part(ntk_mig, mig_parts.at(i));
+                partitions_mig.synchronize_part(part, optimize_mig_part(part_to_mig(part, 0), budget.start(job++)), ntk_mig);
+              }
+              // std::cout << "XAG Optimization\n";
+              for(int i = 0; i < xag_parts.size(); i++){
+                oracle::partition_view<mockturtle::mig_network> part = partitions_mig.create_part(ntk_mig, xag_parts.at(i));
+                partitions_mig.synchronize_part(part, optimize_xag_part(part_to_mig(part, 1), budget.start(job++)), ntk_mig);
+              }
+            }
+            else{
+              optimize_in_processes(ntk_mig, partitions_mig, aig_parts, mig_parts, xag_parts, budget);
             }
             
-            partitions_mig.connect_outputs(ntk_mig);
+            //the stitched network of the out-of-core mode has no partition manager behind it
+            if(spill_dir.empty()){
+              partitions_mig.connect_outputs(ntk_mig);
+              if(is_set("seams")){
+                optimize_seams<mockturtle::mig_npn_resynthesis>(ntk_mig, partitions_mig);
+              }
+            }
             
             mockturtle::depth_view ntk_before_depth2{ntk_mig};
             
@@ -1505,10 +1799,21 @@ namespace alice{
             mockturtle::depth_view ntk_depth2{ntk_mig};
             std::cout << "Final ntk size = " << ntk_mig.num_gates() << " and depth = " << ntk_depth2.depth() << "\n";
             std::cout << "Area Delay Product = " << ntk_mig.num_gates() * ntk_depth2.depth() << "\n";
+            if(cost == "power"){
+              std::cout << "Switching activity = " << mockturtle::switching_activity(ntk_mig).activity << "\n";
+            }
+            if(ntk_mig.num_latches() > 0){
+              std::cout << "Registers = " << ntk_mig.num_latches() << "\n";
+            }
             auto stop = std::chrono::high_resolution_clock::now();
             auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(stop - start);
             std::cout << "Full Optimization: " << duration.count() << "ms\n";
             std::cout << "Finished optimization\n";
+#if defined(LSORACLE_USE_PERCY)
+            if(exact){
+              exact->stats().report();
+            }
+#endif
             store<mockturtle::mig_network>().extend() = ntk_mig;
 
             if(out_file != ""){
@@ -1524,10 +1829,319 @@ namespace alice{
         else{
           std::cout << "No AIG stored\n";
         }
+        spill_dir.clear();
+#if defined(LSORACLE_USE_PERCY)
+        exact.reset();
+#endif
       }
     private:
+        /* Cost of an optimized partition for the brute-force script selection. The power cost is the
+           switched capacitance under random partition inputs, see the power command. */
+        template<class Ntk>
+        double script_cost(Ntk const& ntk) const{
+          if(cost == "power"){
+            return mockturtle::switching_activity(ntk).activity;
+          }
+          mockturtle::depth_view ntk_depth{ntk};
+          return double(ntk.num_gates()) * ntk_depth.depth();
+        }
+
+        mockturtle::mig_network optimize_aig_part(mockturtle::mig_network const& part, mockturtle::deadline const& until = {}){
+          auto opt = mig_to_aig(part);
+
+          if(abc_script.empty()){
+            mockturtle::aig_script aigopt;
+            aigopt.time_limit = until;
+            opt = aigopt.run(opt);
+          }
+          else{
+            auto gia = ntk_to_gia(opt);
+            if(run_gia_script(gia, abc_script)){
+              opt = gia_to_aig(gia);
+            }
+            abc::Gia_ManStop(gia);
+          }
+#if defined(LSORACLE_USE_PERCY)
+          if(exact){
+            run_exact(opt, *exact);
+          }
+#endif
+
+          return aig_to_mig(opt, 0);
+        }
+
+        mockturtle::mig_network optimize_mig_part(mockturtle::mig_network opt, mockturtle::deadline const& until = {}){
+          mockturtle::mig_script migopt;
+          migopt.time_limit = until;
+          opt = migopt.run(opt);
+#if defined(LSORACLE_USE_PERCY)
+          if(exact){
+            run_exact(opt, *exact);
+          }
+#endif
+
+          return opt;
+        }
+
+        /* The mixed flow stitches every partition into one MIG, so the optimized XAG is converted back
+           and each XOR becomes three majority gates. Keeping XOR logic compact needs the XAG flow,
+           partitioning --xag followed by optimization --xag. */
+        mockturtle::mig_network optimize_xag_part(mockturtle::mig_network const& part, mockturtle::deadline const& until = {}){
+          auto opt = aig_to_xag(mig_to_aig(part));
+
+          mockturtle::xag_script xagopt;
+          xagopt.time_limit = until;
+          opt = xagopt.run(opt);
+#if defined(LSORACLE_USE_PERCY)
+          if(exact){
+            run_exact(opt, *exact);
+          }
+#endif
+
+          return xag_to_mig(opt);
+        }
+
+        /* Rewrites windows straddling the partition boundaries, which no partition script has seen whole. */
+        template<class Resyn, class Ntk>
+        void optimize_seams(Ntk& ntk, oracle::partition_manager<Ntk>& partitions){
+          oracle::seam_rewriting_params ps;
+          ps.depth = seam_depth;
+
+          auto st = oracle::seam_rewriting(ntk, partitions, [](){
+            return [resyn = std::make_shared<Resyn>()](Ntk& win){
+              mockturtle::cut_rewriting_params crps;
+              crps.cut_enumeration_ps.cut_size = 4;
+              for(auto round = 0; round < 2; round++){
+                mockturtle::cut_rewriting(win, *resyn, crps);
+                win = mockturtle::cleanup_dangling(win);
+              }
+            };
+          }, ps);
+          std::cout << "Seam windows = " << st.windows << " replaced = " << st.committed << " gates saved = " << st.gain << "\n";
+        }
+
+        mockturtle::mig_network optimize_part(mockturtle::mig_network const& part, char kind, mockturtle::deadline const& until = {}){
+          switch(kind){
+          case 'a':
+            return optimize_aig_part(part, until);
+          case 'x':
+            return optimize_xag_part(part, until);
+          default:
+            return optimize_mig_part(part, until);
+          }
+        }
+
+        /* Every scheduled partition is written to a temporary directory, optimized there by the worker
+           processes and stitched back into the network from disk. */
+        void optimize_in_processes(mockturtle::mig_network& ntk_mig, oracle::partition_manager<mockturtle::mig_network>& partitions_mig,
+                                   std::vector<int> const& aig_parts, std::vector<int> const& mig_parts, std::vector<int> const& xag_parts,
+                                   oracle::partition_budget& budget){
+          const std::string dir = (std::filesystem::temp_directory_path() / ("lsoracle_" + std::to_string(getpid()))).string();
+          oracle::partition_store<mockturtle::mig_network> exchange(dir);
+
+          std::vector<std::pair<int, char>> jobs;
+          for(auto i : aig_parts){
+            jobs.emplace_back(i, 'a');
+          }
+          for(auto i : mig_parts){
+            jobs.emplace_back(i, 'm');
+          }
+          for(auto i : xag_parts){
+            jobs.emplace_back(i, 'x');
+          }
+
+          for(auto const& [i, kind] : jobs){
+            exchange.write(i, part_to_mig(partitions_mig.create_part(ntk_mig, i), kind == 'm' ? 0 : 1));
+          }
+
+          optimize_in_workers(exchange, dir, jobs, budget);
+
+          for(auto const& [i, kind] : jobs){
+            oracle::partition_view<mockturtle::mig_network> part = partitions_mig.create_part(ntk_mig, i);
+            partitions_mig.synchronize_part(part, exchange.read(i), ntk_mig);
+            exchange.remove(i);
+          }
+          //also drops the job files and the partial files of workers that died while writing
+          std::error_code ec;
+          std::filesystem::remove_all(dir, ec);
+        }
+
+        /* Out-of-core mode: every scheduled partition is written to the spill directory together with its
+           boundary, then the network and the partition manager are released. Partitions are loaded,
+           optimized and written back one at a time (or in the worker processes) and the result is
+           stitched from the files, so apart from the stored input design only one partition and the
+           signals of the partition outputs are resident. */
+        mockturtle::mig_network optimize_out_of_core(mockturtle::mig_network& ntk_mig, oracle::partition_manager<mockturtle::mig_network>& partitions_mig,
+                                                     std::vector<int> const& aig_parts, std::vector<int> const& mig_parts, std::vector<int> const& xag_parts,
+                                                     oracle::partition_budget& budget){
+          oracle::partition_store<mockturtle::mig_network> spill(spill_dir);
+
+          std::vector<std::pair<int, char>> jobs;
+          std::vector<uint32_t> parts;
+          for(auto const& [list, kind] : {std::make_pair(&aig_parts, 'a'), std::make_pair(&mig_parts, 'm'), std::make_pair(&xag_parts, 'x')}){
+            for(auto i : *list){
+              jobs.emplace_back(i, kind);
+              parts.push_back(i);
+            }
+          }
+
+          spill.write_interface(ntk_mig);
+          for(auto const& [i, kind] : jobs){
+            oracle::partition_view<mockturtle::mig_network> part = partitions_mig.create_part(ntk_mig, i);
+            spill.write(i, part_to_mig(part, kind == 'm' ? 0 : 1));
+            spill.write_boundary(i, oracle::partition_store<mockturtle::mig_network>::boundary_of(ntk_mig, part));
+          }
+          ntk_mig = mockturtle::mig_network{};
+          partitions_mig = oracle::partition_manager<mockturtle::mig_network>{};
+
+          if(num_workers > 1){
+            optimize_in_workers(spill, spill_dir, jobs, budget);
+          }
+          else{
+            for(std::size_t job = 0; job < jobs.size(); job++){
+              auto const [i, kind] = jobs.at(job);
+              spill.write(i, optimize_part(spill.read(i), kind, budget.start(job)));
+            }
+          }
+
+          auto result = spill.stitch(parts);
+          for(auto i : parts){
+            spill.remove(i);
+          }
+          spill.remove_interface();
+          std::cout << "Spilled " << spill.bytes_written() << " bytes to " << spill_dir << "\n";
+          return result;
+        }
+
+        /* Local coordinator: every job runs in a new lsoracle process on this machine, started from
+           /proc/self/exe as optimization --worker "<job file>", that reads its partition from the exchange directory and atomically replaces it
+           with the optimized network. The fork is followed directly by exec, so no thread or state of
+           this process is used by a worker. A worker that crashes or fails leaves the extracted
+           partition in place, which is then stitched back as is. Workers do not run exact synthesis. */
+        void optimize_in_workers(oracle::partition_store<mockturtle::mig_network>& exchange, std::string const& dir,
+                                 std::vector<std::pair<int, char>> const& jobs, oracle::partition_budget& budget){
+          std::unordered_map<pid_t, int> running;
+          std::size_t next = 0;
+          int failed = 0;
+
+          while(next < jobs.size() || !running.empty()){
+            while(next < jobs.size() && running.size() < num_workers){
+              const auto until = budget.start(next);
+              auto const [i, kind] = jobs.at(next++);
+
+              const auto job_file = dir + "/job_" + std::to_string(i) + ".json";
+              nlohmann::json job = {{"dir", dir}, {"part", i}, {"kind", std::string(1, kind)}, {"abc", abc_script}};
+              job["seconds"] = until.is_set() ? until.remaining() : -1.0;
+              std::ofstream(job_file) << job << "\n";
+
+              //alice splits the -c line at spaces and semicolons outside of quotes and unescapes \" inside them
+              std::string quoted = "\"";
+              for(auto c : job_file){
+                quoted += c == '"' ? std::string("\\\"") : std::string(1, c);
+              }
+              quoted += "\"";
+              std::vector<std::string> args{"lsoracle", "-c", "optimization --worker " + quoted};
+              std::vector<char*> argv;
+              for(auto& arg : args){
+                argv.push_back(arg.data());
+              }
+              argv.push_back(nullptr);
+
+              std::cout.flush();
+              const pid_t pid = fork();
+              if(pid == 0){
+                execv("/proc/self/exe", argv.data());
+                _exit(127);
+              }
+              else if(pid < 0){
+                std::cerr << "Could not start a worker, optimizing partition " << i << " in place\n";
+                exchange.write(i, optimize_part(exchange.read(i), kind, until));
+              }
+              else{
+                running[pid] = i;
+              }
+            }
+
+            if(running.empty()){
+              continue;
+            }
+            int status = 0;
+            const pid_t pid = wait(&status);
+            if(pid < 0){
+              break;
+            }
+            auto it = running.find(pid);
+            if(it == running.end()){
+              continue;
+            }
+            std::remove((dir + "/job_" + std::to_string(it->second) + ".json").c_str());
+            if(!WIFEXITED(status) || WEXITSTATUS(status) != 0){
+              std::cerr << "Worker for partition " << it->second << " failed, keeping it unoptimized\n";
+              ++failed;
+            }
+            running.erase(it);
+          }
+
+          std::cout << jobs.size() << " partitions optimized in " << num_workers << " worker processes";
+          if(failed > 0){
+            std::cout << " (" << failed << " failed)";
+          }
+          std::cout << "\n";
+        }
+
+        /* Body of a worker process. A failed job ends the process with a non-zero status, which the
+           coordinator reports. */
+        void run_worker(std::string const& job_file){
+          try{
+            std::ifstream in(job_file);
+            if(!in){
+              throw std::runtime_error("could not read job file " + job_file);
+            }
+            nlohmann::json job;
+            in >> job;
+
+            oracle::partition_store<mockturtle::mig_network> exchange(job.at("dir").get<std::string>());
+            const auto i = job.at("part").get<uint32_t>();
+            const auto kind = job.at("kind").get<std::string>().at(0);
+            const auto seconds = job.at("seconds").get<double>();
+            abc_script = job.at("abc").get<std::string>();
+
+            exchange.write(i, optimize_part(exchange.read(i), kind, seconds >= 0.0 ? mockturtle::deadline::after(seconds) : mockturtle::deadline()));
+          }
+          catch(std::exception const& e){
+            std::cerr << "Worker " << job_file << ": " << e.what() << "\n";
+            std::cerr.flush();
+            std::exit(1);
+          }
+        }
+
+#if defined(LSORACLE_USE_PERCY)
+        template<class Ntk>
+        void run_exact(Ntk& ntk, mockturtle::exact_database& db){
+          mockturtle::exact_resynthesis<Ntk> resyn(db);
+          mockturtle::cut_rewriting_params ps;
+          ps.cut_enumeration_ps.cut_size = db.params().max_inputs;
+
+          mockturtle::cut_rewriting(ntk, resyn, ps);
+          ntk = mockturtle::cleanup_dangling(ntk);
+        }
+#endif
+
         std::string nn_model{};
         std::string out_file{};
+        std::string abc_script{};
+        std::string worker_job{};
+        std::string spill_dir{};
+        std::string cost{"adp"};
+        unsigned num_workers{1u};
+        unsigned seam_depth{6u};
+        double time_budget{0.0};
+#if defined(LSORACLE_USE_PERCY)
+        std::unique_ptr<mockturtle::exact_database> exact;
+        std::string exact_db{};
+        unsigned exact_inputs{mockturtle::exact_resynthesis_params{}.max_inputs};
+        unsigned exact_threads{1u};
+#endif
     };
 
   ALICE_ADD_COMMAND(optimization, "Optimization");
@@ -1837,29 +2451,84 @@ namespace alice{
     }
   }
 
-  ALICE_COMMAND( read_lib, "STA", "Reads standard cell library"){
-    std::string filename = "";
-    std::cout << "Enter liberty path: ";
-    std::cin >> filename;
-
-    sta_cfg.set_lib_path(filename);
+  //STA inputs are read from the command line, the prompt is only a fallback for interactive use
+  static std::string sta_path(std::string const& filename, std::string const& what){
+    if(!filename.empty()){
+      return filename;
+    }
+    std::string prompted = "";
+    std::cout << "Enter " << what << " path: ";
+    std::cin >> prompted;
+    return prompted;
   }
 
-  ALICE_COMMAND( read_netlist, "STA", "Reads mapped verilog"){
-    std::string filename = "";
-    std::cout << "Enter verilog path: ";
-    std::cin >> filename;
+  class read_lib_command : public alice::command{
 
-    sta_cfg.set_netlist_path(filename);
-  }
+    public:
+      explicit read_lib_command( const environment::ptr& env )
+          : command( env, "Reads standard cell library" ){
 
-  ALICE_COMMAND( read_sdc, "STA", "Reads constraint file"){
-    std::string filename = "";
-    std::cout << "Enter sdc path: ";
-    std::cin >> filename;
+        opts.add_option( "--filename,filename", filename, "Liberty file" );
+        opts.add_option( "--cache", cache, "Directory of binary library caches, reused while the liberty file is unchanged" );
+      }
 
-    sta_cfg.set_sdc_path(filename);
-  }
+    protected:
+      void execute(){
+        if(!cache.empty()){
+          sta_cfg.set_lib_cache(cache);
+        }
+        sta_cfg.set_lib_path(sta_path(filename, "liberty"));
+        filename = "";
+      }
+
+    private:
+      std::string filename{};
+      std::string cache{};
+    };
+
+  ALICE_ADD_COMMAND(read_lib, "STA");
+
+  class read_netlist_command : public alice::command{
+
+    public:
+      explicit read_netlist_command( const environment::ptr& env )
+          : command( env, "Reads mapped verilog" ){
+
+        opts.add_option( "--filename,filename", filename, "Mapped verilog file" );
+      }
+
+    protected:
+      void execute(){
+        sta_cfg.set_netlist_path(sta_path(filename, "verilog"));
+        filename = "";
+      }
+
+    private:
+      std::string filename{};
+    };
+
+  ALICE_ADD_COMMAND(read_netlist, "STA");
+
+  class read_sdc_command : public alice::command{
+
+    public:
+      explicit read_sdc_command( const environment::ptr& env )
+          : command( env, "Reads constraint file" ){
+
+        opts.add_option( "--filename,filename", filename, "SDC file" );
+      }
+
+    protected:
+      void execute(){
+        sta_cfg.set_sdc_path(sta_path(filename, "sdc"));
+        filename = "";
+      }
+
+    private:
+      std::string filename{};
+    };
+
+  ALICE_ADD_COMMAND(read_sdc, "STA");
 
   ALICE_COMMAND( run_slack, "STA", "Shows WNS and TNS"){
 
@@ -1911,6 +2580,199 @@ namespace alice{
 
   ALICE_ADD_COMMAND(depth, "Network_Statistics");
 
+  class power_command : public alice::command{
+
+    public:
+      explicit power_command( const environment::ptr& env )
+          : command( env, "Estimates signal probabilities and switching activity of the stored network by bit-parallel simulation" ){
+
+        opts.add_option( "--patterns,-p", num_patterns, "Number of random patterns [DEFAULT = 16384]" );
+        opts.add_option( "--seed", seed, "Seed of the random patterns [DEFAULT = 1]" );
+        opts.add_option( "--vectors,-v", vectors, "Simulate the input vectors in this file in order, one line of 0s and 1s per vector (primary inputs, then register outputs)" );
+        opts.add_option( "--threads,-t", num_threads, "Number of threads [DEFAULT = 1]" );
+        opts.add_option( "--top", top, "List the nodes with the highest toggle rates" );
+        add_flag("--mig,-m", "Estimate for the stored MIG (AIG is default)");
+        add_flag("--xag,-x", "Estimate for the stored XAG (AIG is default)");
+        add_flag("--bench,-b", "Estimate for the stored LUT network (AIG is default)");
+        add_flag("--parts", "Also estimate every partition of the stored AIG on its own, with random partition inputs");
+      }
+
+    protected:
+      void execute(){
+        //alice keeps option values between runs, without --vectors this run uses random patterns
+        if(!is_set("vectors")){
+          vectors.clear();
+        }
+        if(!is_set("top")){
+          top = 0u;
+        }
+        if(is_set("mig")){
+          if(!store<mockturtle::mig_network>().empty()){
+            report(store<mockturtle::mig_network>().current());
+          }
+          else{
+            std::cout << "There is not an MIG network stored.\n";
+          }
+        }
+        else if(is_set("xag")){
+          if(!store<mockturtle::xag_network>().empty()){
+            report(store<mockturtle::xag_network>().current());
+          }
+          else{
+            std::cout << "There is not an XAG network stored.\n";
+          }
+        }
+        else if(is_set("bench")){
+          if(!store<mockturtle::klut_network>().empty()){
+            report(store<mockturtle::klut_network>().current());
+          }
+          else{
+            std::cout << "There is not a LUT network stored.\n";
+          }
+        }
+        else{
+          if(!store<mockturtle::aig_network>().empty()){
+            auto& aig = store<mockturtle::aig_network>().current();
+            report(aig);
+
+            if(is_set("parts")){
+              if(!store<oracle::partition_manager<mockturtle::aig_network>>().empty()){
+                auto partitions = store<oracle::partition_manager<mockturtle::aig_network>>().current();
+                mockturtle::direct_resynthesis<mockturtle::aig_network> resyn_aig;
+                for(int i = 0; i < partitions.get_part_num(); i++){
+                  oracle::partition_view<mockturtle::aig_network> part = partitions.create_part(aig, i);
+                  auto part_aig = mockturtle::node_resynthesis<mockturtle::aig_network>(part, resyn_aig);
+                  mockturtle::depth_view part_depth{part_aig};
+                  auto act = mockturtle::switching_activity(part_aig, params());
+                  std::cout << "Partition " << i << ": size = " << part_aig.num_gates() << " depth = " << part_depth.depth()
+                            << " switching activity = " << act.activity << "\n";
+                }
+              }
+              else{
+                std::cout << "AIG not partitioned yet\n";
+              }
+            }
+          }
+          else{
+            std::cout << "There is not an AIG network stored.\n";
+          }
+        }
+      }
+
+    private:
+      mockturtle::switching_activity_params params() const{
+        mockturtle::switching_activity_params ps;
+        ps.num_patterns = num_patterns;
+        ps.seed = seed;
+        ps.simulation_ps.num_threads = num_threads;
+        return ps;
+      }
+
+      /* Reads one vector per line into the word layout of compiled_simulation, a vector has one
+         value for every primary input followed by one for every register output. */
+      bool read_vectors(uint32_t num_pis, std::vector<uint64_t>& words, uint64_t& num_vectors) const{
+        std::ifstream in(vectors);
+        if(!in){
+          std::cout << "Could not open " << vectors << "\n";
+          return false;
+        }
+        std::vector<std::string> lines;
+        std::string line;
+        while(std::getline(in, line)){
+          line.erase(std::remove_if(line.begin(), line.end(), ::isspace), line.end());
+          if(line.empty()){
+            continue;
+          }
+          if(line.size() != num_pis || line.find_first_not_of("01") != std::string::npos){
+            std::cout << "Vector " << lines.size() + 1 << " must have one 0 or 1 for each of the " << num_pis << " inputs\n";
+            return false;
+          }
+          lines.push_back(line);
+        }
+        if(lines.empty()){
+          std::cout << "No vectors in " << vectors << "\n";
+          return false;
+        }
+        //the bits after the last vector are padding that switching_activity ignores
+        num_vectors = lines.size();
+        const uint64_t num_words = (num_vectors + 63) / 64;
+        words.assign(num_pis * num_words, 0u);
+        for(uint64_t p = 0; p < num_vectors; p++){
+          auto const& v = lines.at(p);
+          for(uint32_t i = 0; i < num_pis; i++){
+            if(v[i] == '1'){
+              words[i * num_words + p / 64] |= uint64_t(1) << (p % 64);
+            }
+          }
+        }
+        return true;
+      }
+
+      template<class Ntk>
+      void report(Ntk const& ntk){
+        auto start = std::chrono::high_resolution_clock::now();
+
+        auto ps = params();
+        mockturtle::switching_activity_result act;
+        uint64_t patterns = 0;
+        if(!vectors.empty()){
+          std::vector<uint64_t> words;
+          uint64_t num_vectors = 0;
+          if(!read_vectors(mockturtle::compiled_simulation(ntk).num_pis(), words, num_vectors)){
+            return;
+          }
+          //a single block, so that every transition between vectors is counted
+          ps.simulation_ps.num_threads = 1u;
+          ps.simulation_ps.block_words = static_cast<uint32_t>((num_vectors + 63) / 64);
+          act = mockturtle::switching_activity(ntk, words, num_vectors, ps);
+          patterns = num_vectors;
+        }
+        else{
+          act = mockturtle::switching_activity(ntk, ps);
+          patterns = num_patterns;
+        }
+
+        auto stop = std::chrono::high_resolution_clock::now();
+        auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(stop - start);
+
+        std::cout << "Simulated " << patterns << " patterns in " << duration.count() << "ms\n";
+        std::cout << "Switching activity = " << act.activity << "\n";
+        if(act.num_gates > 0){
+          std::cout << "Average gate signal probability = " << act.gate_probability / act.num_gates << "\n";
+          std::cout << "Average gate toggle rate = " << act.gate_toggles / act.num_gates << "\n";
+        }
+
+        if(top > 0){
+          //foreach_gate also visits the register outputs of sequential networks
+          std::vector<uint32_t> nodes;
+          ntk.foreach_gate([&](auto n){
+            if constexpr(mockturtle::has_is_ci_v<Ntk>){
+              if(ntk.is_ci(n)){
+                return;
+              }
+            }
+            nodes.push_back(ntk.node_to_index(n));
+          });
+          const auto count = std::min<std::size_t>(top, nodes.size());
+          std::partial_sort(nodes.begin(), nodes.begin() + count, nodes.end(), [&](auto a, auto b){
+            return act.toggle_rate[a] > act.toggle_rate[b];
+          });
+          for(std::size_t i = 0; i < count; i++){
+            std::cout << "Node " << nodes[i] << ": probability = " << act.probability[nodes[i]]
+                      << " toggle rate = " << act.toggle_rate[nodes[i]] << "\n";
+          }
+        }
+      }
+
+      uint64_t num_patterns{1u << 14};
+      uint64_t seed{1u};
+      std::string vectors{};
+      unsigned num_threads{1u};
+      unsigned top{0u};
+    };
+
+  ALICE_ADD_COMMAND(power, "Network_Statistics");
+
   ALICE_COMMAND(get_cones, "Network_Statistics", "Displays size and depth of all logic cones in the stored AIG network") {
 
     if(!store<mockturtle::aig_network>().empty()){
@@ -2330,6 +3192,490 @@ namespace alice{
 
   }
 
+  class seqrw_command : public alice::command{
+
+    public:
+      explicit seqrw_command( const environment::ptr& env )
+          : command( env, "Sequential rewriting with register sweeping and forward retiming" ){
+
+        opts.add_option( "--rounds,-r", max_rounds, "Rounds of rewriting and register transformations [DEFAULT = 4]" );
+        add_flag("--mig,-m", "Rewrite the stored MIG network (AIG is default)");
+        add_flag("--no_retime", "Keep registers where they are, only merge and remove them");
+        add_flag("--verbose,-v", "Report statistics");
+      }
+
+    protected:
+      void execute(){
+        mockturtle::seq_rewriting_params ps;
+        ps.cut_rewriting_ps.cut_enumeration_ps.cut_size = 4;
+        ps.max_rounds = std::exchange(max_rounds, 4u);
+        ps.retime_forward = !is_set("no_retime");
+        ps.verbose = is_set("verbose");
+
+        if(is_set("mig")){
+          if(!store<mockturtle::mig_network>().empty()){
+            mockturtle::mig_npn_resynthesis resyn;
+            rewrite(store<mockturtle::mig_network>().current(), resyn, ps);
+          }
+          else{
+            std::cout << "There is not an MIG network stored.\n";
+          }
+        }
+        else{
+          if(!store<mockturtle::aig_network>().empty()){
+            mockturtle::xag_npn_resynthesis<mockturtle::aig_network> resyn;
+            rewrite(store<mockturtle::aig_network>().current(), resyn, ps);
+          }
+          else{
+            std::cout << "There is not an AIG network stored.\n";
+          }
+        }
+      }
+
+    private:
+      template<class Ntk, class Resyn>
+      void rewrite(Ntk& ntk, Resyn& resyn, mockturtle::seq_rewriting_params const& ps){
+        auto start = std::chrono::high_resolution_clock::now();
+        std::cout << "Initial ntk size = " << ntk.num_gates() << " registers = " << ntk.num_latches() << "\n";
+
+        ntk = mockturtle::seq_rewriting(ntk, resyn, ps);
+
+        mockturtle::depth_view depth{ntk};
+        std::cout << "Final ntk size = " << ntk.num_gates() << " registers = " << ntk.num_latches() << " and depth = " << depth.depth() << "\n";
+        auto stop = std::chrono::high_resolution_clock::now();
+        auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(stop - start);
+        std::cout << "Full Optimization: " << duration.count() << "ms\n";
+      }
+
+      uint32_t max_rounds{4u};
+  };
+
+  ALICE_ADD_COMMAND(seqrw, "Modification");
+
+  class winrw_command : public alice::command{
+
+    public:
+      explicit winrw_command( const environment::ptr& env )
+          : command( env, "Parallel rewriting of fanout-free windows" ){
+
+        opts.add_option( "--threads,-t", num_threads, "Number of threads [DEFAULT = all hardware threads]" );
+        opts.add_option( "--min_gates,-g", min_gates, "Smallest window that is rewritten [DEFAULT = 3]" );
+        add_flag("--mig,-m", "Rewrite the stored MIG network (AIG is default)");
+        add_flag("--xag,-x", "Rewrite the stored XAG network (AIG is default)");
+      }
+
+    protected:
+      void execute(){
+        mockturtle::window_rewriting_params ps;
+        ps.num_threads = num_threads;
+        ps.min_gates = min_gates;
+
+        if(is_set("mig")){
+          if(!store<mockturtle::mig_network>().empty()){
+            auto& mig = store<mockturtle::mig_network>().current();
+            rewrite(mig, [](){
+              return [resyn = std::make_shared<mockturtle::mig_npn_resynthesis>()](mockturtle::mig_network& win){
+                run_cut_rewriting(win, *resyn);
+              };
+            }, ps);
+          }
+          else{
+            std::cout << "There is not an MIG network stored.\n";
+          }
+        }
+        else if(is_set("xag")){
+          if(!store<mockturtle::xag_network>().empty()){
+            auto& xag = store<mockturtle::xag_network>().current();
+            rewrite(xag, [](){
+              return [resyn = std::make_shared<mockturtle::xag_npn_resynthesis<mockturtle::xag_network>>()](mockturtle::xag_network& win){
+                run_cut_rewriting(win, *resyn);
+              };
+            }, ps);
+          }
+          else{
+            std::cout << "There is not an XAG network stored.\n";
+          }
+        }
+        else{
+          if(!store<mockturtle::aig_network>().empty()){
+            auto& aig = store<mockturtle::aig_network>().current();
+            rewrite(aig, [](){
+              return [resyn = std::make_shared<mockturtle::xag_npn_resynthesis<mockturtle::aig_network>>()](mockturtle::aig_network& win){
+                run_cut_rewriting(win, *resyn);
+              };
+            }, ps);
+          }
+          else{
+            std::cout << "There is not an AIG network stored.\n";
+          }
+        }
+      }
+
+    private:
+      template<class Ntk, class Resyn>
+      static void run_cut_rewriting(Ntk& win, Resyn& resyn){
+        mockturtle::cut_rewriting_params ps;
+        ps.cut_enumeration_ps.cut_size = 4;
+
+        mockturtle::cut_rewriting(win, resyn, ps);
+        win = mockturtle::cleanup_dangling(win);
+      }
+
+      template<class Ntk, class OptFactory>
+      void rewrite(Ntk& ntk, OptFactory&& make_opt, mockturtle::window_rewriting_params const& ps){
+        auto start = std::chrono::high_resolution_clock::now();
+        std::cout << "Initial ntk size = " << ntk.num_gates() << "\n";
+
+        mockturtle::window_rewriting_stats st;
+        mockturtle::window_rewriting(ntk, make_opt, ps, &st);
+        ntk = mockturtle::cleanup_dangling(ntk);
+
+        mockturtle::depth_view ntk_depth{ntk};
+        std::cout << "Windows = " << st.windows << " replaced = " << st.committed << "\n";
+        std::cout << "Final ntk size = " << ntk.num_gates() << " and depth = " << ntk_depth.depth() << "\n";
+        auto stop = std::chrono::high_resolution_clock::now();
+        auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(stop - start);
+        std::cout << "Full Optimization: " << duration.count() << "ms\n";
+      }
+
+      unsigned num_threads{0u};
+      unsigned min_gates{3u};
+    };
+
+  ALICE_ADD_COMMAND(winrw, "Modification");
+
+  class optimize_loop_command : public alice::command{
+
+    public:
+      explicit optimize_loop_command( const environment::ptr& env )
+          : command( env, "Repartitions with a new seed and optimizes the partitions in parallel until the area-delay product converges" ){
+
+        opts.add_option( "--num_parts,-p", num_parts, "Number of partitions per iteration (chosen automatically if omitted)" );
+        opts.add_option( "--iterations,-i", max_iterations, "Largest number of iterations [DEFAULT = 8]" );
+        opts.add_option( "--min_improvement", min_improvement, "Stop when an iteration improves the area-delay product by less than this fraction [DEFAULT = 0.01]" );
+        opts.add_option( "--time_budget", time_budget, "Seconds for the whole loop, shared by the partitions of each iteration [DEFAULT = no budget]" );
+        opts.add_option( "--seed", first_seed, "KaHyPar seed of the first iteration [DEFAULT = 1]" );
+        opts.add_option( "--preset", preset, "KaHyPar preset: fast, default or quality [DEFAULT = fast]" );
+        opts.add_option( "--threads,-t", num_threads, "Number of threads [DEFAULT = all hardware threads]" );
+        add_flag("--mig,-m", "Optimize the stored MIG network (AIG is default)");
+        add_flag("--xag,-x", "Optimize the stored XAG network (AIG is default)");
+      }
+
+    protected:
+      void execute(){
+        oracle::optimize_loop_params ps;
+        ps.num_parts = is_set("num_parts") ? num_parts : 0u;
+        ps.max_iterations = max_iterations;
+        ps.min_improvement = min_improvement;
+        ps.time_budget = time_budget;
+        ps.first_seed = first_seed;
+        ps.num_threads = num_threads;
+        ps.verbose = true;
+
+        oracle::kahypar_config config;
+        config.preset = preset;
+
+        if(is_set("mig")){
+          if(!store<mockturtle::mig_network>().empty()){
+            auto& mig = store<mockturtle::mig_network>().current();
+            run(mig, [](oracle::partition_view<mockturtle::mig_network> const& part){
+              return part_to_mig(part, 0);
+            }, [](){
+              return [](mockturtle::mig_network& part, mockturtle::deadline const& until){
+                mockturtle::mig_script migopt;
+                migopt.time_limit = until;
+                part = migopt.run(part);
+              };
+            }, config, ps);
+          }
+          else{
+            std::cout << "There is not an MIG network stored.\n";
+          }
+        }
+        else if(is_set("xag")){
+          if(!store<mockturtle::xag_network>().empty()){
+            auto& xag = store<mockturtle::xag_network>().current();
+            run(xag, [](oracle::partition_view<mockturtle::xag_network> const& part){
+              return part_to_xag(part);
+            }, [](){
+              return [](mockturtle::xag_network& part, mockturtle::deadline const& until){
+                mockturtle::xag_script xagopt;
+                xagopt.time_limit = until;
+                part = xagopt.run(part);
+              };
+            }, config, ps);
+          }
+          else{
+            std::cout << "There is not an XAG network stored.\n";
+          }
+        }
+        else{
+          if(!store<mockturtle::aig_network>().empty()){
+            auto& aig = store<mockturtle::aig_network>().current();
+            run(aig, [](oracle::partition_view<mockturtle::aig_network> const& part){
+              mockturtle::direct_resynthesis<mockturtle::aig_network> resyn_aig;
+              return mockturtle::node_resynthesis<mockturtle::aig_network>(part, resyn_aig);
+            }, [](){
+              return [](mockturtle::aig_network& part, mockturtle::deadline const& until){
+                mockturtle::aig_script aigopt;
+                aigopt.time_limit = until;
+                part = aigopt.run(part);
+              };
+            }, config, ps);
+          }
+          else{
+            std::cout << "There is not an AIG network stored.\n";
+          }
+        }
+      }
+
+    private:
+      template<class Ntk, class Extract, class OptFactory>
+      void run(Ntk& ntk, Extract&& extract, OptFactory&& make_opt, oracle::kahypar_config const& config, oracle::optimize_loop_params const& ps){
+        auto start = std::chrono::high_resolution_clock::now();
+
+        oracle::optimize_loop_stats st;
+        oracle::optimize_loop(ntk, extract, make_opt, config, ps, &st);
+
+        std::cout << "Initial ntk size = " << st.initial_gates << " and depth = " << st.initial_depth << "\n";
+        mockturtle::depth_view ntk_depth{ntk};
+        std::cout << "Final ntk size = " << ntk.num_gates() << " and depth = " << ntk_depth.depth() << "\n";
+        std::cout << "Area Delay Product = " << ntk.num_gates() * ntk_depth.depth() << "\n";
+        if(st.out_of_time){
+          std::cout << "Stopped after " << st.iterations.size() << " iterations to stay within the time budget\n";
+        }
+        auto stop = std::chrono::high_resolution_clock::now();
+        auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(stop - start);
+        std::cout << "Full Optimization: " << duration.count() << "ms\n";
+      }
+
+      unsigned num_parts{0u};
+      unsigned max_iterations{8u};
+      double min_improvement{0.01};
+      double time_budget{0.0};
+      int first_seed{1};
+      std::string preset{"fast"};
+      unsigned num_threads{0u};
+    };
+
+  ALICE_ADD_COMMAND(optimize_loop, "Optimization");
+
+  class batch_command : public alice::command{
+
+    public:
+      explicit batch_command( const environment::ptr& env )
+          : command( env, "Runs a command script on a list of designs in parallel worker processes" ){
+
+        opts.add_option( "--designs,-d", designs_file, "File with one design path per line" )->required();
+        opts.add_option( "--script,-s", script_file, "Commands run on every design, {design}, {name} and {threads} are substituted" )->required();
+        opts.add_option( "--out_dir,-o", out_dir, "Directory for the per design logs and JSON results [DEFAULT = batch_results]" );
+        opts.add_option( "--jobs,-j", num_jobs, "Designs processed at the same time [DEFAULT = 1]" );
+        opts.add_option( "--threads,-t", num_threads, "Thread budget shared by all jobs [DEFAULT = all hardware threads]" );
+      }
+
+    protected:
+      void execute(){
+        const auto designs = read_lines(designs_file);
+        const auto script = read_lines(script_file);
+        if(designs.empty() || script.empty()){
+          std::cout << "Nothing to run, the design list or the script is empty\n";
+          return;
+        }
+        if(mkdir(out_dir.c_str(), 0777) != 0 && errno != EEXIST){
+          std::cout << "Could not create output directory " << out_dir << ": " << std::strerror(errno) << "\n";
+          return;
+        }
+        if(!std::filesystem::is_directory(out_dir)){
+          std::cout << "Output directory " << out_dir << " is not a directory\n";
+          return;
+        }
+
+        const unsigned jobs = std::max(1u, num_jobs);
+        const unsigned budget = num_threads != 0u ? num_threads : std::max(1u, std::thread::hardware_concurrency());
+        const unsigned threads = std::max(1u, budget / jobs);
+
+        std::vector<std::string> names;
+        std::unordered_map<std::string, unsigned> seen;
+        for(auto const& design : designs){
+          auto name = std::filesystem::path(design).stem().string();
+          if(seen[name]++ > 0u){
+            name += "_" + std::to_string(seen[name] - 1u);
+          }
+          names.push_back(name);
+        }
+
+        auto start = std::chrono::high_resolution_clock::now();
+        std::unordered_map<pid_t, std::size_t> running;
+        std::vector<std::chrono::high_resolution_clock::time_point> started(designs.size());
+        std::vector<int> exit_codes(designs.size(), -1);
+        std::size_t next = 0;
+        while(next < designs.size() || !running.empty()){
+          while(next < designs.size() && running.size() < jobs){
+            const auto i = next++;
+            std::cout.flush();
+            started[i] = std::chrono::high_resolution_clock::now();
+            const pid_t pid = launch_design(designs[i], names[i], script, threads);
+            if(pid < 0){
+              std::cerr << "Could not start a job for " << designs[i] << "\n";
+            }
+            else{
+              running[pid] = i;
+            }
+          }
+
+          if(running.empty()){
+            continue;
+          }
+          int status = 0;
+          const pid_t pid = wait(&status);
+          if(pid < 0){
+            break;
+          }
+          auto it = running.find(pid);
+          if(it == running.end()){
+            continue;
+          }
+          const auto i = it->second;
+          exit_codes[i] = WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+          write_result(designs[i], names[i], threads, exit_codes[i],
+                       std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - started[i]).count());
+          std::cout << (exit_codes[i] == 0 ? "[done]   " : "[failed] ") << designs[i] << "\n";
+          running.erase(it);
+        }
+
+        nlohmann::json results = nlohmann::json::array();
+        unsigned failed = 0u;
+        for(auto i = 0u; i < designs.size(); ++i){
+          std::ifstream in(result_path(names[i]));
+          nlohmann::json result;
+          if(in.good()){
+            in >> result;
+          }
+          else{
+            result = {{"design", designs[i]}, {"status", "crashed"}};
+          }
+          if(result["status"] != "ok"){
+            ++failed;
+          }
+          results.push_back(result);
+        }
+        std::ofstream(out_dir + "/batch.json") << std::setw(2) << results << "\n";
+
+        auto stop = std::chrono::high_resolution_clock::now();
+        auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(stop - start);
+        std::cout << designs.size() << " designs (" << failed << " failed) in " << duration.count() << "ms, results in " << out_dir << "/batch.json\n";
+      }
+
+    private:
+      std::string result_path(std::string const& name) const{
+        return out_dir + "/" + name + ".json";
+      }
+
+      std::string alice_log_path(std::string const& name) const{
+        return out_dir + "/" + name + ".alice.json";
+      }
+
+      static std::vector<std::string> read_lines(std::string const& filename){
+        std::vector<std::string> lines;
+        std::ifstream in(filename);
+        std::string line;
+        while(std::getline(in, line)){
+          alice::detail::trim(line);
+          if(!line.empty() && line[0] != '#'){
+            lines.push_back(line);
+          }
+        }
+        return lines;
+      }
+
+      static std::string substitute(std::string line, std::string const& key, std::string const& value){
+        for(auto pos = line.find(key); pos != std::string::npos; pos = line.find(key, pos + value.size())){
+          line.replace(pos, key.size(), value);
+        }
+        return line;
+      }
+
+      /* Starts a fresh lsoracle process that runs the script with -c and logs every command with -l.
+         The script ends with silent ps commands so the log also holds the statistics of the stored
+         networks. Everything the child needs is prepared before the fork, which is followed directly
+         by exec, so no state of this process (threads, stores, streams) is used by the job. */
+      pid_t launch_design(std::string const& design, std::string const& name, std::vector<std::string> const& script, unsigned threads){
+        std::string commands;
+        for(auto const& entry : script){
+          commands += substitute(substitute(substitute(entry, "{design}", design), "{name}", name), "{threads}", std::to_string(threads)) + "; ";
+        }
+        commands += "ps -a --silent; ps -m --silent; ps -x --silent";
+
+        const auto log = out_dir + "/" + name + ".log";
+        const auto alice_log = alice_log_path(name);
+        std::remove(alice_log.c_str());
+        std::vector<std::string> args{"lsoracle", "-c", commands, "-l", alice_log};
+        std::vector<char*> argv;
+        for(auto& arg : args){
+          argv.push_back(arg.data());
+        }
+        argv.push_back(nullptr);
+
+        const pid_t pid = fork();
+        if(pid == 0){
+          const int fd = open(log.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+          if(fd < 0){
+            _exit(127);
+          }
+          dup2(fd, STDOUT_FILENO);
+          dup2(fd, STDERR_FILENO);
+          close(fd);
+          execv("/proc/self/exe", argv.data());
+          _exit(127);
+        }
+        return pid;
+      }
+
+      //collects the alice log of a finished job into its result file
+      void write_result(std::string const& design, std::string const& name, unsigned threads, int exit_code, long long time_ms) const{
+        nlohmann::json result = {{"design", design}, {"threads", threads}, {"time_ms", time_ms}, {"exit_code", exit_code}};
+        result["status"] = exit_code == 0 ? "ok" : "failed";
+
+        nlohmann::json entries = nlohmann::json::array();
+        std::ifstream in(alice_log_path(name));
+        if(in.good()){
+          try{
+            in >> entries;
+          }
+          catch(std::exception const&){
+            entries = nlohmann::json::array();
+          }
+        }
+
+        nlohmann::json commands = nlohmann::json::array();
+        for(auto const& entry : entries){
+          const auto command = entry.value("command", std::string{});
+          if(command == "ps -a --silent" || command == "ps -m --silent" || command == "ps -x --silent"){
+            auto stats = entry;
+            stats.erase("command");
+            stats.erase("time");
+            if(!stats.empty()){
+              result[command.substr(4, 1) == "a" ? "aig" : command.substr(4, 1) == "m" ? "mig" : "xag"] = stats;
+            }
+          }
+          else{
+            commands.push_back(entry);
+          }
+        }
+        result["commands"] = commands;
+
+        std::ofstream(result_path(name)) << std::setw(2) << result << "\n";
+      }
+
+      std::string designs_file{};
+      std::string script_file{};
+      std::string out_dir{"batch_results"};
+      unsigned num_jobs{1u};
+      unsigned num_threads{0u};
+    };
+
+  ALICE_ADD_COMMAND(batch, "Batch");
+
   ALICE_COMMAND(depthr, "Modification", "Logic depth oriented MIG rewriting"){
     if(!store<mockturtle::mig_network>().empty()){
       auto& mig = store<mockturtle::mig_network>().current();
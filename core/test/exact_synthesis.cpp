@@ -0,0 +1,117 @@
+#include <catch.hpp>
+
+#if defined( LSORACLE_USE_PERCY )
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <kitty/constructors.hpp>
+#include <kitty/dynamic_truth_table.hpp>
+#include <kitty/npn.hpp>
+#include <mockturtle/algorithms/cleanup.hpp>
+#include <mockturtle/algorithms/cut_rewriting.hpp>
+#include <mockturtle/algorithms/node_resynthesis/exact.hpp>
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/networks/aig.hpp>
+
+using namespace mockturtle;
+
+namespace
+{
+
+std::vector<kitty::static_truth_table<4>> simulate_pos( aig_network const& aig )
+{
+  return simulate<kitty::static_truth_table<4>>( aig );
+}
+
+} // namespace
+
+TEST_CASE( "exact database synthesizes in the caller", "[exact_synthesis]" )
+{
+  exact_resynthesis_params ps;
+  ps.blocking = true;
+  exact_database db( ps );
+
+  kitty::dynamic_truth_table tt( 3u );
+  kitty::create_majority( tt );
+  const auto repr = std::get<0>( kitty::exact_npn_canonization( tt ) );
+
+  CHECK( !db.lookup( repr ) );
+  const auto chain = db.synthesize( repr );
+  REQUIRE( chain );
+  CHECK( chain->num_inputs == 3u );
+  CHECK( chain->steps.size() == 4u );
+
+  /* a second synthesis is answered from the database */
+  CHECK( db.synthesize( repr ) );
+
+  const auto st = db.stats();
+  CHECK( st.misses == 1u );
+  CHECK( st.hits == 0u );
+  CHECK( st.synthesized == 1u );
+  CHECK( st.entries == 1u );
+}
+
+TEST_CASE( "exact resynthesis counts a blocking miss once", "[exact_synthesis]" )
+{
+  aig_network aig;
+  const auto a = aig.create_pi();
+  const auto b = aig.create_pi();
+  const auto c = aig.create_pi();
+
+  /* and( a, or( b, c ) ) built with redundant gates */
+  const auto f = aig.create_or( aig.create_and( a, b ), aig.create_and( a, c ) );
+  aig.create_po( f );
+  const auto before = simulate_pos( aig );
+
+  exact_resynthesis_params ps;
+  ps.blocking = true;
+  ps.max_inputs = 3u;
+  exact_database db( ps );
+
+  exact_resynthesis<aig_network> resyn( db );
+  cut_rewriting_params crps;
+  crps.cut_enumeration_ps.cut_size = 3u;
+  cut_rewriting( aig, resyn, crps );
+  aig = cleanup_dangling( aig );
+
+  CHECK( aig.num_gates() == 2u );
+  CHECK( simulate_pos( aig ) == before );
+
+  const auto st = db.stats();
+  CHECK( st.misses == st.synthesized + st.failed );
+  CHECK( st.hits + st.misses > 0u );
+}
+
+TEST_CASE( "exact database is saved and loaded", "[exact_synthesis]" )
+{
+  const std::string filename = "exact_synthesis_test.db";
+  std::remove( filename.c_str() );
+
+  kitty::dynamic_truth_table tt( 2u );
+  kitty::create_from_hex_string( tt, "6" );
+  const auto repr = std::get<0>( kitty::exact_npn_canonization( tt ) );
+
+  {
+    exact_resynthesis_params ps;
+    ps.blocking = true;
+    ps.database = filename;
+    exact_database db( ps );
+    REQUIRE( db.synthesize( repr ) );
+  }
+
+  exact_resynthesis_params ps;
+  ps.database = filename;
+  ps.num_threads = 0u;
+  exact_database db( ps );
+  const auto chain = db.lookup( repr );
+  REQUIRE( chain );
+  CHECK( chain->steps.size() == 1u );
+  CHECK( db.stats().hits == 1u );
+
+  std::remove( filename.c_str() );
+}
+
+#endif
@@ -0,0 +1,146 @@
+#include <catch.hpp>
+
+#include <cstdint>
+#include <vector>
+
+#include <kitty/constructors.hpp>
+#include <kitty/dynamic_truth_table.hpp>
+#include <mockturtle/algorithms/compiled_simulation.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/mig.hpp>
+#include <mockturtle/networks/xag.hpp>
+
+#include "../gia_bridge.hpp"
+
+using namespace mockturtle;
+
+namespace
+{
+
+/* one word of exhaustive patterns per combinational input, at most six of them */
+template<class Ntk>
+std::vector<uint64_t> simulate_cos( Ntk const& ntk )
+{
+  const compiled_simulation sim( ntk );
+  std::vector<uint64_t> words;
+  for ( auto i = 0u; i < sim.num_pis(); ++i )
+  {
+    kitty::dynamic_truth_table tt( 6u );
+    kitty::create_nth_var( tt, i );
+    words.push_back( tt._bits[0] );
+  }
+  return sim.simulate( words, 1u );
+}
+
+template<class Ntk>
+uint32_t num_cis( Ntk const& ntk )
+{
+  uint32_t count{0u};
+  ntk.foreach_ci( [&]( auto const& ) { ++count; } );
+  return count;
+}
+
+template<class Ntk>
+uint32_t num_cos( Ntk const& ntk )
+{
+  uint32_t count{0u};
+  ntk.foreach_co( [&]( auto const& ) { ++count; } );
+  return count;
+}
+
+template<class Ntk>
+void check_round_trip( Ntk const& ntk )
+{
+  auto gia = alice::ntk_to_gia( ntk, "seq" );
+  CHECK( abc::Gia_ManPiNum( gia ) == static_cast<int>( num_cis( ntk ) - ntk.num_latches() ) );
+  CHECK( abc::Gia_ManRegNum( gia ) == static_cast<int>( ntk.num_latches() ) );
+
+  const auto aig = alice::gia_to_aig( gia );
+  abc::Gia_ManStop( gia );
+
+  CHECK( num_cis( aig ) == num_cis( ntk ) );
+  CHECK( num_cos( aig ) == num_cos( ntk ) );
+  REQUIRE( aig.num_latches() == ntk.num_latches() );
+  for ( auto i = 0u; i < ntk.num_latches(); ++i )
+  {
+    CHECK( aig.latch_reset( i ) == ntk.latch_reset( i ) );
+  }
+  CHECK( simulate_cos( aig ) == simulate_cos( ntk ) );
+}
+
+template<class Ntk>
+Ntk sequential_network()
+{
+  Ntk ntk;
+  const auto a = ntk.create_pi();
+  const auto b = ntk.create_pi();
+  const auto r1 = ntk.create_ro();
+  const auto r2 = ntk.create_ro();
+  ntk.create_ro();
+
+  const auto f1 = ntk.create_and( a, ntk.create_not( r1 ) );
+  const auto f2 = ntk.create_or( ntk.create_and( r1, r2 ), ntk.create_and( ntk.create_not( r2 ), b ) );
+  const auto f3 = ntk.create_xor( f1, f2 );
+
+  /* only feeds a register */
+  const auto f4 = ntk.create_and( ntk.create_not( a ), b );
+
+  ntk.create_po( f3 );
+  ntk.create_ri( f1, 1 );
+  ntk.create_ri( f2, 0 );
+  ntk.create_ri( f4, 1 );
+  return ntk;
+}
+
+} // namespace
+
+TEST_CASE( "GIA round trip keeps registers of an AIG", "[gia_bridge]" )
+{
+  check_round_trip( sequential_network<aig_network>() );
+}
+
+TEST_CASE( "GIA round trip keeps registers of an XAG", "[gia_bridge]" )
+{
+  check_round_trip( sequential_network<xag_network>() );
+}
+
+TEST_CASE( "GIA round trip keeps registers of a MIG", "[gia_bridge]" )
+{
+  check_round_trip( sequential_network<mig_network>() );
+}
+
+TEST_CASE( "GIA round trip follows the fanin order after substitutions", "[gia_bridge]" )
+{
+  aig_network aig;
+  const auto a = aig.create_pi();
+  const auto b = aig.create_pi();
+  const auto r = aig.create_ro();
+  const auto c = aig.create_and( b, r );
+  const auto f = aig.create_and( a, c );
+  aig.create_po( f );
+  aig.create_ri( aig.create_not( f ), 1 );
+
+  /* g has a higher index than f but now feeds it */
+  const auto g = aig.create_or( b, r );
+  aig.substitute_node( aig.get_node( c ), g );
+  REQUIRE( aig.node_to_index( aig.get_node( g ) ) > aig.node_to_index( aig.get_node( f ) ) );
+
+  check_round_trip( aig );
+}
+
+TEST_CASE( "GIA engines keep the register reset values", "[gia_bridge]" )
+{
+  const auto ntk = sequential_network<aig_network>();
+  auto gia = alice::ntk_to_gia( ntk, "seq" );
+  REQUIRE( alice::run_gia_script( gia, "dc2; syn3" ) );
+
+  const auto aig = alice::gia_to_aig( gia );
+  abc::Gia_ManStop( gia );
+
+  REQUIRE( aig.num_latches() == ntk.num_latches() );
+  for ( auto i = 0u; i < ntk.num_latches(); ++i )
+  {
+    CHECK( aig.latch_reset( i ) == ntk.latch_reset( i ) );
+  }
+  CHECK( simulate_cos( aig ) == simulate_cos( ntk ) );
+}
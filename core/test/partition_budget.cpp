@@ -0,0 +1,55 @@
+#include <catch.hpp>
+
+#include <cstdint>
+#include <vector>
+
+#include <oracle/partitioning/partition_budget.hpp>
+
+using namespace oracle;
+
+TEST_CASE( "partition budget without a time limit", "[partition_budget]" )
+{
+  partition_budget budget( 0.0, {10u, 20u} );
+  CHECK( !budget.end().is_set() );
+  CHECK( !budget.start( 0u ).is_set() );
+  CHECK( !budget.start( 1u ).is_set() );
+}
+
+TEST_CASE( "partition budget shares the time by size", "[partition_budget]" )
+{
+  partition_budget budget( 100.0, {10u, 30u} );
+  CHECK( budget.end().is_set() );
+
+  /* a quarter of the weight gets a quarter of the time */
+  const auto first = budget.start( 0u );
+  CHECK( first.remaining() == Approx( 25.0 ).margin( 1.0 ) );
+
+  /* the last job gets everything that is left */
+  const auto last = budget.start( 1u );
+  CHECK( last.remaining() == Approx( budget.end().remaining() ).margin( 1.0 ) );
+
+  /* starting a job again or an unknown job yields the overall deadline */
+  CHECK( budget.start( 1u ).remaining() == Approx( budget.end().remaining() ).margin( 1.0 ) );
+  CHECK( budget.start( 2u ).remaining() == Approx( budget.end().remaining() ).margin( 1.0 ) );
+}
+
+TEST_CASE( "partition budget weighs jobs by expected gain", "[partition_budget]" )
+{
+  partition_budget budget( 100.0, {10u, 10u, 10u}, {1.0, 3.0, 0.0} );
+
+  CHECK( budget.start( 2u ).expired() );
+  CHECK( budget.start( 0u ).remaining() == Approx( 25.0 ).margin( 1.0 ) );
+}
+
+TEST_CASE( "partition budget for parallel jobs", "[partition_budget]" )
+{
+  partition_budget budget( 100.0, {10u, 10u, 10u, 10u}, {}, 2u );
+
+  /* two of four equal jobs run at a time, so each one gets half of the time */
+  CHECK( budget.start( 0u ).remaining() == Approx( 50.0 ).margin( 1.0 ) );
+  CHECK( budget.start( 1u ).remaining() == Approx( 100.0 * 2u / 3u ).margin( 1.0 ) );
+
+  /* no share exceeds the overall deadline */
+  CHECK( budget.start( 2u ).remaining() <= budget.end().remaining() );
+  CHECK( budget.start( 3u ).remaining() <= budget.end().remaining() );
+}
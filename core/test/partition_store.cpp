@@ -0,0 +1,123 @@
+#include <catch.hpp>
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <kitty/static_truth_table.hpp>
+#include <mockturtle/algorithms/cleanup.hpp>
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/networks/mig.hpp>
+#include <oracle/partitioning/partition_store.hpp>
+#include <oracle/partitioning/partition_view.hpp>
+
+using namespace oracle;
+
+namespace
+{
+
+using mig = mockturtle::mig_network;
+
+/* copies a partition into a standalone network, in the order of its inputs and outputs */
+mig extract( partition_view<mig> const& part )
+{
+  mig ntk;
+  std::unordered_map<mig::node, mig::signal> old_to_new{{part.get_node( part.get_constant( false ) ), ntk.get_constant( false )}};
+  part.foreach_pi( [&]( auto const& n ) {
+    old_to_new[n] = ntk.create_pi();
+  } );
+  part.foreach_gate( [&]( auto const& n ) {
+    std::vector<mig::signal> children;
+    part.foreach_fanin( n, [&]( auto const& f ) {
+      const auto s = old_to_new.at( part.get_node( f ) );
+      children.push_back( part.is_complemented( f ) ? ntk.create_not( s ) : s );
+    } );
+    old_to_new[n] = ntk.create_maj( children[0], children[1], children[2] );
+  } );
+  part.foreach_po( [&]( auto const& f ) {
+    const auto s = old_to_new.at( part.get_node( f ) );
+    ntk.create_po( part.is_complemented( f ) ? ntk.create_not( s ) : s );
+  } );
+  return ntk;
+}
+
+std::vector<kitty::static_truth_table<4>> simulate_cos( mig const& ntk )
+{
+  return mockturtle::simulate<kitty::static_truth_table<4>>( ntk );
+}
+
+} // namespace
+
+TEST_CASE( "partition store stitches a design without the original network", "[partition_store]" )
+{
+  const std::string dir = "partition_store_test";
+  std::vector<kitty::static_truth_table<4>> expected;
+
+  {
+    mig ntk;
+    const auto a = ntk.create_pi();
+    const auto b = ntk.create_pi();
+    const auto c = ntk.create_pi();
+    const auto r = ntk.create_ro();
+
+    /* the two partitions feed each other: g1 -> g2 -> g3 -> g4 */
+    const auto g1 = ntk.create_and( a, b );
+    const auto g2 = ntk.create_or( g1, c );
+    const auto g3 = ntk.create_and( g2, !c );
+    const auto g4 = ntk.create_maj( g3, r, a );
+    ntk.create_po( g3 );
+    ntk.create_po( !g4 );
+    ntk.create_ri( g2, 1 );
+    expected = simulate_cos( ntk );
+
+    const auto node = [&]( auto const& f ) { return ntk.get_node( f ); };
+    partition_view<mig> part0( ntk, std::set<mig::node>{node( a ), node( b ), node( c ), node( g2 )}, std::set<mig::node>{node( g1 ), node( g3 )}, false );
+    partition_view<mig> part1( ntk, std::set<mig::node>{node( a ), node( g1 ), node( c ), node( g3 ), node( r )}, std::set<mig::node>{node( g2 ), node( g4 )}, false );
+
+    partition_store<mig> store( dir );
+    store.write_interface( ntk );
+    store.write( 0u, extract( part0 ) );
+    store.write_boundary( 0u, partition_store<mig>::boundary_of( ntk, part0 ) );
+    store.write( 1u, extract( part1 ) );
+    store.write_boundary( 1u, partition_store<mig>::boundary_of( ntk, part1 ) );
+  }
+
+  /* the design is gone, only the files are left */
+  partition_store<mig> store( dir );
+  const auto boundary = store.read_boundary( 1u );
+  CHECK( boundary.inputs.size() == 5u );
+  CHECK( boundary.outputs.size() == 2u );
+
+  auto ntk = mockturtle::cleanup_dangling( store.stitch( {0u, 1u} ) );
+  CHECK( ntk.num_gates() == 4u );
+  REQUIRE( ntk.num_latches() == 1u );
+  CHECK( ntk.latch_reset( 0u ) == 1 );
+  CHECK( simulate_cos( ntk ) == expected );
+
+  /* the stitching order does not matter */
+  CHECK( simulate_cos( mockturtle::cleanup_dangling( store.stitch( {1u, 0u} ) ) ) == expected );
+
+  store.remove( 0u );
+  store.remove( 1u );
+  store.remove_interface();
+  CHECK( !store.contains( 0u ) );
+  CHECK_THROWS_AS( store.read_boundary( 0u ), std::runtime_error );
+  std::remove( dir.c_str() );
+}
+
+TEST_CASE( "partition store rejects a directory it cannot create", "[partition_store]" )
+{
+  const std::string file = "partition_store_file";
+  std::ofstream( file ) << "not a directory\n";
+
+  CHECK_THROWS_AS( partition_store<mockturtle::mig_network>( file + "/parts" ), std::runtime_error );
+
+  /* an existing directory is fine */
+  CHECK_NOTHROW( partition_store<mockturtle::mig_network>( "." ) );
+  std::remove( file.c_str() );
+}
@@ -58,6 +58,8 @@ KAHYPAR_API kahypar_context_t* kahypar_context_new();
 KAHYPAR_API void kahypar_context_free(kahypar_context_t* kahypar_context);
 KAHYPAR_API void kahypar_configure_context_from_file(kahypar_context_t* kahypar_context,
                                                      const char* ini_file_name);
+KAHYPAR_API void kahypar_configure_context_from_string(kahypar_context_t* kahypar_context,
+                                                       const char* ini_contents);
 
 KAHYPAR_API void kahypar_partition(const kahypar_hypernode_id_t num_vertices,
                                    const kahypar_hyperedge_id_t num_hyperedges,
@@ -20,6 +20,8 @@
 
 #include "libkahypar.h"
 
+#include <sstream>
+
 #include "kahypar/application/command_line_options.h"
 #include "kahypar/macros.h"
 #include "kahypar/partition/context.h"
@@ -45,6 +47,12 @@ void kahypar_configure_context_from_file(kahypar_context_t* kahypar_context,
                              ini_file_name);
 }
 
+void kahypar_configure_context_from_string(kahypar_context_t* kahypar_context,
+                                           const char* ini_contents) {
+  std::istringstream ini(ini_contents);
+  kahypar::parseIniToContext(*reinterpret_cast<kahypar::Context*>(kahypar_context), ini);
+}
+
 
 void kahypar_partition(const kahypar_hypernode_id_t num_vertices,
                        const kahypar_hyperedge_id_t num_hyperedges,
@@ -31,6 +31,7 @@
 
 #pragma once
 
+#include <type_traits>
 #include <vector>
 
 #include "../traits.hpp"
@@ -40,8 +41,47 @@
 namespace mockturtle
 {
 
-template<typename NtkSource, typename NtkDest, typename LeavesIterator>
-std::vector<signal<NtkDest>> cleanup_dangling( NtkSource const& ntk, NtkDest& dest, LeavesIterator begin, LeavesIterator end )
+namespace detail
+{
+
+template<class Ntk, class = void>
+struct has_hashed_storage : std::false_type
+{
+};
+
+template<class Ntk>
+struct has_hashed_storage<Ntk, std::void_t<decltype( std::declval<Ntk>()._storage->nodes.reserve( 0u ) ),
+                                           decltype( std::declval<Ntk>()._storage->hash.reserve( 0u ) )>> : std::true_type
+{
+};
+
+/* reserves room for `size` nodes, with headroom so that the networks'
+   growth check (90% of the capacity) does not trigger while copying */
+template<class Ntk>
+void reserve_storage( Ntk& ntk, std::size_t size )
+{
+  if constexpr ( has_hashed_storage<Ntk>::value )
+  {
+    const auto capacity = size + size / 8u + 16u;
+    if ( ntk._storage->nodes.capacity() < capacity )
+    {
+      ntk._storage->nodes.reserve( capacity );
+    }
+    ntk._storage->hash.reserve( capacity );
+  }
+  else
+  {
+    (void)ntk;
+    (void)size;
+  }
+}
+
+/* copies the logic of ntk into dest; with `AllCis`, the leaves are all
+   combinational inputs and the result holds all combinational outputs, i.e.,
+   register outputs and inputs are included even for networks whose
+   foreach_pi and foreach_po leave them out */
+template<bool AllCis, typename NtkSource, typename NtkDest, typename LeavesIterator>
+std::vector<signal<NtkDest>> cleanup_dangling_impl( NtkSource const& ntk, NtkDest& dest, LeavesIterator begin, LeavesIterator end )
 {
   (void)end;
 
@@ -70,22 +110,29 @@ std::vector<signal<NtkDest>> cleanup_dangling( NtkSource const& ntk, NtkDest& de
 
   /* create inputs in same order */
   auto it = begin;
-  ntk.foreach_pi( [&]( auto node ) {
+  const auto map_input = [&]( auto node ) {
     // std::cout << "cleanup pi = " << node << "\n";
     old_to_new[node] = *it++;
-  } );
+  };
+  if constexpr ( AllCis )
+  {
+    ntk.foreach_ci( map_input );
+  }
+  else
+  {
+    ntk.foreach_pi( map_input );
+  }
   assert( it == end );
 
   /* foreach node in topological order */
-  topo_view topo{ntk};
-  // std::cout << "got topo view\n";
-  topo.foreach_node( [&]( auto node ) {
+  std::vector<signal<NtkDest>> children;
+  const auto copy_node = [&]( auto node ) {
     //std::cout << "There is a node in the new ntk" << std::endl;
     if ( ntk.is_constant( node ) || ntk.is_ci( node ) || ntk.is_ro( node ) )
       return;
     // std::cout << "cleanup node = " << node << "\n";
-    /* collect children */
-    std::vector<signal<NtkDest>> children;
+    /* collect children, the vector is reused to avoid one allocation per node */
+    children.clear();
     ntk.foreach_fanin( node, [&]( auto child, auto ) {
       const auto f = old_to_new[child];
       // std::cout << "cleanup fanin = " << child.index << " and data = " << child.data << "\n";
@@ -101,11 +148,23 @@ std::vector<signal<NtkDest>> cleanup_dangling( NtkSource const& ntk, NtkDest& de
     // std::cout << "cleanup cloning node " << ntk.node_to_index(node) << std::endl;
     old_to_new[node] = dest.clone_node( ntk, node, children );
     // std::cout << "old_to_new = " << old_to_new[node].index << std::endl;
-  } );
+  };
+  if constexpr ( AllCis )
+  {
+    for ( auto const& node : combinational_topo_order( ntk ) )
+    {
+      copy_node( node );
+    }
+  }
+  else
+  {
+    topo_view topo{ntk};
+    topo.foreach_node( copy_node );
+  }
 
   /* create outputs in same order */
   std::vector<signal<NtkDest>> fs;
-  ntk.foreach_po( [&]( auto po ) {
+  const auto map_output = [&]( auto po ) {
     const auto f = old_to_new[po];
     // std::cout << "PO " << po.index << " connected to " << po.data << std::endl;
     // std::cout << "cleanup po on " << po.index << " complemented = " << ntk.is_complemented(po) << "\n";
@@ -118,15 +177,33 @@ std::vector<signal<NtkDest>> cleanup_dangling( NtkSource const& ntk, NtkDest& de
     {
       fs.push_back( f );
     }
-  } );
+  };
+  if constexpr ( AllCis )
+  {
+    ntk.foreach_co( map_output );
+  }
+  else
+  {
+    ntk.foreach_po( map_output );
+  }
 
   return fs;
 }
 
+} // namespace detail
+
+template<typename NtkSource, typename NtkDest, typename LeavesIterator>
+std::vector<signal<NtkDest>> cleanup_dangling( NtkSource const& ntk, NtkDest& dest, LeavesIterator begin, LeavesIterator end )
+{
+  return detail::cleanup_dangling_impl<false>( ntk, dest, begin, end );
+}
+
 /*! \brief Cleans up dangling nodes.
  *
  * This method reconstructs a network and omits all dangling nodes.  The
- * network types of the source and destination network are the same.
+ * network types of the source and destination network are the same.  The
+ * node array and the structural hash table of the result are sized for the
+ * live nodes of `ntk` up front, so that they are not grown while copying.
  *
  * **Required network functions:**
  * - `get_node`
@@ -137,12 +214,13 @@ std::vector<signal<NtkDest>> cleanup_dangling( NtkSource const& ntk, NtkDest& de
  * - `create_not`
  * - `is_complemented`
  * - `foreach_node`
- * - `foreach_pi`
- * - `foreach_po`
+ * - `foreach_ci`
+ * - `foreach_co`
  * - `clone_node`
  * - `is_ci`
  * - `is_constant`
  * - `create_ro`
+ * - `create_ri`
  */
 template<typename Ntk>
 Ntk cleanup_dangling( Ntk const& ntk )
@@ -156,47 +234,39 @@ Ntk cleanup_dangling( Ntk const& ntk )
   static_assert( has_create_not_v<Ntk>, "Ntk does not implement the create_not method" );
   static_assert( has_is_complemented_v<Ntk>, "Ntk does not implement the is_complemented method" );
   static_assert( has_foreach_node_v<Ntk>, "Ntk does not implement the foreach_node method" );
-  static_assert( has_foreach_pi_v<Ntk>, "Ntk does not implement the foreach_pi method" );
-  static_assert( has_foreach_po_v<Ntk>, "Ntk does not implement the foreach_po method" );
+  static_assert( has_foreach_ci_v<Ntk>, "Ntk does not implement the foreach_ci method" );
+  static_assert( has_foreach_co_v<Ntk>, "Ntk does not implement the foreach_co method" );
   static_assert( has_clone_node_v<Ntk>, "Ntk does not implement the clone_node method" );
   static_assert( has_is_ci_v<Ntk>, "Ntk does not implement the is_ci method" );
   static_assert( has_is_constant_v<Ntk>, "Ntk does not implement the is_constant method" );
   static_assert( has_create_ro_v<Ntk>, "Ntk does not implement the create_ro method" );
+  static_assert( has_create_ri_v<Ntk>, "Ntk does not implement the create_ri method" );
 
+  /* registers are the last combinational inputs and outputs; foreach_pi and
+     foreach_po include them for AIGs and MIGs, but not for XAGs */
+  auto num_cis = 0u;
+  ntk.foreach_ci( [&]( auto const& ) { ++num_cis; } );
 
   Ntk dest;
+  detail::reserve_storage( dest, ntk.num_gates() + num_cis + 1u );
   std::vector<signal<Ntk>> pis;
+  pis.reserve( num_cis );
 
-  // std::cout << "Current number of POs " << ntk.num_pos() << std::endl;
-  // std::cout << "Current number of latches " << ntk.num_latches() << std::endl;
-  // std::cout << "Current number of ANDS " << ntk.num_gates() << std::endl;
-  // std::cout << "Current number of PIs " << ntk.num_pis() << std::endl;
-  
-
-  //creates latches in the target network
-  for ( auto i = 0u; i < ntk.num_latches(); ++i ){
-    // std::cout << "creating latches on dest ntk" << std::endl;
-    dest._storage->data.latches.emplace_back(0);
-  }
-
-  //create PIs
-  for ( auto i = 0u; i < ntk.num_pis() - ntk.num_latches(); ++i )
+  //create PIs followed by Register Outputs
+  for ( auto i = 0u; i < num_cis; ++i )
   {
-    // std::cout << "creating PI on dest ntk" << std::endl;
-    pis.push_back( dest.create_pi() );
+    pis.push_back( i < num_cis - ntk.num_latches() ? dest.create_pi() : dest.create_ro() );
   }
 
-  //create Registers Outputs
-  for ( auto i = ntk.num_pis() - ntk.num_latches(); i < ntk.num_pis(); ++i )
+  //create POs followed by Register Inputs, keeping the latch reset values
+  const auto fs = detail::cleanup_dangling_impl<true>( ntk, dest, pis.begin(), pis.end() );
+  const auto num_outputs = static_cast<uint32_t>( fs.size() ) - ntk.num_latches();
+  for ( auto i = 0u; i < fs.size(); ++i )
   {
-    // std::cout << "creating RO on dest ntk" << std::endl;
-    pis.push_back( dest.create_ro() );
-  }
-
-  for ( auto f : cleanup_dangling( ntk, dest, pis.begin(), pis.end() ) )
-  {
-    // std::cout << "creating PO on dest ntk" << std::endl;
-    dest.create_po( f );
+    if ( i < num_outputs )
+      dest.create_po( fs[i] );
+    else
+      dest.create_ri( fs[i], ntk.latch_reset( i - num_outputs ) );
   }
 
   return dest;
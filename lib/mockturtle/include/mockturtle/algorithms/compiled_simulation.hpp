@@ -0,0 +1,586 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file compiled_simulation.hpp
+  \brief Bit-parallel simulation of a network compiled to an instruction list
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <kitty/dynamic_truth_table.hpp>
+
+#include "../traits.hpp"
+
+namespace mockturtle
+{
+
+namespace detail
+{
+
+/* Register outputs are simulated as inputs and register inputs as outputs,
+   in the order of foreach_ci and foreach_co, where the network has them. */
+template<class Ntk, class Fn>
+void foreach_combinational_input( Ntk const& ntk, Fn&& fn )
+{
+  if constexpr ( has_foreach_ci_v<Ntk> )
+  {
+    ntk.foreach_ci( fn );
+  }
+  else
+  {
+    ntk.foreach_pi( fn );
+  }
+}
+
+template<class Ntk, class Fn>
+void foreach_combinational_output( Ntk const& ntk, Fn&& fn )
+{
+  if constexpr ( has_foreach_co_v<Ntk> )
+  {
+    ntk.foreach_co( fn );
+  }
+  else
+  {
+    ntk.foreach_po( fn );
+  }
+}
+
+template<class Ntk>
+bool is_combinational_input( Ntk const& ntk, typename Ntk::node const& n )
+{
+  if constexpr ( has_is_ci_v<Ntk> )
+  {
+    return ntk.is_ci( n );
+  }
+  else
+  {
+    return ntk.is_pi( n );
+  }
+}
+
+} // namespace detail
+
+/*! \brief Parameters for compiled_simulation. */
+struct compiled_simulation_params
+{
+  /*! \brief Number of threads (0 uses all hardware threads). */
+  uint32_t num_threads{1u};
+
+  /*! \brief Pattern words (of 64 patterns) that a thread simulates at once. */
+  uint32_t block_words{32u};
+};
+
+/*! \brief Simulates a network as a flat list of bit-parallel instructions.
+ *
+ * The constructor translates the gates in the transitive fanin of the
+ * outputs, in topological order, into instructions with an opcode, fanin
+ * registers with complement flags, and the truth table of the gate as LUT
+ * mask.  AND, XOR and majority gates get their own opcodes, all other
+ * gates are evaluated as LUTs with up to `max_lut_size` inputs; the
+ * constructor throws `std::invalid_argument` for larger gates.  A register
+ * is reused as soon as the last gate reading it has been evaluated, so that
+ * the working set follows the width of the network and not its size.
+ *
+ * Sequential networks are simulated combinationally: register outputs are
+ * inputs after the primary inputs and register inputs are outputs after the
+ * primary outputs, in the order of `foreach_ci` and `foreach_co`.
+ *
+ * Simulation evaluates the instructions on blocks of `block_words` pattern
+ * words.  The loops over the words of a block are branch-free, so that the
+ * compiler vectorizes them.  The blocks are distributed among threads; every
+ * thread owns its registers.
+ *
+ * The instruction list can be reused for any number of patterns, e.g., for
+ * random simulation in equivalence checking or for estimating signal
+ * probabilities and switching activity.
+ *
+   \verbatim embed:rst
+
+   Example
+
+   .. code-block:: c++
+
+      const compiled_simulation sim( aig );
+
+      std::vector<uint64_t> pis( aig.num_pis() * 1024u );
+      // fill pis, word w of PI i is at pis[i * 1024 + w]
+      const auto pos = sim.simulate( pis, 1024u );
+   \endverbatim
+ */
+class compiled_simulation
+{
+public:
+  /*! \brief Largest number of inputs of a gate that is not an AND, XOR, or majority gate. */
+  static constexpr uint32_t max_lut_size = 16u;
+
+  template<class Ntk>
+  explicit compiled_simulation( Ntk const& ntk )
+  {
+    static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
+    static_assert( has_size_v<Ntk>, "Ntk does not implement the size method" );
+    static_assert( has_get_constant_v<Ntk>, "Ntk does not implement the get_constant method" );
+    static_assert( has_get_node_v<Ntk>, "Ntk does not implement the get_node method" );
+    static_assert( has_is_complemented_v<Ntk>, "Ntk does not implement the is_complemented method" );
+    static_assert( has_node_to_index_v<Ntk>, "Ntk does not implement the node_to_index method" );
+    static_assert( has_is_constant_v<Ntk>, "Ntk does not implement the is_constant method" );
+    static_assert( has_is_pi_v<Ntk>, "Ntk does not implement the is_pi method" );
+    static_assert( has_foreach_pi_v<Ntk>, "Ntk does not implement the foreach_pi method" );
+    static_assert( has_foreach_po_v<Ntk>, "Ntk does not implement the foreach_po method" );
+    static_assert( has_foreach_fanin_v<Ntk>, "Ntk does not implement the foreach_fanin method" );
+    static_assert( has_fanin_size_v<Ntk>, "Ntk does not implement the fanin_size method" );
+    static_assert( has_node_function_v<Ntk>, "Ntk does not implement the node_function method" );
+
+    compile( ntk );
+  }
+
+  /*! \brief Number of inputs (primary inputs and register outputs). */
+  uint32_t num_pis() const { return static_cast<uint32_t>( _pi_nodes.size() ); }
+
+  /*! \brief Number of outputs (primary outputs and register inputs). */
+  uint32_t num_pos() const { return static_cast<uint32_t>( _pos.size() ); }
+
+  /*! \brief Number of nodes of the compiled network, i.e., the range of node indexes. */
+  uint32_t num_nodes() const { return _num_nodes; }
+
+  /*! \brief Number of gate instructions. */
+  uint32_t num_instructions() const { return static_cast<uint32_t>( _instructions.size() ); }
+
+  /*! \brief Calls `fn( index )` for the node index of every gate instruction, in evaluation order. */
+  template<class Fn>
+  void foreach_gate( Fn&& fn ) const
+  {
+    for ( auto const& instr : _instructions )
+    {
+      fn( instr.node );
+    }
+  }
+
+  /*! \brief Number of registers (of one block each) a simulation thread uses. */
+  uint32_t num_registers() const { return _num_registers; }
+
+  /*! \brief Simulates `num_words * 64` patterns given for all primary inputs.
+   *
+   * Word `w` of primary input `i` is `pi_words[i * num_words + w]`; the
+   * result holds the primary outputs in the same layout.
+   */
+  std::vector<uint64_t> simulate( std::vector<uint64_t> const& pi_words, uint64_t num_words, compiled_simulation_params const& ps = {} ) const
+  {
+    assert( pi_words.size() == num_pis() * num_words );
+
+    std::vector<uint64_t> po_words( num_pos() * num_words );
+    run(
+        num_words,
+        [&]( uint32_t pi, uint64_t first, uint32_t count, uint64_t* words ) {
+          std::copy_n( pi_words.begin() + pi * num_words + first, count, words );
+        },
+        [&]( uint32_t po, uint64_t first, uint32_t count, uint64_t const* words ) {
+          std::copy_n( words, count, po_words.begin() + po * num_words + first );
+        },
+        []( uint32_t, uint32_t, uint64_t, uint32_t, uint64_t const* ) {},
+        ps );
+    return po_words;
+  }
+
+  /*! \brief Simulates `num_words * 64` patterns block by block.
+   *
+   * For every block of at most `ps.block_words` words starting at word
+   * `first`, `pi_fn( pi, first, count, words )` writes the `count` pattern
+   * words of each primary input, and `po_fn( po, first, count, words )`
+   * receives the values of each primary output.  `node_fn( thread, index,
+   * first, count, words )` observes the values of every primary input and
+   * gate by node index.  The functions are called concurrently for
+   * different blocks if there is more than one thread; `thread` is smaller
+   * than the number of threads and can be used to accumulate per thread.
+   */
+  template<class PiFn, class PoFn, class NodeFn>
+  void run( uint64_t num_words, PiFn&& pi_fn, PoFn&& po_fn, NodeFn&& node_fn, compiled_simulation_params const& ps = {} ) const
+  {
+    const uint32_t block_words = std::max( 1u, ps.block_words );
+    const uint64_t num_blocks = ( num_words + block_words - 1u ) / block_words;
+    const uint32_t threads = static_cast<uint32_t>( std::min<uint64_t>( std::max<uint64_t>( num_threads( ps ), 1u ), std::max<uint64_t>( num_blocks, 1u ) ) );
+
+    std::atomic<uint64_t> next{0u};
+    auto worker = [&]( uint32_t thread ) {
+      std::vector<uint64_t> registers( uint64_t( _num_registers ) * block_words );
+      std::vector<uint64_t> scratch( ( uint64_t( 1u ) << ( std::max( _max_lut_inputs, 1u ) - 1u ) ) * block_words );
+      std::vector<uint64_t> output( block_words );
+
+      for ( auto b = next++; b < num_blocks; b = next++ )
+      {
+        const uint64_t first = b * block_words;
+        const uint32_t count = static_cast<uint32_t>( std::min<uint64_t>( block_words, num_words - first ) );
+        run_block( thread, first, count, block_words, registers.data(), scratch.data(), output.data(), pi_fn, po_fn, node_fn );
+      }
+    };
+
+    std::vector<std::thread> workers;
+    for ( auto i = 1u; i < threads; ++i )
+    {
+      workers.emplace_back( worker, i );
+    }
+    worker( 0u );
+    for ( auto& t : workers )
+    {
+      t.join();
+    }
+  }
+
+  /*! \brief Number of threads used for the parameters. */
+  static uint32_t num_threads( compiled_simulation_params const& ps )
+  {
+    return ps.num_threads != 0u ? ps.num_threads : std::max( 1u, std::thread::hardware_concurrency() );
+  }
+
+private:
+  enum class opcode : uint8_t
+  {
+    and2,
+    xor2,
+    maj3,
+    lut
+  };
+
+  struct instruction
+  {
+    opcode op;
+    uint8_t num_fanins;
+    uint32_t output;
+
+    /* position of the first fanin in _fanins */
+    uint32_t fanins;
+
+    /* node index, for observation */
+    uint32_t node;
+
+    /* LUT mask for up to 6 inputs, otherwise position of the truth table in _functions */
+    uint64_t function;
+  };
+
+  /* operand encoding: register << 1 | complement */
+  static constexpr uint32_t reg_const0 = 0u;
+  static constexpr uint32_t reg_const1 = 1u;
+  static constexpr uint32_t no_register = std::numeric_limits<uint32_t>::max();
+
+  template<class Ntk>
+  void compile( Ntk const& ntk )
+  {
+    _num_nodes = ntk.size();
+
+    std::vector<uint32_t> node_register( _num_nodes, no_register );
+    std::vector<uint32_t> free_registers;
+    _num_registers = 2u;
+
+    const auto allocate = [&]() {
+      if ( free_registers.empty() )
+      {
+        return _num_registers++;
+      }
+      const auto r = free_registers.back();
+      free_registers.pop_back();
+      return r;
+    };
+
+    node_register[ntk.node_to_index( ntk.get_node( ntk.get_constant( false ) ) )] = reg_const0;
+    if ( ntk.get_node( ntk.get_constant( false ) ) != ntk.get_node( ntk.get_constant( true ) ) )
+    {
+      node_register[ntk.node_to_index( ntk.get_node( ntk.get_constant( true ) ) )] = reg_const1;
+    }
+    detail::foreach_combinational_input( ntk, [&]( auto const& n ) {
+      const auto r = allocate();
+      node_register[ntk.node_to_index( n )] = r;
+      _pi_nodes.push_back( ntk.node_to_index( n ) );
+      _pi_registers.push_back( r );
+    } );
+
+    /* gates in the transitive fanin of the outputs in topological order, the
+       traversal stops at inputs and never asks them for fanins */
+    std::vector<typename Ntk::node> gates;
+    {
+      std::vector<uint8_t> visited( _num_nodes, 0u );
+      std::vector<std::pair<typename Ntk::node, bool>> stack;
+      detail::foreach_combinational_output( ntk, [&]( auto const& f ) {
+        stack.emplace_back( ntk.get_node( f ), false );
+        while ( !stack.empty() )
+        {
+          const auto [n, expanded] = stack.back();
+          stack.pop_back();
+          const auto i = ntk.node_to_index( n );
+          if ( expanded )
+          {
+            gates.push_back( n );
+            continue;
+          }
+          if ( visited[i] || ntk.is_constant( n ) || detail::is_combinational_input( ntk, n ) )
+          {
+            continue;
+          }
+          visited[i] = 1u;
+          stack.emplace_back( n, true );
+          ntk.foreach_fanin( n, [&]( auto const& g ) {
+            if ( !visited[ntk.node_to_index( ntk.get_node( g ) )] )
+            {
+              stack.emplace_back( ntk.get_node( g ), false );
+            }
+          } );
+        }
+      } );
+    }
+
+    /* remaining readers of every value; outputs are never released */
+    std::vector<uint32_t> readers( _num_nodes, 0u );
+    for ( auto const& n : gates )
+    {
+      ntk.foreach_fanin( n, [&]( auto const& f ) {
+        ++readers[ntk.node_to_index( ntk.get_node( f ) )];
+      } );
+    }
+    detail::foreach_combinational_output( ntk, [&]( auto const& f ) {
+      readers[ntk.node_to_index( ntk.get_node( f ) )] = no_register;
+    } );
+
+    _instructions.reserve( gates.size() );
+    for ( auto const& n : gates )
+    {
+      const auto index = ntk.node_to_index( n );
+      if ( ntk.fanin_size( n ) > max_lut_size )
+      {
+        throw std::invalid_argument( "compiled_simulation: node " + std::to_string( index ) + " has " + std::to_string( ntk.fanin_size( n ) ) +
+                                     " inputs, at most " + std::to_string( max_lut_size ) + " are supported" );
+      }
+
+      instruction instr;
+      instr.node = index;
+      instr.fanins = static_cast<uint32_t>( _fanins.size() );
+      instr.num_fanins = 0u;
+      ntk.foreach_fanin( n, [&]( auto const& f ) {
+        const auto r = node_register[ntk.node_to_index( ntk.get_node( f ) )];
+        assert( r != no_register );
+        _fanins.push_back( r << 1 | ( ntk.is_complemented( f ) ? 1u : 0u ) );
+        ++instr.num_fanins;
+      } );
+
+      const auto func = ntk.node_function( n );
+      if ( instr.num_fanins == 2u && func._bits[0] == 0x8 )
+      {
+        instr.op = opcode::and2;
+      }
+      else if ( instr.num_fanins == 2u && func._bits[0] == 0x6 )
+      {
+        instr.op = opcode::xor2;
+      }
+      else if ( instr.num_fanins == 3u && func._bits[0] == 0xe8 )
+      {
+        instr.op = opcode::maj3;
+      }
+      else
+      {
+        instr.op = opcode::lut;
+        if ( instr.num_fanins <= 6u )
+        {
+          instr.function = func._bits[0];
+        }
+        else
+        {
+          instr.function = _functions.size();
+          _functions.insert( _functions.end(), func._bits.begin(), func._bits.end() );
+        }
+        _max_lut_inputs = std::max<uint32_t>( _max_lut_inputs, instr.num_fanins );
+      }
+
+      /* release fanin registers read for the last time, the output may reuse them */
+      ntk.foreach_fanin( n, [&]( auto const& f ) {
+        const auto i = ntk.node_to_index( ntk.get_node( f ) );
+        if ( readers[i] != no_register && --readers[i] == 0u && node_register[i] > reg_const1 && !detail::is_combinational_input( ntk, ntk.get_node( f ) ) )
+        {
+          free_registers.push_back( node_register[i] );
+        }
+      } );
+
+      instr.output = allocate();
+      node_register[index] = instr.output;
+      _instructions.push_back( instr );
+
+    }
+
+    detail::foreach_combinational_output( ntk, [&]( auto const& f ) {
+      const auto r = node_register[ntk.node_to_index( ntk.get_node( f ) )];
+      assert( r != no_register );
+      _pos.push_back( r << 1 | ( ntk.is_complemented( f ) ? 1u : 0u ) );
+    } );
+  }
+
+  template<class PiFn, class PoFn, class NodeFn>
+  void run_block( uint32_t thread, uint64_t first, uint32_t count, uint32_t block_words, uint64_t* regs, uint64_t* scratch, uint64_t* output,
+                  PiFn& pi_fn, PoFn& po_fn, NodeFn& node_fn ) const
+  {
+    const auto reg = [&]( uint32_t r ) { return regs + uint64_t( r ) * block_words; };
+
+    std::fill_n( reg( reg_const0 ), count, UINT64_C( 0 ) );
+    std::fill_n( reg( reg_const1 ), count, ~UINT64_C( 0 ) );
+    for ( auto i = 0u; i < _pi_registers.size(); ++i )
+    {
+      pi_fn( i, first, count, reg( _pi_registers[i] ) );
+      node_fn( thread, _pi_nodes[i], first, count, static_cast<uint64_t const*>( reg( _pi_registers[i] ) ) );
+    }
+
+    for ( auto const& instr : _instructions )
+    {
+      uint32_t const* fanins = &_fanins[instr.fanins];
+      uint64_t* out = reg( instr.output );
+
+      switch ( instr.op )
+      {
+      case opcode::and2:
+      {
+        uint64_t const* a = reg( fanins[0] >> 1 );
+        uint64_t const* b = reg( fanins[1] >> 1 );
+        const uint64_t ca = -uint64_t( fanins[0] & 1u ), cb = -uint64_t( fanins[1] & 1u );
+        for ( auto w = 0u; w < count; ++w )
+        {
+          out[w] = ( a[w] ^ ca ) & ( b[w] ^ cb );
+        }
+        break;
+      }
+      case opcode::xor2:
+      {
+        uint64_t const* a = reg( fanins[0] >> 1 );
+        uint64_t const* b = reg( fanins[1] >> 1 );
+        const uint64_t c = -uint64_t( ( fanins[0] ^ fanins[1] ) & 1u );
+        for ( auto w = 0u; w < count; ++w )
+        {
+          out[w] = a[w] ^ b[w] ^ c;
+        }
+        break;
+      }
+      case opcode::maj3:
+      {
+        uint64_t const* a = reg( fanins[0] >> 1 );
+        uint64_t const* b = reg( fanins[1] >> 1 );
+        uint64_t const* c = reg( fanins[2] >> 1 );
+        const uint64_t ca = -uint64_t( fanins[0] & 1u ), cb = -uint64_t( fanins[1] & 1u ), cc = -uint64_t( fanins[2] & 1u );
+        for ( auto w = 0u; w < count; ++w )
+        {
+          const auto x = a[w] ^ ca, y = b[w] ^ cb, z = c[w] ^ cc;
+          out[w] = ( x & y ) | ( x & z ) | ( y & z );
+        }
+        break;
+      }
+      case opcode::lut:
+        run_lut( instr, fanins, count, block_words, regs, scratch, out );
+        break;
+      }
+
+      node_fn( thread, instr.node, first, count, static_cast<uint64_t const*>( out ) );
+    }
+
+    for ( auto o = 0u; o < _pos.size(); ++o )
+    {
+      uint64_t const* v = reg( _pos[o] >> 1 );
+      const uint64_t c = -uint64_t( _pos[o] & 1u );
+      for ( auto w = 0u; w < count; ++w )
+      {
+        output[w] = v[w] ^ c;
+      }
+      po_fn( o, first, count, static_cast<uint64_t const*>( output ) );
+    }
+  }
+
+  /* evaluates a LUT as multiplexer tree over its truth table bits, selecting
+     with the first fanin at the leaves and the last one at the root */
+  void run_lut( instruction const& instr, uint32_t const* fanins, uint32_t count, uint32_t block_words, uint64_t const* regs, uint64_t* scratch, uint64_t* out ) const
+  {
+    const uint32_t k = instr.num_fanins;
+    if ( k == 0u )
+    {
+      std::fill_n( out, count, ( instr.function & 1u ) ? ~UINT64_C( 0 ) : UINT64_C( 0 ) );
+      return;
+    }
+
+    const auto bit = [&]( uint64_t p ) -> uint64_t {
+      return k <= 6u ? ( instr.function >> p ) & 1u : ( _functions[instr.function + ( p >> 6 )] >> ( p & 63u ) ) & 1u;
+    };
+    const auto operand = [&]( uint32_t j ) { return regs + uint64_t( fanins[j] >> 1 ) * block_words; };
+
+    /* leaves: each pair of truth table bits is 0, x_0, ~x_0, or 1 */
+    uint32_t half = 1u << ( k - 1u );
+    {
+      uint64_t const* x = operand( 0u );
+      const uint64_t c = -uint64_t( fanins[0] & 1u );
+      for ( auto q = 0u; q < half; ++q )
+      {
+        const uint64_t m0 = -bit( 2u * q ), m1 = -bit( 2u * q + 1u );
+        uint64_t* s = k == 1u ? out : scratch + uint64_t( q ) * block_words;
+        for ( auto w = 0u; w < count; ++w )
+        {
+          const auto v = x[w] ^ c;
+          s[w] = ( v & m1 ) | ( ~v & m0 );
+        }
+      }
+    }
+
+    for ( auto j = 1u; j < k; ++j )
+    {
+      half >>= 1;
+      uint64_t const* x = operand( j );
+      const uint64_t c = -uint64_t( fanins[j] & 1u );
+      for ( auto q = 0u; q < half; ++q )
+      {
+        uint64_t const* s0 = scratch + uint64_t( 2u * q ) * block_words;
+        uint64_t const* s1 = s0 + block_words;
+        uint64_t* s = j + 1u == k ? out : scratch + uint64_t( q ) * block_words;
+        for ( auto w = 0u; w < count; ++w )
+        {
+          const auto v = x[w] ^ c;
+          s[w] = ( v & s1[w] ) | ( ~v & s0[w] );
+        }
+      }
+    }
+  }
+
+private:
+  uint32_t _num_nodes{0u};
+  uint32_t _num_registers{2u};
+  uint32_t _max_lut_inputs{1u};
+
+  std::vector<uint32_t> _pi_nodes;
+  std::vector<uint32_t> _pi_registers;
+  std::vector<instruction> _instructions;
+  std::vector<uint32_t> _fanins;
+  std::vector<uint64_t> _functions;
+  std::vector<uint32_t> _pos;
+};
+
+} // namespace mockturtle
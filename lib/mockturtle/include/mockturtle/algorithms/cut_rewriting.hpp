@@ -40,6 +40,7 @@
 
 #include "../networks/mig.hpp"
 #include "../traits.hpp"
+#include "../utils/deadline.hpp"
 #include "../utils/node_map.hpp"
 #include "../utils/progress_bar.hpp"
 #include "../utils/stopwatch.hpp"
@@ -84,6 +85,12 @@ struct cut_rewriting_params
     greedy
   } candidate_selection_strategy = minimize_weight;
 
+  /*! \brief Stop looking for replacements once this deadline has passed.
+   *
+   * The replacements found until then are still applied.
+   */
+  deadline time_limit{};
+
   /*! \brief Show progress. */
   bool progress{false};
 
@@ -113,6 +120,9 @@ struct cut_rewriting_stats
   /*! \brief Runtime to find minimal independent set. */
   stopwatch<>::duration time_mis{0};
 
+  /*! \brief The search stopped early at the deadline. */
+  bool timed_out{false};
+
   void report() const
   {
     std::cout << fmt::format( "[i] total time     = {:>5.2f} secs\n", to_seconds( time_total ) );
@@ -393,6 +403,12 @@ public:
   {
     stopwatch t( st.time_total );
 
+    if ( ps.time_limit.expired() )
+    {
+      st.timed_out = true;
+      return;
+    }
+
     /* enumerate cuts */
     const auto cuts = call_with_stopwatch( st.time_cuts, [&]() { return cut_enumeration<Ntk, true, cut_enumeration_cut_rewriting_cut>( ntk, ps.cut_enumeration_ps ); } );
 
@@ -414,6 +430,12 @@ public:
       if ( n >= size )
         return false;
 
+      if ( ps.time_limit.expired() )
+      {
+        st.timed_out = true;
+        return false;
+      }
+
       /* do not iterate over constants or PIs */
       if ( ntk.is_constant( n ) || ntk.is_ci( n ) || ntk.is_ro( n ) )
         return true;
@@ -575,6 +597,12 @@ public:
         continue;
       //return false;
 
+      if ( ps.time_limit.expired() )
+      {
+        st.timed_out = true;
+        break;
+      }
+
       /* do not iterate over constants or PIs */
       if ( ntk.is_constant( n ) || ntk.is_ci( n ) || ntk.is_ro( n ) )
         continue;
@@ -32,9 +32,15 @@
 
 #pragma once
 
+#include <functional>
 #include <iostream>
+#include <limits>
 #include <optional>
+#include <queue>
+#include <utility>
+#include <vector>
 
+#include "../utils/deadline.hpp"
 #include "../views/topo_view.hpp"
 
 namespace mockturtle
@@ -81,6 +87,9 @@ struct mig_algebraic_depth_rewriting_params
 
   /*! \brief Allow area increase while optimizing depth. */
   bool allow_area_increase{true};
+
+  /*! \brief Stop rewriting once this deadline has passed. */
+  deadline time_limit{};
 };
 
 namespace detail
@@ -93,6 +102,22 @@ public:
   mig_algebraic_depth_rewriting_impl( Ntk& ntk, mig_algebraic_depth_rewriting_params const& ps )
       : ntk( ntk ), ps( ps )
   {
+    init_fanout();
+
+    /* levels are only maintained locally if every living gate is reachable from an output */
+    incremental = !has_dangling_gates();
+
+    num_add_events = ntk.events().on_add.size();
+    num_modified_events = ntk.events().on_modified.size();
+
+    ntk.events().on_add.emplace_back( [this]( auto const& n ) { on_add( n ); } );
+    ntk.events().on_modified.emplace_back( [this]( auto const& n, auto const& previous ) { on_modified( n, previous ); } );
+  }
+
+  ~mig_algebraic_depth_rewriting_impl()
+  {
+    ntk.events().on_add.resize( num_add_events );
+    ntk.events().on_modified.resize( num_modified_events );
   }
 
   void run()
@@ -109,6 +134,9 @@ public:
       run_aggressive();
       break;
     }
+
+    /* the depth of the view is only updated on demand while rewriting */
+    ntk.update_depth();
   }
 
 private:
@@ -116,13 +144,16 @@ private:
   {
     ntk.foreach_po( [this]( auto po ) {
       const auto driver = ntk.get_node( po );
-      if ( ntk.level( driver ) < ntk.depth() )
-        return;
+      if ( ntk.level( driver ) < depth() )
+        return true;
       topo_view topo{ntk, po};
       topo.foreach_node( [this]( auto n ) {
+        if ( ps.time_limit.expired() )
+          return false;
         reduce_depth( n );
         return true;
       } );
+      return !ps.time_limit.expired();
     } );
   }
 
@@ -131,24 +162,30 @@ private:
     uint32_t counter{0};
     while ( true )
     {
-      mark_critical_paths();
+      /* building the topological order overrides the node values, so until
+       * the first successful rewrite of a pass every reachable node is a
+       * candidate; afterwards only nodes on critical paths are considered */
+      bool only_critical{false};
 
       topo_view topo{ntk};
-      topo.foreach_node( [this, &counter]( auto n ) {
-        if ( ntk.fanout_size( n ) == 0 || ntk.value( n ) == 0 )
-          return;
+      topo.foreach_node( [this, &counter, &only_critical]( auto n ) {
+        if ( ps.time_limit.expired() )
+          return false;
+        if ( ntk.fanout_size( n ) == 0 || ( only_critical && !is_critical( n ) ) )
+          return true;
 
         if ( reduce_depth( n ) )
         {
-          mark_critical_paths();
+          only_critical = true;
         }
         else
         {
           ++counter;
         }
+        return true;
       } );
 
-      if ( counter > ntk.size() )
+      if ( counter > ntk.size() || ps.time_limit.expired() )
         break;
     }
   }
@@ -160,17 +197,21 @@ private:
     {
       topo_view topo{ntk};
       topo.foreach_node( [this, &counter]( auto n ) {
-          return;
+        if ( ps.time_limit.expired() )
+          return false;
+        if ( ntk.fanout_size( n ) == 0 )
+          return true;
 
         if ( !reduce_depth( n ) )
         {
           ++counter;
         }
+        return true;
       } );
 
       if ( ntk.size() > ps.overhead * init_size )
         break;
-      if ( counter > ntk.size() )
+      if ( counter > ntk.size() || ps.time_limit.expired() )
         break;
     }
   }
@@ -181,7 +222,8 @@ private:
     if ( !ntk.is_maj( n ) )
       return false;
 
-    if ( ntk.level( n ) == 0 )
+    /* dead nodes keep their last level */
+    if ( ntk.level( n ) == 0 || ntk.fanout_size( n ) == 0 )
       return false;
 
     /* get children of top node, ordered by node level (ascending) */
@@ -218,7 +260,7 @@ private:
       const auto& [x, y, z, u, assoc] = *cand;
       auto opt = ntk.create_maj( z, assoc ? u : x, ntk.create_maj( x, y, u ) );
       ntk.substitute_node( n, opt );
-      ntk.update_levels();
+      update_levels();
 
       return true;
     }
@@ -229,7 +271,7 @@ private:
                                ntk.create_maj( ocs[0], ocs[1], ocs2[1] ) );
 
     ntk.substitute_node( n, opt );
-    ntk.update_levels();
+    update_levels();
     return true;
   }
 
@@ -266,35 +308,198 @@ private:
     return children;
   }
 
-  void mark_critical_path( node<Ntk> const& n )
+#pragma region Incremental levels
+  void init_fanout()
   {
-    if ( ntk.is_ci( n ) || ntk.is_constant( n ) || ntk.value( n ) )
-      return;
+    _fanout.resize( ntk.size() );
+    ntk.foreach_gate( [this]( auto const& n ) {
+      ntk.foreach_fanin( n, [this, &n]( auto const& f ) {
+        _fanout[ntk.node_to_index( ntk.get_node( f ) )].push_back( n );
+      } );
+    } );
+  }
 
-    const auto level = ntk.level( n );
-    ntk.set_value( n, 1 );
-    ntk.foreach_fanin( n, [this, level]( auto const& f ) {
-      if ( ntk.level( ntk.get_node( f ) ) == level - 1 )
+  bool has_dangling_gates() const
+  {
+    bool dangling{false};
+    ntk.foreach_gate( [this, &dangling]( auto const& n ) {
+      if ( ntk.fanout_size( n ) == 0 )
       {
-        mark_critical_path( ntk.get_node( f ) );
+        dangling = true;
       }
+      return !dangling;
     } );
+    return dangling;
   }
 
-  void mark_critical_paths()
+  void on_add( node<Ntk> const& n )
   {
-    ntk.clear_values();
-    ntk.foreach_po( [this]( auto const& f ) {
-      if ( ntk.level( ntk.get_node( f ) ) == ntk.depth() )
+    _fanout.resize( ntk.size() );
+    ntk.foreach_fanin( n, [this, &n]( auto const& f ) {
+      _fanout[ntk.node_to_index( ntk.get_node( f ) )].push_back( n );
+    } );
+
+    ntk.resize_levels();
+    ntk.update_level( n );
+    _added.push_back( n );
+  }
+
+  void on_modified( node<Ntk> const& n, std::vector<signal<Ntk>> const& previous )
+  {
+    (void)previous;
+    ntk.foreach_fanin( n, [this, &n]( auto const& f ) {
+      _fanout[ntk.node_to_index( ntk.get_node( f ) )].push_back( n );
+    } );
+    _worklist.emplace( ntk.level( n ), n );
+  }
+
+  /* fanout entries are never removed, only filtered when visited */
+  template<typename Fn>
+  void foreach_parent( node<Ntk> const& n, Fn&& fn ) const
+  {
+    for ( auto const& p : _fanout[ntk.node_to_index( n )] )
+    {
+      if ( ntk.fanout_size( p ) == 0 )
+        continue;
+
+      bool is_parent{false};
+      ntk.foreach_fanin( p, [&]( auto const& f ) {
+        is_parent = is_parent || ntk.get_node( f ) == n;
+      } );
+      if ( is_parent )
+      {
+        fn( p );
+      }
+    }
+  }
+
+  /*! \brief Updates levels after a rewrite.
+   *
+   * Nodes whose fanin changed are processed in order of increasing level,
+   * and their fanout is only revisited if the level actually changed.  A
+   * rewrite that leaves a new node dangling makes the local levels diverge
+   * from `update_levels` (which assigns level 0 to unreachable nodes), so
+   * from then on the global recomputation is used.
+   */
+  void update_levels()
+  {
+    if ( incremental )
+    {
+      for ( auto const& n : _added )
       {
-        mark_critical_path( ntk.get_node( f ) );
+        if ( ntk.fanout_size( n ) == 0 && !ntk.is_dead( n ) )
+        {
+          incremental = false;
+        }
       }
+    }
+    _added.clear();
+
+    if ( incremental )
+    {
+      while ( !_worklist.empty() )
+      {
+        const auto n = _worklist.top().second;
+        _worklist.pop();
+
+        if ( ntk.fanout_size( n ) == 0 )
+          continue;
+
+        const auto previous_level = ntk.level( n );
+        if ( ntk.update_level( n ) == previous_level )
+          continue;
+
+        foreach_parent( n, [this]( auto const& p ) {
+          _worklist.emplace( ntk.level( p ), p );
+        } );
+      }
+    }
+    else
+    {
+      _worklist = {};
+      ntk.update_levels();
+    }
+
+    ++epoch;
+  }
+
+  uint32_t depth()
+  {
+    update_epoch();
+    return ntk.depth();
+  }
+
+  void update_epoch()
+  {
+    if ( output_epoch == epoch )
+      return;
+
+    ntk.update_depth();
+
+    _drives_output.resize( ntk.size() );
+    ntk.foreach_po( [this]( auto const& f ) {
+      _drives_output[ntk.node_to_index( ntk.get_node( f ) )] = epoch + 1;
     } );
+    output_epoch = epoch;
+  }
+#pragma endregion
+
+#pragma region Critical paths
+  /*! \brief Checks whether `n` lies on a critical path.
+   *
+   * A gate is critical if it drives an output of maximum level, or if it is
+   * a fanin of a critical gate whose level is one larger.  The result is
+   * computed on demand through the fanout and cached until the next rewrite.
+   */
+  bool is_critical( node<Ntk> const& n )
+  {
+    if ( ntk.is_ci( n ) || ntk.is_constant( n ) )
+      return false;
+
+    update_epoch();
+
+    const auto index = ntk.node_to_index( n );
+    if ( _critical.size() <= index )
+    {
+      _critical.resize( ntk.size() );
+    }
+    if ( _critical[index].first == epoch + 1 )
+      return _critical[index].second;
+
+    const auto level = ntk.level( n );
+    bool critical = ( _drives_output.size() > index && _drives_output[index] == epoch + 1 && level == ntk.depth() );
+    if ( !critical )
+    {
+      foreach_parent( n, [&]( auto const& p ) {
+        if ( !critical && ntk.level( p ) == level + 1 && is_critical( p ) )
+        {
+          critical = true;
+        }
+      } );
+    }
+
+    _critical[index] = {epoch + 1, critical};
+    return critical;
   }
+#pragma endregion
 
 private:
   Ntk& ntk;
   mig_algebraic_depth_rewriting_params const& ps;
+
+  bool incremental{true};
+  uint32_t epoch{0};
+  uint32_t output_epoch{std::numeric_limits<uint32_t>::max()};
+
+  std::vector<std::vector<node<Ntk>>> _fanout;
+  std::vector<node<Ntk>> _added;
+  std::priority_queue<std::pair<uint32_t, node<Ntk>>, std::vector<std::pair<uint32_t, node<Ntk>>>, std::greater<std::pair<uint32_t, node<Ntk>>>> _worklist;
+
+  std::vector<uint32_t> _drives_output;
+  std::vector<std::pair<uint32_t, bool>> _critical;
+
+  std::size_t num_add_events;
+  std::size_t num_modified_events;
 };
 
 } // namespace detail
@@ -313,7 +518,13 @@ private:
  * - `create_maj`
  * - `substitute_node`
  * - `update_levels`
+ * - `update_level`
+ * - `update_depth`
+ * - `resize_levels`
+ * - `events`
+ * - `is_dead`
  * - `foreach_node`
+ * - `foreach_gate`
  * - `foreach_po`
  * - `foreach_fanin`
  * - `is_maj`
@@ -321,6 +532,11 @@ private:
  * - `set_value`
  * - `value`
  * - `fanout_size`
+ *
+ * Levels are kept up to date locally after every rewrite by propagating
+ * level changes through the fanout in level order, and critical paths for
+ * the `selective` strategy are determined on demand, so that no rewrite
+ * requires a traversal of the whole network.
  *
    \verbatim embed:rst
 
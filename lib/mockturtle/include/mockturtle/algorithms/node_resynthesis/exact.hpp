@@ -0,0 +1,485 @@
+/*!
+  \file exact.hpp
+  \brief Replace with size-optimum networks computed by exact synthesis
+
+  The optimum implementations are kept in an NPN keyed database that is
+  shared by all partitions, filled by a pool of background workers and
+  persisted to a text file between runs.
+
+  Requires percy, hence it is only available when LSORACLE_USE_PERCY is
+  defined.  The SAT based synthesis lives in its own translation unit
+  (core/exact_synthesis.cpp) since the SAT solvers bundled with percy clash
+  with the ABC headers used by the rest of the tool.
+*/
+
+#pragma once
+
+#if defined( LSORACLE_USE_PERCY )
+
+#include <array>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <optional>
+#include <queue>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <fmt/format.h>
+#include <kitty/constructors.hpp>
+#include <kitty/dynamic_truth_table.hpp>
+#include <kitty/npn.hpp>
+#include <kitty/print.hpp>
+
+#include "../../traits.hpp"
+
+namespace mockturtle
+{
+
+struct exact_resynthesis_params
+{
+  /*! \brief Largest cut function that is resynthesized (at most 6). */
+  uint32_t max_inputs{4u};
+
+  /*! \brief Conflict limit of a single SAT call (0 means no limit). */
+  int32_t conflict_limit{0};
+
+  /*! \brief Number of background workers computing missing entries. */
+  uint32_t num_threads{1u};
+
+  /*! \brief Compute missing entries in the caller instead of in the background. */
+  bool blocking{false};
+
+  /*! \brief File the database is loaded from and saved to (empty for none). */
+  std::string database{};
+};
+
+struct exact_resynthesis_stats
+{
+  /*! \brief Cut functions found in the database. */
+  uint32_t hits{0};
+
+  /*! \brief Cut functions missing from the database. */
+  uint32_t misses{0};
+
+  /*! \brief Entries computed by exact synthesis. */
+  uint32_t synthesized{0};
+
+  /*! \brief Entries for which exact synthesis gave up. */
+  uint32_t failed{0};
+
+  /*! \brief Entries in the database. */
+  uint32_t entries{0};
+
+  void report() const
+  {
+    std::cout << fmt::format( "[i] database entries = {:>8}\n", entries );
+    std::cout << fmt::format( "[i] hits             = {:>8}\n", hits );
+    std::cout << fmt::format( "[i] misses           = {:>8}\n", misses );
+    std::cout << fmt::format( "[i] synthesized      = {:>8}\n", synthesized );
+    std::cout << fmt::format( "[i] failed           = {:>8}\n", failed );
+  }
+};
+
+/*! \brief Size-optimum two-input chain of an NPN class representative.
+ *
+ * Step fanins below `num_inputs` refer to the inputs, larger ones to earlier
+ * steps.  The operator is the 4-bit truth table of the step over its two
+ * fanins.  The output is a literal in the percy convention: 0 is the
+ * constant, 1 to `num_inputs` are the inputs and larger values are steps,
+ * the least significant bit complements it.
+ */
+struct exact_chain
+{
+  uint32_t num_inputs{0u};
+  std::vector<std::array<uint32_t, 3>> steps;
+  uint32_t output{0u};
+};
+
+namespace detail
+{
+
+/*! \brief Computes the size-optimum chain of `tt` with percy.
+ *
+ * Returns no chain when the conflict limit is hit.
+ */
+std::optional<exact_chain> percy_synthesize( kitty::dynamic_truth_table const& tt, int32_t conflict_limit );
+
+} /* namespace detail */
+
+/*! \brief NPN keyed database of size-optimum chains.
+ *
+ * Lookups never block on synthesis.  Missing representatives are queued and
+ * computed with percy by `num_threads` workers, so a later pass (or a later
+ * run, when the database is persisted) can use them.  The database is saved
+ * on destruction when a file name is given.
+ */
+class exact_database
+{
+public:
+  explicit exact_database( exact_resynthesis_params const& ps = {} )
+      : ps( ps )
+  {
+    if ( !ps.database.empty() )
+    {
+      load( ps.database );
+    }
+
+    if ( !ps.blocking )
+    {
+      for ( auto i = 0u; i < ps.num_threads; ++i )
+      {
+        _workers.emplace_back( [this]() { work(); } );
+      }
+    }
+  }
+
+  ~exact_database()
+  {
+    {
+      std::lock_guard<std::mutex> lock( _mutex );
+      _stop = true;
+    }
+    _cv.notify_all();
+    for ( auto& w : _workers )
+    {
+      w.join();
+    }
+
+    if ( !ps.database.empty() )
+    {
+      save( ps.database );
+    }
+  }
+
+  exact_database( exact_database const& ) = delete;
+  exact_database& operator=( exact_database const& ) = delete;
+
+  exact_resynthesis_params const& params() const
+  {
+    return ps;
+  }
+
+  /*! \brief Returns the chain of an NPN representative if it is known. */
+  std::optional<exact_chain> lookup( kitty::dynamic_truth_table const& repr )
+  {
+    std::lock_guard<std::mutex> lock( _mutex );
+    if ( const auto it = _chains.find( key( repr ) ); it != _chains.end() )
+    {
+      ++_st.hits;
+      return it->second;
+    }
+    ++_st.misses;
+    return std::nullopt;
+  }
+
+  /*! \brief Queues an NPN representative for the background workers. */
+  void request( kitty::dynamic_truth_table const& repr )
+  {
+    {
+      std::lock_guard<std::mutex> lock( _mutex );
+      const auto k = key( repr );
+      if ( _chains.count( k ) || _failed.count( k ) || !_pending.insert( k ).second )
+      {
+        return;
+      }
+      _queue.push( repr );
+    }
+    _cv.notify_one();
+  }
+
+  /*! \brief Computes an NPN representative in the calling thread.
+   *
+   * Returns its chain if it is known afterwards, without counting a hit.
+   */
+  std::optional<exact_chain> synthesize( kitty::dynamic_truth_table const& repr )
+  {
+    {
+      std::lock_guard<std::mutex> lock( _mutex );
+      const auto k = key( repr );
+      if ( const auto it = _chains.find( k ); it != _chains.end() )
+      {
+        return it->second;
+      }
+      if ( _failed.count( k ) || _pending.count( k ) )
+      {
+        return std::nullopt;
+      }
+    }
+
+    const auto chain = detail::percy_synthesize( repr, ps.conflict_limit );
+    insert( repr, chain );
+    return chain;
+  }
+
+  /*! \brief Waits until all queued representatives have been computed. */
+  void wait()
+  {
+    std::unique_lock<std::mutex> lock( _mutex );
+    _idle.wait( lock, [this]() { return _pending.empty() || _workers.empty(); } );
+  }
+
+  exact_resynthesis_stats stats() const
+  {
+    std::lock_guard<std::mutex> lock( _mutex );
+    auto st = _st;
+    st.entries = static_cast<uint32_t>( _chains.size() );
+    return st;
+  }
+
+  /*! \brief Writes all known chains, one NPN class per line. */
+  void save( std::string const& filename ) const
+  {
+    std::ofstream os( filename );
+    if ( !os )
+    {
+      std::cerr << "[e] could not write exact synthesis database " << filename << "\n";
+      return;
+    }
+
+    std::lock_guard<std::mutex> lock( _mutex );
+    for ( auto const& [k, c] : _chains )
+    {
+      os << k << " " << c.steps.size();
+      for ( auto const& s : c.steps )
+      {
+        os << " " << s[0] << " " << s[1] << " " << s[2];
+      }
+      os << " " << c.output << "\n";
+    }
+  }
+
+  /*! \brief Reads chains written by `save`, a missing file is not an error. */
+  void load( std::string const& filename )
+  {
+    std::ifstream is( filename );
+    if ( !is )
+    {
+      return;
+    }
+
+    std::lock_guard<std::mutex> lock( _mutex );
+    std::string line;
+    while ( std::getline( is, line ) )
+    {
+      std::istringstream ls( line );
+      std::string k;
+      uint32_t num_steps{0u};
+      if ( !( ls >> k >> num_steps ) )
+      {
+        continue;
+      }
+
+      exact_chain c;
+      c.num_inputs = std::stoul( k.substr( 0, k.find( ':' ) ) );
+      c.steps.resize( num_steps );
+      for ( auto& s : c.steps )
+      {
+        ls >> s[0] >> s[1] >> s[2];
+      }
+      if ( !( ls >> c.output ) )
+      {
+        std::cerr << "[w] skipping malformed exact synthesis entry " << k << "\n";
+        continue;
+      }
+      _chains[k] = c;
+    }
+  }
+
+private:
+  static std::string key( kitty::dynamic_truth_table const& tt )
+  {
+    return fmt::format( "{}:{}", tt.num_vars(), kitty::to_hex( tt ) );
+  }
+
+  void insert( kitty::dynamic_truth_table const& repr, std::optional<exact_chain> const& chain )
+  {
+    {
+      std::lock_guard<std::mutex> lock( _mutex );
+      const auto k = key( repr );
+      _pending.erase( k );
+      if ( chain )
+      {
+        _chains[k] = *chain;
+        ++_st.synthesized;
+      }
+      else
+      {
+        _failed.insert( k );
+        ++_st.failed;
+      }
+    }
+    _idle.notify_all();
+  }
+
+  void work()
+  {
+    while ( true )
+    {
+      kitty::dynamic_truth_table repr;
+      {
+        std::unique_lock<std::mutex> lock( _mutex );
+        _cv.wait( lock, [this]() { return _stop || !_queue.empty(); } );
+        if ( _stop )
+        {
+          return;
+        }
+        repr = _queue.front();
+        _queue.pop();
+      }
+      insert( repr, detail::percy_synthesize( repr, ps.conflict_limit ) );
+    }
+  }
+
+private:
+  exact_resynthesis_params ps;
+  exact_resynthesis_stats _st;
+
+  std::unordered_map<std::string, exact_chain> _chains;
+  std::unordered_set<std::string> _failed;
+  std::unordered_set<std::string> _pending;
+  std::queue<kitty::dynamic_truth_table> _queue;
+
+  mutable std::mutex _mutex;
+  std::condition_variable _cv;
+  std::condition_variable _idle;
+  bool _stop{false};
+  std::vector<std::thread> _workers;
+};
+
+/*! \brief Resynthesis function based on exact synthesis.
+ *
+ * This resynthesis function can be passed to ``cut_rewriting``.  Cut
+ * functions with at most ``max_inputs`` variables are NPN canonized and
+ * replaced by the size-optimum chain of their representative.  Chains are
+ * built from AND and XOR gates, so XORs cost three nodes in an AIG and MIG.
+ * A function whose representative is not in the database yet yields no
+ * candidate; it is queued (or computed right away when ``blocking`` is set)
+ * and is available to the next pass.
+ *
+   \verbatim embed:rst
+   Example
+   .. code-block:: c++
+      exact_resynthesis_params ps;
+      ps.database = "exact.db";
+      exact_database db( ps );
+      exact_resynthesis<aig_network> resyn( db );
+      cut_rewriting( aig, resyn );
+   \endverbatim
+ */
+template<class Ntk>
+class exact_resynthesis
+{
+public:
+  explicit exact_resynthesis( exact_database& db )
+      : _db( db )
+  {
+    static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
+    static_assert( has_get_constant_v<Ntk>, "Ntk does not implement the get_constant method" );
+    static_assert( has_create_and_v<Ntk>, "Ntk does not implement the create_and method" );
+    static_assert( has_create_xor_v<Ntk>, "Ntk does not implement the create_xor method" );
+    static_assert( has_create_not_v<Ntk>, "Ntk does not implement the create_not method" );
+  }
+
+  template<typename LeavesIterator, typename Fn>
+  void operator()( Ntk& ntk, kitty::dynamic_truth_table const& function, LeavesIterator begin, LeavesIterator end, Fn&& fn )
+  {
+    const auto num_vars = function.num_vars();
+    if ( num_vars > _db.params().max_inputs || num_vars > 6u )
+    {
+      return;
+    }
+
+    const auto config = kitty::exact_npn_canonization( function );
+    const auto& repr = std::get<0>( config );
+
+    auto chain = _db.lookup( repr );
+    if ( !chain && _db.params().blocking )
+    {
+      chain = _db.synthesize( repr );
+    }
+    if ( !chain )
+    {
+      _db.request( repr );
+      return;
+    }
+
+    std::vector<signal<Ntk>> pis( num_vars, ntk.get_constant( false ) );
+    std::copy( begin, end, pis.begin() );
+
+    std::vector<signal<Ntk>> signals;
+    const auto& perm = std::get<2>( config );
+    const auto& phase = std::get<1>( config );
+    for ( auto i = 0u; i < num_vars; ++i )
+    {
+      signals.push_back( ( ( phase >> perm[i] ) & 1 ) ? ntk.create_not( pis[perm[i]] ) : pis[perm[i]] );
+    }
+
+    for ( auto const& s : chain->steps )
+    {
+      signals.push_back( create_step( ntk, signals[s[0]], signals[s[1]], s[2] ) );
+    }
+
+    const auto var = chain->output >> 1;
+    auto f = var == 0u ? ntk.get_constant( false ) : signals[var - 1];
+    if ( ( chain->output & 1 ) != ( ( phase >> num_vars ) & 1 ) )
+    {
+      f = ntk.create_not( f );
+    }
+    fn( f );
+  }
+
+private:
+  /* the operator is indexed by a + 2b */
+  signal<Ntk> create_step( Ntk& ntk, signal<Ntk> const& a, signal<Ntk> const& b, uint32_t op ) const
+  {
+    const bool complement = op & 1;
+    if ( complement )
+    {
+      op = ~op & 0xf;
+    }
+
+    signal<Ntk> f;
+    switch ( op )
+    {
+    case 0x2:
+      f = ntk.create_and( a, ntk.create_not( b ) );
+      break;
+    case 0x4:
+      f = ntk.create_and( ntk.create_not( a ), b );
+      break;
+    case 0x6:
+      f = ntk.create_xor( a, b );
+      break;
+    case 0x8:
+      f = ntk.create_and( a, b );
+      break;
+    case 0xa:
+      f = a;
+      break;
+    case 0xc:
+      f = b;
+      break;
+    case 0xe:
+      f = ntk.create_not( ntk.create_and( ntk.create_not( a ), ntk.create_not( b ) ) );
+      break;
+    default:
+      f = ntk.get_constant( false );
+      break;
+    }
+    return complement ? ntk.create_not( f ) : f;
+  }
+
+private:
+  exact_database& _db;
+};
+
+} /* namespace mockturtle */
+
+#endif
@@ -1,79 +1,535 @@
-/*
- * This class implements the invariant sequential rewriting presented in Sequential Rewriting and Synthesis by R. Brayton and A. Mischenko.
- * Code based in cut rewriting from EPFL logic synthesis libraries.
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
  */
 
-namespace mockturtle {
+/*!
+  \file seq_rewriting.hpp
+  \brief Sequential rewriting with register sweeping and forward retiming
 
-/*! \brief Parameters for cut_rewriting.
- *
- * The data structure `cut_rewriting_params` holds configurable parameters with
- * default arguments for `cut_rewriting`.
- */
+  Follows the register-based transformations of "Sequential Rewriting and
+  Synthesis" by R. Brayton and A. Mishchenko: combinational rewriting
+  between the registers alternates with transformations that move or remove
+  registers while keeping the behavior from the reset state.
+*/
+
+#pragma once
 
-struct cut_rewriting_params
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include <kitty/dynamic_truth_table.hpp>
+#include <kitty/operations.hpp>
+
+#include "../traits.hpp"
+#include "../utils/stopwatch.hpp"
+#include "../views/topo_view.hpp"
+#include "cleanup.hpp"
+#include "cut_rewriting.hpp"
+
+#include <fmt/format.h>
+
+namespace mockturtle
 {
-  cut_rewriting_params()
-  {
-    cut_enumeration_ps.cut_size = 4;
-    cut_enumeration_ps.cut_limit = 12;
-    cut_enumeration_ps.minimize_truth_table = true;
-  }
 
-  /*! \brief Cut enumeration parameters. */
-  cut_enumeration_params cut_enumeration_ps{};
+/*! \brief Parameters for seq_rewriting.
+ *
+ * The data structure `seq_rewriting_params` holds configurable parameters
+ * with default arguments for `seq_rewriting`.
+ */
+struct seq_rewriting_params
+{
+  /*! \brief Parameters of the combinational rewriting between the registers. */
+  cut_rewriting_params cut_rewriting_ps{};
 
-  /*! \brief Allow zero-gain substitutions. */
-  bool allow_zero_gain{false};
+  /*! \brief Rewrite the combinational logic. */
+  bool rewrite{true};
 
-  /*! \brief Use don't cares for optimization. */
-  bool use_dont_cares{false};
+  /*! \brief Merge registers with the same input and reset value, and remove constant ones. */
+  bool merge_registers{true};
 
-  /*! \brief Candidate selection strategy. */
-  enum
-  {
-    minimize_weight,
-    greedy
-  } candidate_selection_strategy = minimize_weight;
+  /*! \brief Move registers forward over gates that only read register outputs. */
+  bool retime_forward{true};
 
-  /*! \brief Show progress. */
-  bool progress{false};
+  /*! \brief Maximum number of rounds of rewriting and register transformations. */
+  uint32_t max_rounds{4u};
 
   /*! \brief Be verbose. */
   bool verbose{false};
-
-  /*! \brief Be very verbose. */
-  bool very_verbose{false};
 };
 
-/*! \brief Statistics for cut_rewriting.
+/*! \brief Statistics for seq_rewriting.
  *
- * The data structure `cut_rewriting_stats` provides data collected by running
- * `cut_rewriting`.
+ * The data structure `seq_rewriting_stats` provides data collected by running
+ * `seq_rewriting`.
  */
-struct cut_rewriting_stats
+struct seq_rewriting_stats
 {
   /*! \brief Total runtime. */
   stopwatch<>::duration time_total{0};
 
-  /*! \brief Runtime for cut enumeration. */
-  stopwatch<>::duration time_cuts{0};
+  /*! \brief Runtime of the register transformations. */
+  stopwatch<>::duration time_registers{0};
+
+  /*! \brief Number of rounds. */
+  uint32_t rounds{0};
+
+  /*! \brief Registers and gates before and after. */
+  uint32_t registers_before{0}, registers_after{0}, gates_before{0}, gates_after{0};
+
+  /*! \brief Registers outside the transitive fanin of the primary outputs. */
+  uint32_t dangling{0};
+
+  /*! \brief Registers that always hold their reset value. */
+  uint32_t constant{0};
+
+  /*! \brief Registers merged into an equivalent one. */
+  uint32_t merged{0};
 
-  /*! \brief Accumulated runtime for rewriting. */
-  stopwatch<>::duration time_rewriting{0};
+  /*! \brief Gates moved behind their registers. */
+  uint32_t retimed{0};
 
-  /*! \brief Runtime to find minimal independent set. */
-  stopwatch<>::duration time_mis{0};
+  /*! \brief Statistics of the last combinational rewriting. */
+  cut_rewriting_stats cut_rewriting_st{};
 
   void report() const
   {
+    std::cout << fmt::format( "[i] registers      = {:>8} -> {:>8}\n", registers_before, registers_after );
+    std::cout << fmt::format( "[i] gates          = {:>8} -> {:>8}\n", gates_before, gates_after );
+    std::cout << fmt::format( "[i] rounds         = {:>8}\n", rounds );
+    std::cout << fmt::format( "[i] dangling       = {:>8}\n", dangling );
+    std::cout << fmt::format( "[i] constant       = {:>8}\n", constant );
+    std::cout << fmt::format( "[i] merged         = {:>8}\n", merged );
+    std::cout << fmt::format( "[i] retimed gates  = {:>8}\n", retimed );
+    std::cout << fmt::format( "[i] register time  = {:>5.2f} secs\n", to_seconds( time_registers ) );
     std::cout << fmt::format( "[i] total time     = {:>5.2f} secs\n", to_seconds( time_total ) );
-    std::cout << fmt::format( "[i] cut enum. time = {:>5.2f} secs\n", to_seconds( time_cuts ) );
-    std::cout << fmt::format( "[i] rewriting time = {:>5.2f} secs\n", to_seconds( time_rewriting ) );
-    std::cout << fmt::format( "[i] ind. set time  = {:>5.2f} secs\n", to_seconds( time_mis ) );
   }
 };
 
+namespace detail
+{
+
+template<class Ntk>
+class register_sweep_impl
+{
+public:
+  using node = typename Ntk::node;
+  using signal = typename Ntk::signal;
+
+  register_sweep_impl( Ntk const& ntk, seq_rewriting_params const& ps, seq_rewriting_stats& st )
+      : ntk( ntk ), ps( ps ), st( st )
+  {
+  }
+
+  Ntk run()
+  {
+    ntk.foreach_ci( [&]( auto const& n ) {
+      cis.push_back( n );
+    } );
+    ntk.foreach_co( [&]( auto const& f ) {
+      cos.push_back( f );
+    } );
+    num_regs = ntk.num_latches();
+    num_pis = static_cast<uint32_t>( cis.size() ) - num_regs;
+    num_pos = static_cast<uint32_t>( cos.size() ) - num_regs;
+
+    reg_of.assign( ntk.size(), none );
+    for ( auto i = 0u; i < num_regs; ++i )
+    {
+      reg_of[ntk.node_to_index( ro( i ) )] = i;
+    }
+    fates.assign( num_regs, fate::keep );
+    values.assign( num_regs, 0u );
+    is_representative.assign( num_regs, 0u );
+
+    mark_dangling();
+    if ( ps.merge_registers )
+    {
+      merge_registers();
+    }
+    order = combinational_topo_order( ntk );
+    if ( ps.retime_forward )
+    {
+      find_retimable_gates();
+    }
+    return build();
+  }
+
+private:
+  enum class fate : uint8_t
+  {
+    keep,
+    dangling,
+    constant,
+    merged,
+    consumed
+  };
+
+  node ro( uint32_t i ) const { return cis[num_pis + i]; }
+  signal ri( uint32_t i ) const { return cos[num_pos + i]; }
+
+  /* the reset value is 0 or 1, other values (unknown, don't care) are not used */
+  bool has_binary_reset( uint32_t i ) const { return ntk.latch_reset( i ) == 0 || ntk.latch_reset( i ) == 1; }
+
+  /* registers whose outputs do not reach a primary output, also through other registers */
+  void mark_dangling()
+  {
+    std::vector<uint8_t> seen( ntk.size(), 0u ), needed( num_regs, 0u );
+    std::vector<node> stack;
+    const auto push = [&]( signal const& f ) {
+      const auto n = ntk.get_node( f );
+      if ( !seen[ntk.node_to_index( n )] )
+      {
+        seen[ntk.node_to_index( n )] = 1u;
+        stack.push_back( n );
+      }
+    };
+
+    for ( auto i = 0u; i < num_pos; ++i )
+    {
+      push( cos[i] );
+    }
+    while ( !stack.empty() )
+    {
+      const auto n = stack.back();
+      stack.pop_back();
+      if ( ntk.is_constant( n ) )
+        continue;
+      if ( ntk.is_ci( n ) )
+      {
+        if ( const auto r = reg_of[ntk.node_to_index( n )]; r != none && !needed[r] )
+        {
+          needed[r] = 1u;
+          push( ri( r ) );
+        }
+        continue;
+      }
+      ntk.foreach_fanin( n, [&]( auto const& f ) {
+        push( f );
+      } );
+    }
+
+    for ( auto i = 0u; i < num_regs; ++i )
+    {
+      if ( !needed[i] )
+      {
+        fates[i] = fate::dangling;
+        ++st.dangling;
+      }
+    }
+  }
+
+  void merge_registers()
+  {
+    std::map<std::pair<uint64_t, int8_t>, uint32_t> representative;
+    for ( auto i = 0u; i < num_regs; ++i )
+    {
+      if ( fates[i] != fate::keep || !has_binary_reset( i ) )
+        continue;
 
+      const auto f = ri( i );
+      const bool reset = ntk.latch_reset( i ) == 1;
+
+      /* a constant input, or the register feeding itself, keeps the reset value forever */
+      const bool is_const = ntk.is_constant( ntk.get_node( f ) ) && ( ntk.constant_value( ntk.get_node( f ) ) ^ ntk.is_complemented( f ) ) == reset;
+      const bool is_loop = ntk.get_node( f ) == ro( i ) && !ntk.is_complemented( f );
+      if ( is_const || is_loop )
+      {
+        fates[i] = fate::constant;
+        values[i] = reset;
+        ++st.constant;
+        continue;
+      }
+
+      const auto key = std::make_pair( uint64_t( ntk.node_to_index( ntk.get_node( f ) ) ) << 1 | ( ntk.is_complemented( f ) ? 1u : 0u ), ntk.latch_reset( i ) );
+      if ( const auto it = representative.find( key ); it != representative.end() )
+      {
+        fates[i] = fate::merged;
+        values[i] = it->second;
+        is_representative[it->second] = 1u;
+        ++st.merged;
+      }
+      else
+      {
+        representative.emplace( key, i );
+      }
+    }
+  }
+
+  /* a gate is retimed if all its fanins are constants or outputs of registers that only feed this gate */
+  void find_retimable_gates()
+  {
+    retimed.assign( ntk.size(), 0u );
+    std::vector<uint32_t> regs;
+    for ( auto const& n : order )
+    {
+      regs.clear();
+      bool ok = true;
+      ntk.foreach_fanin( n, [&]( auto const& f ) {
+        const auto g = ntk.get_node( f );
+        if ( ntk.is_constant( g ) )
+          return true;
+        const auto r = reg_of[ntk.node_to_index( g )];
+        if ( r == none || fates[r] != fate::keep || is_representative[r] || !has_binary_reset( r ) || ntk.fanout_size( g ) != 1u )
+        {
+          ok = false;
+          return false;
+        }
+        regs.push_back( r );
+        return true;
+      } );
+      if ( !ok || regs.empty() )
+        continue;
+
+      for ( auto r : regs )
+      {
+        fates[r] = fate::consumed;
+      }
+      retimed[ntk.node_to_index( n )] = 1u;
+      retimed_gates.push_back( n );
+      ++st.retimed;
+    }
+  }
+
+  /* value of gate n in the reset state */
+  bool reset_value( node const& n ) const
+  {
+    const auto tt = ntk.node_function( n );
+    uint64_t index{0u};
+    ntk.foreach_fanin( n, [&]( auto const& f, auto i ) {
+      const auto g = ntk.get_node( f );
+      const bool value = ntk.is_constant( g ) ? ntk.constant_value( g ) : ntk.latch_reset( reg_of[ntk.node_to_index( g )] ) == 1;
+      if ( value ^ ntk.is_complemented( f ) )
+      {
+        index |= uint64_t( 1u ) << i;
+      }
+    } );
+    return kitty::get_bit( tt, index );
+  }
+
+  Ntk build()
+  {
+    Ntk dest;
+    std::vector<signal> old_to_new( ntk.size(), dest.get_constant( false ) );
+    const auto map = [&]( signal const& f ) {
+      const auto s = old_to_new[ntk.node_to_index( ntk.get_node( f ) )];
+      return ntk.is_complemented( f ) ? dest.create_not( s ) : s;
+    };
+    old_to_new[ntk.node_to_index( ntk.get_node( ntk.get_constant( false ) ) )] = dest.get_constant( false );
+
+    for ( auto i = 0u; i < num_pis; ++i )
+    {
+      old_to_new[ntk.node_to_index( cis[i] )] = dest.create_pi();
+    }
+    for ( auto i = 0u; i < num_regs; ++i )
+    {
+      if ( fates[i] == fate::keep )
+      {
+        old_to_new[ntk.node_to_index( ro( i ) )] = dest.create_ro();
+      }
+    }
+    for ( auto const& n : retimed_gates )
+    {
+      old_to_new[ntk.node_to_index( n )] = dest.create_ro();
+    }
+    for ( auto i = 0u; i < num_regs; ++i )
+    {
+      auto& s = old_to_new[ntk.node_to_index( ro( i ) )];
+      switch ( fates[i] )
+      {
+      case fate::dangling:
+        /* only read by logic that does not reach a primary output */
+        s = dest.get_constant( ntk.latch_reset( i ) == 1 );
+        break;
+      case fate::constant:
+        s = dest.get_constant( values[i] != 0u );
+        break;
+      case fate::merged:
+        s = old_to_new[ntk.node_to_index( ro( values[i] ) )];
+        break;
+      default:
+        break;
+      }
+    }
+
+    std::vector<signal> children;
+    for ( auto const& n : order )
+    {
+      if ( !retimed.empty() && retimed[ntk.node_to_index( n )] )
+        continue;
+      children.clear();
+      ntk.foreach_fanin( n, [&]( auto const& f ) {
+        children.push_back( map( f ) );
+      } );
+      old_to_new[ntk.node_to_index( n )] = dest.clone_node( ntk, n, children );
+    }
+
+    for ( auto i = 0u; i < num_pos; ++i )
+    {
+      dest.create_po( map( cos[i] ) );
+    }
+    for ( auto i = 0u; i < num_regs; ++i )
+    {
+      if ( fates[i] == fate::keep )
+      {
+        dest.create_ri( map( ri( i ) ), ntk.latch_reset( i ) );
+      }
+    }
+    /* a retimed gate reads the inputs of the registers it was moved over */
+    for ( auto const& n : retimed_gates )
+    {
+      children.clear();
+      ntk.foreach_fanin( n, [&]( auto const& f ) {
+        const auto g = ntk.get_node( f );
+        if ( ntk.is_constant( g ) )
+        {
+          children.push_back( map( f ) );
+        }
+        else
+        {
+          const auto s = map( ri( reg_of[ntk.node_to_index( g )] ) );
+          children.push_back( ntk.is_complemented( f ) ? dest.create_not( s ) : s );
+        }
+      } );
+      dest.create_ri( dest.clone_node( ntk, n, children ), reset_value( n ) ? 1 : 0 );
+    }
+
+    return cleanup_dangling( dest );
+  }
+
+private:
+  static constexpr uint32_t none = std::numeric_limits<uint32_t>::max();
+
+  Ntk const& ntk;
+  seq_rewriting_params const& ps;
+  seq_rewriting_stats& st;
+
+  std::vector<node> cis;
+  std::vector<signal> cos;
+  uint32_t num_regs{0}, num_pis{0}, num_pos{0};
+  std::vector<uint32_t> reg_of;
+  std::vector<fate> fates;
+  /* constant value or representative, depending on the fate */
+  std::vector<uint32_t> values;
+  std::vector<uint8_t> is_representative;
+  std::vector<node> order;
+  std::vector<uint8_t> retimed;
+  std::vector<node> retimed_gates;
+};
+
+} // namespace detail
+
+/*! \brief Sequential rewriting.
+ *
+ * Alternates combinational rewriting with register transformations until
+ * the number of registers stops changing or `ps.max_rounds` rounds are done.
+ * The rewriting is `cut_rewriting` with register outputs as inputs and
+ * register inputs as outputs, so every cut stops at a register.  The
+ * register transformations rebuild the network and
+ *
+ * - remove registers that do not reach a primary output,
+ * - replace registers that keep their reset value by constants,
+ * - merge registers with the same input and reset value, and
+ * - retime forward: a gate whose fanins are constants and outputs of
+ *   registers that feed nothing else is moved behind a single new register,
+ *   whose reset value is the value of the gate in the reset state.
+ *
+ * All transformations keep the outputs equal for every input sequence that
+ * starts in the reset state.  Registers with a reset value other than 0 or 1
+ * are only removed when they are dangling.
+ *
+ * **Required network functions:**
+ * - all functions required by `cut_rewriting` and `cleanup_dangling`
+ * - `foreach_ci`
+ * - `foreach_co`
+ * - `num_latches`
+ * - `latch_reset`
+ * - `fanout_size`
+ * - `node_function`
+ * - `constant_value`
+ *
+ * \param ntk Network
+ * \param rewriting_fn Rewriting function
+ * \param ps Rewriting params
+ * \param pst Rewriting statistics
+ * \param cost_fn Node cost function (a functor with signature `uint32_t(Ntk const&, node<Ntk> const&)`)
+ * \return The optimized network
+ */
+template<class Ntk, class RewritingFn, class NodeCostFn = detail::unit_cost<Ntk>>
+Ntk seq_rewriting( Ntk const& ntk, RewritingFn&& rewriting_fn, seq_rewriting_params const& ps = {}, seq_rewriting_stats* pst = nullptr, NodeCostFn const& cost_fn = {} )
+{
+  static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
+  static_assert( has_foreach_ci_v<Ntk>, "Ntk does not implement the foreach_ci method" );
+  static_assert( has_foreach_co_v<Ntk>, "Ntk does not implement the foreach_co method" );
+  static_assert( has_num_latches_v<Ntk>, "Ntk does not implement the num_latches method" );
+  static_assert( has_fanout_size_v<Ntk>, "Ntk does not implement the fanout_size method" );
+  static_assert( has_node_function_v<Ntk>, "Ntk does not implement the node_function method" );
+
+  seq_rewriting_stats st;
+  auto res = cleanup_dangling( ntk );
+  {
+    stopwatch t( st.time_total );
+
+    st.registers_before = res.num_latches();
+    st.gates_before = res.num_gates();
+
+    for ( auto round = 0u; round < ps.max_rounds; ++round )
+    {
+      ++st.rounds;
+      if ( ps.rewrite )
+      {
+        cut_rewriting( res, rewriting_fn, ps.cut_rewriting_ps, &st.cut_rewriting_st, cost_fn );
+        res = cleanup_dangling( res );
+      }
+
+      const auto registers = res.num_latches();
+      {
+        stopwatch t_regs( st.time_registers );
+        res = detail::register_sweep_impl<Ntk>( res, ps, st ).run();
+      }
+      if ( res.num_latches() == registers )
+        break;
+    }
+
+    st.registers_after = res.num_latches();
+    st.gates_after = res.num_gates();
+  }
+
+  if ( ps.verbose )
+  {
+    st.report();
+  }
+
+  if ( pst )
+  {
+    *pst = st;
+  }
+  return res;
+}
 
-}
\ No newline at end of file
+} /* namespace mockturtle */
@@ -0,0 +1,230 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file switching_activity.hpp
+  \brief Signal probabilities and toggle rates by bit-parallel simulation
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+#include "../traits.hpp"
+#include "compiled_simulation.hpp"
+
+namespace mockturtle
+{
+
+/*! \brief Parameters for switching_activity. */
+struct switching_activity_params
+{
+  /*! \brief Number of random patterns. */
+  uint64_t num_patterns{1u << 14};
+
+  /*! \brief Seed of the random patterns. */
+  uint64_t seed{1u};
+
+  /*! \brief Parameters of the simulation (threads, block size). */
+  compiled_simulation_params simulation_ps{};
+};
+
+/*! \brief Result of switching_activity.
+ *
+ * The vectors are indexed by node index.  Nodes that are not simulated,
+ * i.e., nodes outside the transitive fanin of the outputs, have probability
+ * and toggle rate 0.  Register outputs are treated as inputs, see
+ * `compiled_simulation`.
+ */
+struct switching_activity_result
+{
+  /*! \brief Fraction of patterns for which a node is 1. */
+  std::vector<double> probability;
+
+  /*! \brief Fraction of consecutive pattern pairs for which a node changes. */
+  std::vector<double> toggle_rate;
+
+  /*! \brief Sum of toggle rate times fanout size over all inputs and gates.
+   *
+   * This is the switched capacitance in units of one fanin pin, dynamic
+   * power is proportional to it.
+   */
+  double activity{0.0};
+
+  /*! \brief Sum of toggle rates over all simulated gates. */
+  double gate_toggles{0.0};
+
+  /*! \brief Sum of signal probabilities over all simulated gates. */
+  double gate_probability{0.0};
+
+  /*! \brief Number of simulated gates, i.e., gates in the transitive fanin of the outputs. */
+  uint32_t num_gates{0u};
+};
+
+namespace detail
+{
+
+inline uint64_t splitmix64( uint64_t x )
+{
+  x += UINT64_C( 0x9e3779b97f4a7c15 );
+  x = ( x ^ ( x >> 30 ) ) * UINT64_C( 0xbf58476d1ce4e5b9 );
+  x = ( x ^ ( x >> 27 ) ) * UINT64_C( 0x94d049bb133111eb );
+  return x ^ ( x >> 31 );
+}
+
+template<class Ntk, class PiFn>
+switching_activity_result switching_activity( Ntk const& ntk, compiled_simulation const& sim, uint64_t num_patterns, PiFn&& pi_fn, compiled_simulation_params const& ps )
+{
+  static_assert( has_foreach_node_v<Ntk>, "Ntk does not implement the foreach_node method" );
+  static_assert( has_fanout_size_v<Ntk>, "Ntk does not implement the fanout_size method" );
+
+  const uint64_t num_words = ( num_patterns + 63u ) / 64u;
+  /* valid patterns of the last word */
+  const uint64_t last_mask = num_patterns % 64u == 0u ? ~UINT64_C( 0 ) : ( UINT64_C( 1 ) << ( num_patterns % 64u ) ) - 1u;
+
+  const auto threads = std::min<uint64_t>( compiled_simulation::num_threads( ps ), std::max<uint64_t>( num_words, 1u ) );
+  std::vector<std::vector<uint64_t>> ones( threads, std::vector<uint64_t>( sim.num_nodes(), 0u ) );
+  std::vector<std::vector<uint64_t>> toggles( threads, std::vector<uint64_t>( sim.num_nodes(), 0u ) );
+
+  sim.run(
+      num_words, pi_fn,
+      []( uint32_t, uint64_t, uint32_t, uint64_t const* ) {},
+      [&]( uint32_t thread, uint32_t node, uint64_t first, uint32_t count, uint64_t const* words ) {
+        /* bit i of word j is pattern 64j + i, the first pattern of a block has no predecessor,
+           and the padding patterns after the last one are masked */
+        const uint64_t mask = first + count == num_words ? last_mask : ~UINT64_C( 0 );
+        uint64_t o{0u}, t{0u};
+        for ( auto j = 0u; j < count; ++j )
+        {
+          const auto valid = j + 1u == count ? mask : ~UINT64_C( 0 );
+          const auto prev = j == 0u ? words[0] & 1u : words[j - 1] >> 63;
+          o += __builtin_popcountll( words[j] & valid );
+          t += __builtin_popcountll( ( words[j] ^ ( ( words[j] << 1 ) | prev ) ) & valid );
+        }
+        ones[thread][node] += o;
+        toggles[thread][node] += t;
+      },
+      ps );
+
+  const uint64_t block_words = std::max( 1u, ps.block_words );
+  const uint64_t num_blocks = ( num_words + block_words - 1u ) / block_words;
+  const double patterns = static_cast<double>( std::max<uint64_t>( num_patterns, 1u ) );
+  const double transitions = static_cast<double>( std::max<uint64_t>( num_patterns, num_blocks + 1u ) - num_blocks );
+
+  switching_activity_result res;
+  res.probability.resize( sim.num_nodes(), 0.0 );
+  res.toggle_rate.resize( sim.num_nodes(), 0.0 );
+  for ( auto n = 0u; n < sim.num_nodes(); ++n )
+  {
+    uint64_t o{0u}, t{0u};
+    for ( auto i = 0u; i < threads; ++i )
+    {
+      o += ones[i][n];
+      t += toggles[i][n];
+    }
+    res.probability[n] = o / patterns;
+    res.toggle_rate[n] = t / transitions;
+  }
+  res.probability[ntk.node_to_index( ntk.get_node( ntk.get_constant( true ) ) )] = ntk.is_complemented( ntk.get_constant( true ) ) ? 0.0 : 1.0;
+
+  ntk.foreach_node( [&]( auto const& n ) {
+    if ( ntk.is_constant( n ) )
+    {
+      return;
+    }
+    res.activity += res.toggle_rate[ntk.node_to_index( n )] * ntk.fanout_size( n );
+  } );
+
+  /* dangling gates are not simulated and do not count as gates */
+  sim.foreach_gate( [&]( uint32_t i ) {
+    res.gate_toggles += res.toggle_rate[i];
+    res.gate_probability += res.probability[i];
+    ++res.num_gates;
+  } );
+  return res;
+}
+
+} // namespace detail
+
+/*! \brief Estimates signal probabilities and toggle rates with random patterns.
+ *
+ * Simulates `ps.num_patterns` uniformly distributed, independent random
+ * patterns with `compiled_simulation` and counts for every node how often
+ * it is 1 and how often it changes between consecutive patterns.  The
+ * patterns only depend on the seed, not on the number of threads.
+ *
+   \verbatim embed:rst
+
+   Example
+
+   .. code-block:: c++
+
+      const auto act = switching_activity( aig );
+      std::cout << "switched capacitance = " << act.activity << "\n";
+   \endverbatim
+ */
+template<class Ntk>
+switching_activity_result switching_activity( Ntk const& ntk, switching_activity_params const& ps = {} )
+{
+  const compiled_simulation sim( ntk );
+  return detail::switching_activity(
+      ntk, sim, ps.num_patterns,
+      [&]( uint32_t pi, uint64_t first, uint32_t count, uint64_t* words ) {
+        for ( auto j = 0u; j < count; ++j )
+        {
+          words[j] = detail::splitmix64( ps.seed ^ detail::splitmix64( ( uint64_t( pi ) << 40 ) ^ ( first + j ) ) );
+        }
+      },
+      ps.simulation_ps );
+}
+
+/*! \brief Estimates signal probabilities and toggle rates for a pattern sequence.
+ *
+ * Simulates `num_patterns` patterns, pattern `64 * w + b` of input `i` is
+ * bit `b` of `pi_words[i * num_words + w]` with `num_words = (num_patterns
+ * + 63) / 64`; the bits after the last pattern are ignored.  Inputs are
+ * the primary inputs followed by the register outputs.  Toggle rates follow
+ * the order of the patterns.  Transitions between blocks of
+ * `ps.simulation_ps.block_words` words are not counted, and
+ * `ps.num_patterns` and `ps.seed` are not used.
+ */
+template<class Ntk>
+switching_activity_result switching_activity( Ntk const& ntk, std::vector<uint64_t> const& pi_words, uint64_t num_patterns, switching_activity_params const& ps = {} )
+{
+  const compiled_simulation sim( ntk );
+  const uint64_t num_words = ( num_patterns + 63u ) / 64u;
+  assert( pi_words.size() == sim.num_pis() * num_words );
+  return detail::switching_activity(
+      ntk, sim, num_patterns,
+      [&]( uint32_t pi, uint64_t first, uint32_t count, uint64_t* words ) {
+        std::copy_n( pi_words.begin() + pi * num_words + first, count, words );
+      },
+      ps.simulation_ps );
+}
+
+} // namespace mockturtle
@@ -0,0 +1,598 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file window_rewriting.hpp
+  \brief Parallel resynthesis of fanout-free windows
+
+  The network is decomposed into disjoint maximum fanout-free cones, each cone
+  is copied into its own small network and optimized on a pool of threads,
+  and the improved cones are written back in a single batch substitution.
+  This gives parallelism on designs that cannot be usefully partitioned with
+  a hypergraph partitioner.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "../traits.hpp"
+#include "../utils/stopwatch.hpp"
+
+namespace mockturtle
+{
+
+/*! \brief Parameters for window_rewriting.
+ *
+ * The data structure `window_rewriting_params` holds configurable parameters
+ * with default arguments for `window_rewriting`.
+ */
+struct window_rewriting_params
+{
+  /*! \brief Windows with fewer gates are not resynthesized. */
+  uint32_t min_gates{3u};
+
+  /*! \brief Levels of the transitive fanin in a window around a given root. */
+  uint32_t cone_depth{4u};
+
+  /*! \brief Largest window around a given root. */
+  uint32_t max_cone_gates{64u};
+
+  /*! \brief Number of worker threads (0 uses all hardware threads). */
+  uint32_t num_threads{0u};
+
+  /*! \brief Be verbose. */
+  bool verbose{false};
+};
+
+/*! \brief Statistics for window_rewriting.
+ *
+ * The data structure `window_rewriting_stats` provides data collected by
+ * running `window_rewriting`.
+ */
+struct window_rewriting_stats
+{
+  /*! \brief Total runtime. */
+  stopwatch<>::duration time_total{0};
+
+  /*! \brief Time to compute and extract the windows. */
+  stopwatch<>::duration time_windows{0};
+
+  /*! \brief Time spent in the (parallel) optimization. */
+  stopwatch<>::duration time_optimize{0};
+
+  /*! \brief Time to write the improved windows back. */
+  stopwatch<>::duration time_commit{0};
+
+  /*! \brief Number of resynthesized windows. */
+  uint32_t windows{0};
+
+  /*! \brief Number of windows that were replaced. */
+  uint32_t committed{0};
+
+  /*! \brief Gates reachable from the outputs before minus after the commit. */
+  int32_t gain{0};
+
+  void report() const
+  {
+    std::cout << fmt::format( "[i] windows        = {:>8}\n", windows );
+    std::cout << fmt::format( "[i] committed      = {:>8}\n", committed );
+    std::cout << fmt::format( "[i] gain           = {:>8}\n", gain );
+    std::cout << fmt::format( "[i] windows time   = {:>5.2f} secs\n", to_seconds( time_windows ) );
+    std::cout << fmt::format( "[i] optimize time  = {:>5.2f} secs\n", to_seconds( time_optimize ) );
+    std::cout << fmt::format( "[i] commit time    = {:>5.2f} secs\n", to_seconds( time_commit ) );
+    std::cout << fmt::format( "[i] total time     = {:>5.2f} secs\n", to_seconds( time_total ) );
+  }
+};
+
+namespace detail
+{
+
+template<class Ntk, class OptFactory>
+class window_rewriting_impl
+{
+public:
+  using node = typename Ntk::node;
+  using signal = typename Ntk::signal;
+
+  struct window
+  {
+    node root;
+    std::vector<node> leaves;
+    std::vector<node> gates;
+    Ntk ntk;
+
+    /* gates that become dangling when the root is replaced */
+    uint32_t freed{0u};
+  };
+
+  window_rewriting_impl( Ntk& ntk, OptFactory&& make_opt, window_rewriting_params const& ps, window_rewriting_stats& st, std::vector<node> const* roots = nullptr )
+      : ntk( ntk ),
+        make_opt( make_opt ),
+        ps( ps ),
+        st( st ),
+        roots( roots )
+  {
+  }
+
+  void run()
+  {
+    stopwatch t( st.time_total );
+
+    std::vector<window> windows;
+    call_with_stopwatch( st.time_windows, [&]() { windows = roots ? compute_cones() : compute_windows(); } );
+    st.windows = static_cast<uint32_t>( windows.size() );
+
+    call_with_stopwatch( st.time_optimize, [&]() { optimize( windows ); } );
+    call_with_stopwatch( st.time_commit, [&]() { commit( windows ); } );
+  }
+
+private:
+  /* CO drivers first, every gate after its fanins */
+  std::vector<node> topological_gates() const
+  {
+    std::vector<node> order;
+    std::vector<uint8_t> mark( ntk.size(), 0u );
+    std::vector<std::pair<node, bool>> stack;
+
+    ntk.foreach_co( [&]( auto const& f ) {
+      stack.emplace_back( ntk.get_node( f ), false );
+      while ( !stack.empty() )
+      {
+        auto [n, expanded] = stack.back();
+        stack.pop_back();
+        const auto idx = ntk.node_to_index( n );
+        if ( expanded )
+        {
+          order.push_back( n );
+          continue;
+        }
+        if ( mark[idx] || ntk.is_constant( n ) || ntk.is_ci( n ) )
+        {
+          continue;
+        }
+        mark[idx] = 1u;
+        stack.emplace_back( n, true );
+        ntk.foreach_fanin( n, [&]( auto const& g ) {
+          stack.emplace_back( ntk.get_node( g ), false );
+        } );
+      }
+    } );
+
+    return order;
+  }
+
+  std::vector<window> compute_windows()
+  {
+    const auto gates = topological_gates();
+
+    std::vector<uint8_t> is_root( ntk.size(), 0u );
+    ntk.foreach_co( [&]( auto const& f ) {
+      is_root[ntk.node_to_index( ntk.get_node( f ) )] = 1u;
+    } );
+
+    /* owner of each gate is the root of the fanout-free cone it belongs to */
+    std::vector<int64_t> owner( ntk.size(), -1 );
+    std::vector<uint32_t> window_of( ntk.size(), 0u );
+    std::vector<window> windows;
+    for ( auto it = gates.rbegin(); it != gates.rend(); ++it )
+    {
+      const auto idx = ntk.node_to_index( *it );
+      if ( is_root[idx] || ntk.fanout_size( *it ) != 1u || owner[idx] == -1 )
+      {
+        owner[idx] = idx;
+        window_of[idx] = static_cast<uint32_t>( windows.size() );
+        windows.push_back( {*it, {}, {}, Ntk{}} );
+      }
+      windows[window_of[owner[idx]]].gates.push_back( *it );
+
+      ntk.foreach_fanin( *it, [&]( auto const& f ) {
+        const auto c = ntk.get_node( f );
+        const auto cidx = ntk.node_to_index( c );
+        if ( !ntk.is_constant( c ) && !ntk.is_ci( c ) && !is_root[cidx] && ntk.fanout_size( c ) == 1u )
+        {
+          owner[cidx] = owner[idx];
+        }
+      } );
+    }
+
+    /* the roots were found in reverse topological order */
+    std::vector<window> result;
+    std::vector<int64_t> leaf_mark( ntk.size(), -1 );
+    for ( auto it = windows.rbegin(); it != windows.rend(); ++it )
+    {
+      auto& w = *it;
+      if ( w.gates.size() < ps.min_gates )
+      {
+        continue;
+      }
+      std::reverse( w.gates.begin(), w.gates.end() );
+      w.freed = static_cast<uint32_t>( w.gates.size() );
+
+      const auto root = static_cast<int64_t>( ntk.node_to_index( w.root ) );
+      for ( auto const& n : w.gates )
+      {
+        ntk.foreach_fanin( n, [&]( auto const& f ) {
+          const auto c = ntk.get_node( f );
+          const auto cidx = ntk.node_to_index( c );
+          if ( ntk.is_constant( c ) || owner[cidx] == root || leaf_mark[cidx] == root )
+          {
+            return;
+          }
+          leaf_mark[cidx] = root;
+          w.leaves.push_back( c );
+        } );
+      }
+      extract( w );
+      result.push_back( std::move( w ) );
+    }
+    return result;
+  }
+
+  /* depth-bounded fanin cones of the given roots; a gate belongs to the cone of the first root, in topological order, that reaches it */
+  std::vector<window> compute_cones()
+  {
+    const auto gates = topological_gates();
+    std::vector<uint32_t> position( ntk.size(), std::numeric_limits<uint32_t>::max() );
+    for ( auto i = 0u; i < gates.size(); ++i )
+    {
+      position[ntk.node_to_index( gates[i] )] = i;
+    }
+
+    /* references from dangling logic do not keep a gate alive */
+    std::vector<uint32_t> live_fanout( ntk.size(), 0u );
+    for ( auto const& n : gates )
+    {
+      ntk.foreach_fanin( n, [&]( auto const& f ) {
+        ++live_fanout[ntk.node_to_index( ntk.get_node( f ) )];
+      } );
+    }
+    ntk.foreach_co( [&]( auto const& f ) {
+      ++live_fanout[ntk.node_to_index( ntk.get_node( f ) )];
+    } );
+
+    std::vector<node> sorted;
+    std::vector<uint8_t> is_root( ntk.size(), 0u );
+    for ( auto const& r : *roots )
+    {
+      const auto idx = ntk.node_to_index( r );
+      if ( position[idx] != std::numeric_limits<uint32_t>::max() && !is_root[idx] )
+      {
+        is_root[idx] = 1u;
+        sorted.push_back( r );
+      }
+    }
+    std::sort( sorted.begin(), sorted.end(), [&]( auto const& a, auto const& b ) {
+      return position[ntk.node_to_index( a )] < position[ntk.node_to_index( b )];
+    } );
+
+    std::vector<int64_t> owner( ntk.size(), -1 );
+    std::vector<int64_t> leaf_mark( ntk.size(), -1 );
+    std::vector<uint32_t> fanout_freed( ntk.size(), 0u );
+    std::vector<window> result;
+    for ( auto const& r : sorted )
+    {
+      const auto root = static_cast<int64_t>( ntk.node_to_index( r ) );
+      window w{r, {}, {r}, Ntk{}};
+      owner[root] = root;
+
+      /* breadth first, so that a gate is first seen at its smallest distance from the root */
+      std::vector<node> frontier{r};
+      for ( auto level = 1u; level < ps.cone_depth && !frontier.empty(); ++level )
+      {
+        std::vector<node> next;
+        for ( auto const& n : frontier )
+        {
+          ntk.foreach_fanin( n, [&]( auto const& f ) {
+            const auto c = ntk.get_node( f );
+            const auto cidx = ntk.node_to_index( c );
+            if ( ntk.is_constant( c ) || ntk.is_ci( c ) || is_root[cidx] || owner[cidx] != -1 || leaf_mark[cidx] == root )
+            {
+              return;
+            }
+            if ( w.gates.size() >= ps.max_cone_gates )
+            {
+              leaf_mark[cidx] = root;
+              return;
+            }
+            owner[cidx] = root;
+            w.gates.push_back( c );
+            next.push_back( c );
+          } );
+        }
+        frontier = std::move( next );
+      }
+
+      if ( w.gates.size() < ps.min_gates )
+      {
+        continue;
+      }
+      std::sort( w.gates.begin(), w.gates.end(), [&]( auto const& a, auto const& b ) {
+        return position[ntk.node_to_index( a )] < position[ntk.node_to_index( b )];
+      } );
+
+      for ( auto const& n : w.gates )
+      {
+        ntk.foreach_fanin( n, [&]( auto const& f ) {
+          const auto c = ntk.get_node( f );
+          const auto cidx = ntk.node_to_index( c );
+          if ( ntk.is_constant( c ) || owner[cidx] == root || leaf_mark[cidx] == -2 - root )
+          {
+            return;
+          }
+          leaf_mark[cidx] = -2 - root;
+          w.leaves.push_back( c );
+        } );
+      }
+
+      /* gates referenced from outside the cone stay alive after the root is replaced */
+      for ( auto it = w.gates.rbegin(); it != w.gates.rend(); ++it )
+      {
+        const auto idx = ntk.node_to_index( *it );
+        if ( *it != r && fanout_freed[idx] != live_fanout[idx] )
+        {
+          continue;
+        }
+        ++w.freed;
+        ntk.foreach_fanin( *it, [&]( auto const& f ) {
+          const auto cidx = ntk.node_to_index( ntk.get_node( f ) );
+          if ( owner[cidx] == root )
+          {
+            ++fanout_freed[cidx];
+          }
+        } );
+      }
+
+      extract( w );
+      result.push_back( std::move( w ) );
+    }
+    return result;
+  }
+
+  void extract( window& w ) const
+  {
+    std::unordered_map<node, signal> old_to_new;
+    old_to_new[ntk.get_node( ntk.get_constant( false ) )] = w.ntk.get_constant( false );
+    for ( auto const& l : w.leaves )
+    {
+      old_to_new[l] = w.ntk.create_pi();
+    }
+
+    for ( auto const& n : w.gates )
+    {
+      std::vector<signal> children;
+      ntk.foreach_fanin( n, [&]( auto const& f ) {
+        const auto s = old_to_new.at( ntk.get_node( f ) );
+        children.push_back( ntk.is_complemented( f ) ? w.ntk.create_not( s ) : s );
+      } );
+      old_to_new[n] = w.ntk.clone_node( ntk, n, children );
+    }
+    w.ntk.create_po( old_to_new.at( w.root ) );
+  }
+
+  void optimize( std::vector<window>& windows )
+  {
+    auto num_threads = ps.num_threads ? ps.num_threads : std::max( 1u, std::thread::hardware_concurrency() );
+    num_threads = std::min<uint32_t>( num_threads, std::max<std::size_t>( windows.size(), 1u ) );
+
+    std::atomic<std::size_t> next{0u};
+    auto worker = [&]() {
+      auto opt = make_opt();
+      for ( auto i = next++; i < windows.size(); i = next++ )
+      {
+        opt( windows[i].ntk );
+      }
+    };
+
+    std::vector<std::thread> threads;
+    for ( auto i = 1u; i < num_threads; ++i )
+    {
+      threads.emplace_back( worker );
+    }
+    worker();
+    for ( auto& t : threads )
+    {
+      t.join();
+    }
+  }
+
+  /* windows are in topological order of their roots, so a window sees the new roots of the windows it reads */
+  void commit( std::vector<window>& windows )
+  {
+    const auto live_before = topological_gates().size();
+    std::vector<std::pair<node, signal>> substitutions;
+    std::vector<signal> new_root( ntk.size() );
+    std::vector<uint8_t> replaced( ntk.size(), 0u );
+
+    for ( auto& w : windows )
+    {
+      if ( w.ntk.num_gates() >= w.gates.size() )
+      {
+        continue;
+      }
+
+      /* gates the window shares with the rest of the network are hashed onto the existing ones */
+      const auto size_before = ntk.size();
+
+      std::vector<signal> win_to_ntk( w.ntk.size() );
+      win_to_ntk[w.ntk.node_to_index( w.ntk.get_node( w.ntk.get_constant( false ) ) )] = ntk.get_constant( false );
+      w.ntk.foreach_pi( [&]( auto const& n, auto i ) {
+        const auto leaf = ntk.node_to_index( w.leaves[i] );
+        win_to_ntk[w.ntk.node_to_index( n )] = replaced[leaf] ? new_root[leaf] : ntk.make_signal( w.leaves[i] );
+      } );
+      w.ntk.foreach_gate( [&]( auto const& n ) {
+        std::vector<signal> children;
+        w.ntk.foreach_fanin( n, [&]( auto const& f ) {
+          const auto s = win_to_ntk[w.ntk.node_to_index( w.ntk.get_node( f ) )];
+          children.push_back( w.ntk.is_complemented( f ) ? ntk.create_not( s ) : s );
+        } );
+        win_to_ntk[w.ntk.node_to_index( n )] = ntk.clone_node( w.ntk, n, children );
+      } );
+
+      signal f;
+      w.ntk.foreach_po( [&]( auto const& po ) {
+        const auto s = win_to_ntk[w.ntk.node_to_index( w.ntk.get_node( po ) )];
+        f = w.ntk.is_complemented( po ) ? ntk.create_not( s ) : s;
+      } );
+
+      const auto created = static_cast<uint32_t>( ntk.size() - size_before );
+      if ( ntk.get_node( f ) == w.root || created >= w.freed )
+      {
+        continue;
+      }
+
+      const auto idx = ntk.node_to_index( w.root );
+      replaced[idx] = 1u;
+      new_root[idx] = f;
+      substitutions.emplace_back( w.root, f );
+      ++st.committed;
+    }
+
+    ntk.substitute_nodes( substitutions );
+    st.gain = static_cast<int32_t>( live_before ) - static_cast<int32_t>( topological_gates().size() );
+  }
+
+private:
+  Ntk& ntk;
+  OptFactory& make_opt;
+  window_rewriting_params const& ps;
+  window_rewriting_stats& st;
+  std::vector<node> const* roots;
+};
+
+} /* namespace detail */
+
+/*! \brief Parallel window based rewriting.
+ *
+ * The gates are grouped into disjoint maximum fanout-free cones: a gate with
+ * more than one fanout or driving a combinational output starts a window and
+ * every other gate joins the window of its single fanout.  Each window with
+ * at least `min_gates` gates is copied into a standalone network of type
+ * `Ntk`, whose primary inputs are the window leaves and whose single output
+ * is the window root.
+ *
+ * The windows are optimized independently on `num_threads` threads.
+ * `make_opt` is called once per thread and must return a callable with
+ * signature `void(Ntk&)` that optimizes a window in place, e.g. by running
+ * cut rewriting with a resynthesis function owned by that thread.  A window
+ * replaces the original cone only if it ended up with fewer gates; the
+ * replaced cones are left dangling, so run `cleanup_dangling` afterwards.
+ *
+ * Registers are preserved since register outputs are leaves and register
+ * inputs are roots of the windows.
+ *
+ * **Required network functions:**
+ * - `foreach_co`
+ * - `foreach_fanin`
+ * - `fanout_size`
+ * - `is_ci`
+ * - `clone_node`
+ * - `substitute_nodes`
+ *
+ * \param ntk Network (will be modified)
+ * \param make_opt Factory of per thread window optimizers
+ * \param ps Parameters
+ * \param pst Statistics
+ */
+template<class Ntk, class OptFactory>
+void window_rewriting( Ntk& ntk, OptFactory&& make_opt, window_rewriting_params const& ps = {}, window_rewriting_stats* pst = nullptr )
+{
+  static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
+  static_assert( has_foreach_co_v<Ntk>, "Ntk does not implement the foreach_co method" );
+  static_assert( has_foreach_fanin_v<Ntk>, "Ntk does not implement the foreach_fanin method" );
+  static_assert( has_fanout_size_v<Ntk>, "Ntk does not implement the fanout_size method" );
+  static_assert( has_is_ci_v<Ntk>, "Ntk does not implement the is_ci method" );
+  static_assert( has_clone_node_v<Ntk>, "Ntk does not implement the clone_node method" );
+
+  window_rewriting_stats st;
+  detail::window_rewriting_impl<Ntk, OptFactory> p( ntk, std::forward<OptFactory>( make_opt ), ps, st );
+  p.run();
+
+  if ( ps.verbose )
+  {
+    st.report();
+  }
+
+  if ( pst )
+  {
+    *pst = st;
+  }
+}
+
+/*! \brief Parallel rewriting of windows around given roots.
+ *
+ * Instead of covering the network with fanout-free cones, every root gets a
+ * window made of its transitive fanin up to `cone_depth` levels and at most
+ * `max_cone_gates` gates.  The windows are disjoint: a gate belongs to the
+ * window of the first root, in topological order, that reaches it, and other
+ * roots are leaves.  Gates inside a window may have fanouts outside of it;
+ * they are kept, and a window is only replaced if cloning it adds fewer
+ * nodes than the part of its cone that becomes dangling.
+ *
+ * Optimization, parallelism and required network functions are the same as
+ * for the overload without roots.
+ *
+ * \param ntk Network (will be modified)
+ * \param roots Roots of the windows
+ * \param make_opt Factory of per thread window optimizers
+ * \param ps Parameters
+ * \param pst Statistics
+ */
+template<class Ntk, class OptFactory>
+void window_rewriting( Ntk& ntk, std::vector<typename Ntk::node> const& roots, OptFactory&& make_opt, window_rewriting_params const& ps = {}, window_rewriting_stats* pst = nullptr )
+{
+  static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
+  static_assert( has_foreach_co_v<Ntk>, "Ntk does not implement the foreach_co method" );
+  static_assert( has_foreach_fanin_v<Ntk>, "Ntk does not implement the foreach_fanin method" );
+  static_assert( has_fanout_size_v<Ntk>, "Ntk does not implement the fanout_size method" );
+  static_assert( has_is_ci_v<Ntk>, "Ntk does not implement the is_ci method" );
+  static_assert( has_clone_node_v<Ntk>, "Ntk does not implement the clone_node method" );
+
+  window_rewriting_stats st;
+  detail::window_rewriting_impl<Ntk, OptFactory> p( ntk, std::forward<OptFactory>( make_opt ), ps, st, &roots );
+  p.run();
+
+  if ( ps.verbose )
+  {
+    st.report();
+  }
+
+  if ( pst )
+  {
+    *pst = st;
+  }
+}
+
+} /* namespace mockturtle */
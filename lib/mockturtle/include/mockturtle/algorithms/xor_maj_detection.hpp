@@ -0,0 +1,619 @@
+/*!
+  \file xor_maj_detection.hpp
+  \brief Cut-based detection of XOR and majority structures
+
+  All cuts with at most three leaves are enumerated in one topological pass,
+  with their functions kept as 8-bit truth tables.  A lookup table classifies
+  every cut function as XOR2, XOR3 or MAJ3 (up to complementation), and the
+  detected gates are combined into maximal XOR trees and half and full adders.
+  The runtime is linear in the network size for the fixed cut limit.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <iostream>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+#include <kitty/static_truth_table.hpp>
+
+#include "../traits.hpp"
+#include "../utils/stopwatch.hpp"
+
+namespace mockturtle
+{
+
+/*! \brief Parameters for detect_xor_maj.
+ *
+ * The data structure `xor_maj_detection_params` holds configurable parameters
+ * with default arguments for `detect_xor_maj`.
+ */
+struct xor_maj_detection_params
+{
+  /*! \brief Maximum number of cuts kept per node (besides the trivial cut). */
+  uint32_t cut_limit{8u};
+
+  /*! \brief Be verbose. */
+  bool verbose{false};
+};
+
+/*! \brief Statistics for detect_xor_maj. */
+struct xor_maj_detection_stats
+{
+  /*! \brief Total runtime. */
+  stopwatch<>::duration time_total{0};
+
+  /*! \brief Time for cut enumeration and classification. */
+  stopwatch<>::duration time_cuts{0};
+
+  /*! \brief Number of enumerated cuts. */
+  uint64_t cuts{0};
+
+  void report() const
+  {
+    std::cout << fmt::format( "[i] cuts           = {:>8}\n", cuts );
+    std::cout << fmt::format( "[i] cut time       = {:>5.2f} secs\n", to_seconds( time_cuts ) );
+    std::cout << fmt::format( "[i] total time     = {:>5.2f} secs\n", to_seconds( time_total ) );
+  }
+};
+
+/*! \brief A node that implements XOR2, XOR3 or MAJ3 of its leaves. */
+template<class Ntk>
+struct detected_gate
+{
+  typename Ntk::node root;
+  std::vector<typename Ntk::node> leaves;
+
+  /*! \brief The root computes XNOR instead of XOR. */
+  bool complemented{false};
+};
+
+/*! \brief A maximal tree of XOR gates whose inner XORs have no other fanout. */
+template<class Ntk>
+struct xor_tree
+{
+  typename Ntk::node root;
+  std::vector<typename Ntk::node> leaves;
+  uint32_t num_xors{0};
+};
+
+/*! \brief Sum and carry nodes over the same leaves. */
+template<class Ntk>
+struct detected_adder
+{
+  typename Ntk::node sum;
+  typename Ntk::node carry;
+  std::vector<typename Ntk::node> leaves;
+};
+
+template<class Ntk>
+struct xor_maj_detection_result
+{
+  std::vector<detected_gate<Ntk>> xor2;
+  std::vector<detected_gate<Ntk>> xor3;
+  std::vector<detected_gate<Ntk>> maj3;
+  std::vector<xor_tree<Ntk>> xor_trees;
+  std::vector<detected_adder<Ntk>> half_adders;
+  std::vector<detected_adder<Ntk>> full_adders;
+};
+
+namespace detail
+{
+
+enum class cut_function : uint8_t
+{
+  none,
+  and2,
+  xor2,
+  xor3,
+  maj3
+};
+
+/* classification of the 8-bit truth tables of 2- and 3-leaf cuts */
+struct cut_function_table
+{
+  cut_function_table()
+  {
+    two.fill( cut_function::none );
+    three.fill( cut_function::none );
+
+    two[0x66] = two[0x99] = cut_function::xor2;
+    two[0x88] = cut_function::and2;
+    three[0x96] = three[0x69] = cut_function::xor3;
+    for ( auto p = 0u; p < 8u; ++p )
+    {
+      uint8_t tt = 0u;
+      for ( auto m = 0u; m < 8u; ++m )
+      {
+        const auto v = m ^ p;
+        const auto ones = ( v & 1u ) + ( ( v >> 1 ) & 1u ) + ( ( v >> 2 ) & 1u );
+        if ( ones >= 2u )
+        {
+          tt |= uint8_t( 1u << m );
+        }
+      }
+      three[tt] = cut_function::maj3;
+    }
+  }
+
+  cut_function operator()( uint8_t size, uint8_t tt ) const
+  {
+    return size == 2u ? two[tt] : ( size == 3u ? three[tt] : cut_function::none );
+  }
+
+  std::array<cut_function, 256> two;
+  std::array<cut_function, 256> three;
+};
+
+struct small_cut
+{
+  std::array<uint32_t, 3> leaves;
+  uint8_t size;
+  uint8_t tt;
+};
+
+template<class Ntk>
+class xor_maj_detection_impl
+{
+public:
+  using node = typename Ntk::node;
+  using signal = typename Ntk::signal;
+
+  xor_maj_detection_impl( Ntk const& ntk, xor_maj_detection_params const& ps, xor_maj_detection_stats& st )
+      : ntk( ntk ), ps( ps ), st( st ),
+        first( ntk.size(), 0u ),
+        last( ntk.size(), 0u )
+  {
+  }
+
+  xor_maj_detection_result<Ntk> run()
+  {
+    stopwatch t( st.time_total );
+
+    xor_maj_detection_result<Ntk> result;
+    std::vector<cut_function> best( ntk.size(), cut_function::none );
+    std::vector<uint32_t> best_cut( ntk.size(), 0u );
+
+    {
+      stopwatch t_cuts( st.time_cuts );
+      enumerate( best, best_cut );
+    }
+
+    std::unordered_map<uint64_t, node> sums;
+    ntk.foreach_gate( [&]( auto const& n ) {
+      const auto i = ntk.node_to_index( n );
+      if ( best[i] == cut_function::none || best[i] == cut_function::and2 )
+      {
+        return;
+      }
+      auto const& c = cuts[best_cut[i]];
+      /* MAJ3 is self-dual, so only XORs are reported with an output complement */
+      detected_gate<Ntk> g{n, leaves_of( c ), best[i] != cut_function::maj3 && ( c.tt & 1u ) != 0u};
+      if ( best[i] == cut_function::maj3 )
+      {
+        result.maj3.push_back( g );
+      }
+      else
+      {
+        sums.emplace( key( c ), n );
+        ( best[i] == cut_function::xor2 ? result.xor2 : result.xor3 ).push_back( g );
+      }
+    } );
+
+    /* adders: a carry over the same leaves as an XOR */
+    ntk.foreach_gate( [&]( auto const& n ) {
+      const auto i = ntk.node_to_index( n );
+      for ( auto k = first[i]; k < last[i]; ++k )
+      {
+        auto const& c = cuts[k];
+        const auto f = table( c.size, c.tt );
+        if ( f != cut_function::and2 && f != cut_function::maj3 )
+        {
+          continue;
+        }
+        if ( auto it = sums.find( key( c ) ); it != sums.end() && it->second != n )
+        {
+          ( f == cut_function::and2 ? result.half_adders : result.full_adders ).push_back( {it->second, n, leaves_of( c )} );
+          break;
+        }
+      }
+    } );
+
+    collect_xor_trees( best, best_cut, result );
+    return result;
+  }
+
+private:
+  void enumerate( std::vector<cut_function>& best, std::vector<uint32_t>& best_cut )
+  {
+    cuts.reserve( 4u * ntk.size() );
+    std::vector<small_cut> candidates;
+
+    for ( auto const& n : topological_nodes() )
+    {
+      const auto i = ntk.node_to_index( n );
+      first[i] = static_cast<uint32_t>( cuts.size() );
+
+      if ( ntk.is_constant( n ) )
+      {
+        cuts.push_back( {{0u, 0u, 0u}, 0u, 0u} );
+        last[i] = static_cast<uint32_t>( cuts.size() );
+        continue;
+      }
+
+      if ( !is_input( n ) )
+      {
+        std::vector<signal> fanins;
+        ntk.foreach_fanin( n, [&]( auto const& f ) {
+          fanins.push_back( f );
+        } );
+
+        candidates.clear();
+        merge( n, fanins, 0u, {{0u, 0u, 0u}, 0u, 0u}, {}, candidates );
+        std::stable_sort( candidates.begin(), candidates.end(), []( auto const& a, auto const& b ) { return a.size < b.size; } );
+
+        auto kept = 0u;
+        for ( auto const& c : candidates )
+        {
+          if ( kept == ps.cut_limit )
+          {
+            break;
+          }
+          const auto f = table( c.size, c.tt );
+          if ( f != cut_function::none && ( best[i] == cut_function::none || best[i] == cut_function::and2 || ( f == cut_function::xor3 && best[i] == cut_function::xor2 ) ) )
+          {
+            best[i] = f;
+            best_cut[i] = static_cast<uint32_t>( cuts.size() );
+          }
+          cuts.push_back( c );
+          ++kept;
+        }
+      }
+
+      /* trivial cut */
+      cuts.push_back( {{i, 0u, 0u}, 1u, 0xaa} );
+      last[i] = static_cast<uint32_t>( cuts.size() );
+    }
+
+    st.cuts += cuts.size();
+  }
+
+  /* every node after its fanins, node indices need not be in topological order */
+  std::vector<node> topological_nodes() const
+  {
+    std::vector<node> order;
+    order.reserve( ntk.size() );
+    std::vector<uint8_t> mark( ntk.size(), 0u );
+    std::vector<std::pair<node, bool>> stack;
+
+    ntk.foreach_node( [&]( auto const& root ) {
+      stack.emplace_back( root, false );
+      while ( !stack.empty() )
+      {
+        auto [n, expanded] = stack.back();
+        stack.pop_back();
+        const auto idx = ntk.node_to_index( n );
+        if ( expanded )
+        {
+          order.push_back( n );
+          continue;
+        }
+        if ( mark[idx] )
+        {
+          continue;
+        }
+        mark[idx] = 1u;
+        stack.emplace_back( n, true );
+        if ( ntk.is_constant( n ) || is_input( n ) )
+        {
+          continue;
+        }
+        ntk.foreach_fanin( n, [&]( auto const& f ) {
+          stack.emplace_back( ntk.get_node( f ), false );
+        } );
+      }
+    } );
+
+    return order;
+  }
+
+  /* cartesian product of the fanin cut sets, computing the functions on the fly */
+  void merge( node const& n, std::vector<signal> const& fanins, uint32_t pos, small_cut const& current, std::array<uint32_t, 3> chosen, std::vector<small_cut>& candidates )
+  {
+    if ( pos == fanins.size() )
+    {
+      tts.resize( fanins.size() );
+      for ( auto j = 0u; j < fanins.size(); ++j )
+      {
+        tts[j]._bits = expand( cuts[chosen[j]], current );
+      }
+      auto tt = ntk.compute( n, tts.begin(), tts.end() );
+
+      auto c = current;
+      c.tt = static_cast<uint8_t>( tt._bits );
+      for ( auto const& other : candidates )
+      {
+        if ( other.size == c.size && other.leaves == c.leaves )
+        {
+          return;
+        }
+      }
+      candidates.push_back( c );
+      return;
+    }
+
+    const auto fi = ntk.node_to_index( ntk.get_node( fanins[pos] ) );
+    for ( auto k = first[fi]; k < last[fi]; ++k )
+    {
+      small_cut merged;
+      if ( !unite( current, cuts[k], merged ) )
+      {
+        continue;
+      }
+      chosen[pos] = k;
+      merge( n, fanins, pos + 1u, merged, chosen, candidates );
+    }
+  }
+
+  static bool unite( small_cut const& a, small_cut const& b, small_cut& out )
+  {
+    uint32_t i = 0u, j = 0u;
+    out.size = 0u;
+    while ( i < a.size || j < b.size )
+    {
+      uint32_t leaf;
+      if ( j == b.size || ( i < a.size && a.leaves[i] < b.leaves[j] ) )
+      {
+        leaf = a.leaves[i++];
+      }
+      else if ( i == a.size || b.leaves[j] < a.leaves[i] )
+      {
+        leaf = b.leaves[j++];
+      }
+      else
+      {
+        leaf = a.leaves[i++];
+        ++j;
+      }
+      if ( out.size == 3u )
+      {
+        return false;
+      }
+      out.leaves[out.size++] = leaf;
+    }
+    for ( auto k = out.size; k < 3u; ++k )
+    {
+      out.leaves[k] = 0u;
+    }
+    return true;
+  }
+
+  /* function of a sub-cut in terms of the leaves of a larger cut */
+  static uint64_t expand( small_cut const& sub, small_cut const& cut )
+  {
+    std::array<uint32_t, 3> position{0u, 0u, 0u};
+    for ( auto k = 0u; k < sub.size; ++k )
+    {
+      position[k] = static_cast<uint32_t>( std::find( cut.leaves.begin(), cut.leaves.begin() + cut.size, sub.leaves[k] ) - cut.leaves.begin() );
+    }
+
+    uint64_t bits = 0u;
+    for ( auto m = 0u; m < 8u; ++m )
+    {
+      auto sub_m = 0u;
+      for ( auto k = 0u; k < sub.size; ++k )
+      {
+        sub_m |= ( ( m >> position[k] ) & 1u ) << k;
+      }
+      bits |= uint64_t( ( sub.tt >> sub_m ) & 1u ) << m;
+    }
+    return bits;
+  }
+
+  /* register outputs are cut leaves like primary inputs */
+  bool is_input( node const& n ) const
+  {
+    if constexpr ( has_is_ci_v<Ntk> )
+    {
+      return ntk.is_ci( n );
+    }
+    else
+    {
+      return ntk.is_pi( n );
+    }
+  }
+
+  std::vector<node> leaves_of( small_cut const& c ) const
+  {
+    std::vector<node> leaves;
+    for ( auto k = 0u; k < c.size; ++k )
+    {
+      leaves.push_back( ntk.index_to_node( c.leaves[k] ) );
+    }
+    return leaves;
+  }
+
+  static uint64_t key( small_cut const& c )
+  {
+    return ( uint64_t( c.size ) << 62 ) ^ ( uint64_t( c.leaves[0] ) << 42 ) ^ ( uint64_t( c.leaves[1] ) << 21 ) ^ uint64_t( c.leaves[2] );
+  }
+
+  /* an XOR is absorbed into the tree of another XOR if all of its fanouts lie between that XOR
+     and its leaves; absorbed leaves are expanded, absorbed inner XORs are already covered */
+  void collect_xor_trees( std::vector<cut_function> const& best, std::vector<uint32_t> const& best_cut, xor_maj_detection_result<Ntk>& result )
+  {
+    auto is_xor = [&]( uint32_t i ) {
+      return best[i] == cut_function::xor2 || best[i] == cut_function::xor3;
+    };
+
+    std::vector<uint8_t> absorbed( ntk.size(), 0u );
+    std::vector<uint32_t> inner( ntk.size(), 0u );
+    std::unordered_map<uint32_t, uint32_t> refs;
+    std::vector<uint32_t> stack;
+    std::vector<uint32_t> cone;
+    ntk.foreach_gate( [&]( auto const& n ) {
+      const auto i = ntk.node_to_index( n );
+      if ( !is_xor( i ) )
+      {
+        return;
+      }
+      auto const& c = cuts[best_cut[i]];
+      auto is_leaf = [&]( uint32_t k ) {
+        return std::find( c.leaves.begin(), c.leaves.begin() + c.size, k ) != c.leaves.begin() + c.size;
+      };
+
+      /* count the references from the gates between root and leaves */
+      refs.clear();
+      cone.clear();
+      stack.assign( 1u, i );
+      while ( !stack.empty() )
+      {
+        const auto j = stack.back();
+        stack.pop_back();
+        if ( std::find( cone.begin(), cone.end(), j ) != cone.end() )
+        {
+          continue;
+        }
+        cone.push_back( j );
+        ntk.foreach_fanin( ntk.index_to_node( j ), [&]( auto const& f ) {
+          const auto k = ntk.node_to_index( ntk.get_node( f ) );
+          ++refs[k];
+          if ( !is_leaf( k ) && !ntk.is_constant( ntk.get_node( f ) ) && !is_input( ntk.get_node( f ) ) )
+          {
+            stack.push_back( k );
+          }
+        } );
+      }
+
+      auto contained = [&]( uint32_t k ) {
+        return is_xor( k ) && refs[k] == ntk.fanout_size( ntk.index_to_node( k ) );
+      };
+      for ( auto k = 0u; k < c.size; ++k )
+      {
+        if ( contained( c.leaves[k] ) )
+        {
+          absorbed[c.leaves[k]] = 1u;
+        }
+      }
+      for ( auto j : cone )
+      {
+        if ( j != i && contained( j ) && absorbed[j] == 0u )
+        {
+          absorbed[j] = 2u;
+          ++inner[i];
+        }
+      }
+    } );
+
+    ntk.foreach_gate( [&]( auto const& n ) {
+      const auto i = ntk.node_to_index( n );
+      if ( !is_xor( i ) || absorbed[i] )
+      {
+        return;
+      }
+
+      xor_tree<Ntk> tree{n, {}, 0u};
+      std::vector<uint32_t> leaves;
+      stack.assign( 1u, i );
+      while ( !stack.empty() )
+      {
+        const auto j = stack.back();
+        stack.pop_back();
+        tree.num_xors += 1u + inner[j];
+        auto const& c = cuts[best_cut[j]];
+        for ( auto k = 0u; k < c.size; ++k )
+        {
+          if ( absorbed[c.leaves[k]] == 1u )
+          {
+            stack.push_back( c.leaves[k] );
+          }
+          else
+          {
+            leaves.push_back( c.leaves[k] );
+          }
+        }
+      }
+
+      /* a leaf that enters twice cancels out */
+      std::sort( leaves.begin(), leaves.end() );
+      for ( auto k = 0u; k < leaves.size(); ++k )
+      {
+        if ( k + 1u < leaves.size() && leaves[k] == leaves[k + 1u] )
+        {
+          ++k;
+          continue;
+        }
+        tree.leaves.push_back( ntk.index_to_node( leaves[k] ) );
+      }
+      result.xor_trees.push_back( tree );
+    } );
+  }
+
+private:
+  Ntk const& ntk;
+  xor_maj_detection_params const& ps;
+  xor_maj_detection_stats& st;
+
+  cut_function_table const table;
+  std::vector<small_cut> cuts;
+  std::vector<uint32_t> first;
+  std::vector<uint32_t> last;
+  std::vector<kitty::static_truth_table<3>> tts;
+};
+
+} /* namespace detail */
+
+/*! \brief Detects XOR, majority and adder structures.
+ *
+ * Enumerates all cuts with up to three leaves in a single topological pass
+ * and classifies their functions with a lookup table.  Every gate is reported
+ * at most once, as XOR3 if possible, otherwise as XOR2 or MAJ3.  XOR gates
+ * whose fanouts all lie inside another XOR are merged into maximal XOR trees,
+ * and XOR2/AND2 and XOR3/MAJ3 pairs over the same leaves are reported as half
+ * and full adders.
+ *
+ * **Required network functions:**
+ * - `foreach_node`
+ * - `foreach_gate`
+ * - `foreach_fanin`
+ * - `fanout_size`
+ * - `compute`
+ * - `node_to_index`
+ * - `index_to_node`
+ *
+ * \param ntk Network
+ * \param ps Parameters
+ * \param pst Statistics
+ */
+template<class Ntk>
+xor_maj_detection_result<Ntk> detect_xor_maj( Ntk const& ntk, xor_maj_detection_params const& ps = {}, xor_maj_detection_stats* pst = nullptr )
+{
+  static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
+  static_assert( has_foreach_node_v<Ntk>, "Ntk does not implement the foreach_node method" );
+  static_assert( has_foreach_gate_v<Ntk>, "Ntk does not implement the foreach_gate method" );
+  static_assert( has_foreach_fanin_v<Ntk>, "Ntk does not implement the foreach_fanin method" );
+  static_assert( has_fanout_size_v<Ntk>, "Ntk does not implement the fanout_size method" );
+  static_assert( has_node_to_index_v<Ntk>, "Ntk does not implement the node_to_index method" );
+  static_assert( has_index_to_node_v<Ntk>, "Ntk does not implement the index_to_node method" );
+
+  xor_maj_detection_stats st;
+  detail::xor_maj_detection_impl<Ntk> p( ntk, ps, st );
+  const auto result = p.run();
+
+  if ( ps.verbose )
+  {
+    st.report();
+  }
+  if ( pst )
+  {
+    *pst = st;
+  }
+  return result;
+}
+
+} /* namespace mockturtle */
@@ -36,6 +36,7 @@
 #include "algorithms/akers_synthesis.hpp"
 #include "algorithms/cleanup.hpp"
 #include "algorithms/collapse_mapped.hpp"
+#include "algorithms/compiled_simulation.hpp"
 #include "algorithms/cut_enumeration.hpp"
 #include "algorithms/cut_rewriting.hpp"
 #include "algorithms/lut_mapping.hpp"
@@ -44,12 +45,17 @@
 #include "algorithms/node_resynthesis/akers.hpp"
 #include "algorithms/node_resynthesis/mig_npn.hpp"
 #include "algorithms/node_resynthesis/direct.hpp"
+#include "algorithms/node_resynthesis/exact.hpp"
 #include "algorithms/node_resynthesis/xag_npn.hpp"
 #include "algorithms/reconv_cut.hpp"
 #include "algorithms/refactoring.hpp"
 #include "algorithms/reubstitution.hpp"
+#include "algorithms/seq_rewriting.hpp"
 #include "algorithms/simulation.hpp"
 #include "algorithms/sta.hpp"
+#include "algorithms/switching_activity.hpp"
+#include "algorithms/window_rewriting.hpp"
+#include "algorithms/xor_maj_detection.hpp"
 #include "generators/arithmetic.hpp"
 #include "io/aiger_reader.hpp"
 #include "io/bench_reader.hpp"
@@ -62,6 +68,7 @@
 #include "networks/mig.hpp"
 #include "networks/sta.hpp"
 #include "utils/cuts.hpp"
+#include "utils/deadline.hpp"
 #include "utils/mixed_radix.hpp"
 #include "utils/node_map.hpp"
 #include "utils/progress_bar.hpp"
@@ -70,6 +77,8 @@
 #include "utils/union_find.hpp"
 #include "utils/mig_script.hpp"
 #include "utils/aig_script.hpp"
+#include "utils/xag_script.hpp"
+#include "views/compact_view.hpp"
 #include "views/cut_view.hpp"
 #include "views/depth_view.hpp"
 #include "views/immutable_view.hpp"
@@ -33,6 +33,7 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 #include <string>
 
 #include <ez/direct_iterator.hpp>
@@ -41,6 +42,8 @@
 
 #include "../traits.hpp"
 #include "detail/foreach.hpp"
+#include "detail/parent_index.hpp"
+#include "events.hpp"
 #include "storage.hpp"
 
 namespace mockturtle
@@ -398,15 +401,15 @@ public:
     node.children[0] = a;
     node.children[1] = b;
 
-    /* structural hashing */
-    const auto it = _storage->hash.find( node );
-    if ( it != _storage->hash.end() )
+    const auto index = _storage->nodes.size();
+
+    /* structural hashing, the lookup inserts the node if it is new */
+    const auto [it, inserted] = _storage->hash.insert( {node, index} );
+    if ( !inserted )
     {
       return {it->second, 0};
     }
 
-    const auto index = _storage->nodes.size();
-
     if ( index >= .9 * _storage->nodes.capacity() )
     {
       _storage->nodes.reserve( static_cast<uint64_t>( 3.1415f * index ) );
@@ -415,8 +418,6 @@ public:
 
     _storage->nodes.push_back( node );
 
-    _storage->hash[node] = index;
-
     /* increase ref-count to children */
     _storage->nodes[a.index].data[0].h1++;
     _storage->nodes[b.index].data[0].h1++;
@@ -688,9 +689,12 @@ public:
         void substitute_node( node const& old_node, signal const& new_signal )
         {
             /* find all parents from old_node */
-            for ( auto& n : _storage->nodes )
+            for ( auto idx = 1u; idx < _storage->nodes.size(); ++idx )
             {
-                for ( auto& child : n.children )
+                if ( is_ci( idx ) || is_dead( idx ) )
+                    continue; /* ignore CIs and deleted nodes */
+
+                for ( auto& child : _storage->nodes[idx].children )
                 {
                     if ( child.index == old_node )
                     {
@@ -723,9 +727,12 @@ public:
         void substitute_node_part( node const& old_node, signal const& new_signal )
         {
             /* find all parents from old_node */
-            for ( auto& n : _storage->nodes )
+            for ( auto idx = 1u; idx < _storage->nodes.size(); ++idx )
             {
-                for ( auto& child : n.children )
+                if ( is_ci( idx ) || is_dead( idx ) )
+                    continue; /* ignore CIs and deleted nodes */
+
+                for ( auto& child : _storage->nodes[idx].children )
                 {
                     if ( child.index == old_node )
                     {
@@ -754,6 +761,83 @@ public:
             // reset fan-in of old node
             _storage->nodes[old_node].data[0].h1 = 0;
         }
+
+        /*! \brief Applies a batch of substitutions in one sweep.
+         *
+         * The parent index is built once for the whole batch.  `substitutions`
+         * is any range of (node, signal) pairs, e.g., a `std::unordered_map`;
+         * entries are applied in iteration order, exactly as if
+         * `substitute_node` had been called for each of them.
+         */
+        template<class Substitutions>
+        void substitute_nodes( Substitutions const& substitutions )
+        {
+            auto index = compute_parent_index();
+            for ( auto const& [old_node, new_signal] : substitutions )
+            {
+                substitute_node_in_index( index, old_node, new_signal );
+            }
+        }
+
+        detail::parent_index<node> compute_parent_index() const
+        {
+            detail::parent_index<node> index( _storage->nodes.size() );
+            for ( auto idx = 1u; idx < _storage->nodes.size(); ++idx )
+            {
+                if ( is_ci( idx ) || is_dead( idx ) )
+                    continue; /* ignore CIs and deleted nodes */
+
+                for ( auto const& child : _storage->nodes[idx].children )
+                {
+                    index.add_parent( child.index, idx );
+                }
+            }
+            for ( auto const& output : _storage->outputs )
+            {
+                index.add_output( output.index );
+            }
+            return index;
+        }
+
+        void substitute_node_in_index( detail::parent_index<node>& index, node const& old_node, signal const& new_signal )
+        {
+            /* rewire all parents of old_node */
+            for ( auto const& p : index.take_parents( old_node ) )
+            {
+                for ( auto& child : _storage->nodes[p].children )
+                {
+                    if ( child.index == old_node )
+                    {
+                        child.index = new_signal.index;
+                        child.weight ^= new_signal.complement;
+
+                        // increment fan-in of new node
+                        _storage->nodes[new_signal.index].data[0].h1++;
+                    }
+                }
+                index.add_parent( new_signal.index, p );
+            }
+
+            /* check outputs */
+            if ( index.has_outputs( old_node ) )
+            {
+                for ( auto& output : _storage->outputs )
+                {
+                    if ( output.index == old_node )
+                    {
+                        output.index = new_signal.index;
+                        output.weight ^= new_signal.complement;
+
+                        // increment fan-in of new node
+                        _storage->nodes[new_signal.index].data[0].h1++;
+                    }
+                }
+                index.move_outputs( old_node, new_signal.index );
+            }
+
+            // reset fan-in of old node
+            _storage->nodes[old_node].data[0].h1 = 0;
+        }
 #pragma endregion
 
 #pragma region Structural properties
@@ -0,0 +1,96 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file parent_index.hpp
+  \brief Parent lookup used by node substitution
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace mockturtle::detail
+{
+
+/*! \brief Maps every node to the gates and outputs that reference it.
+ *
+ * The index is built once before a batch of substitutions and then kept
+ * up to date by the substitution itself, so every replacement only visits
+ * the actual fanout of the replaced node instead of the whole storage.
+ * Entries may become stale when a parent is rewritten; callers must check
+ * that the parent still references the node.
+ */
+template<typename Node>
+class parent_index
+{
+public:
+  explicit parent_index( std::size_t size )
+      : _parents( size ),
+        _output_refs( size, 0u )
+  {
+  }
+
+  void add_parent( Node const& child, Node const& parent )
+  {
+    _parents[child].push_back( parent );
+  }
+
+  void add_output( Node const& n )
+  {
+    ++_output_refs[n];
+  }
+
+  /*! \brief Removes and returns the parents of `n` in ascending order. */
+  std::vector<Node> take_parents( Node const& n )
+  {
+    std::vector<Node> parents;
+    parents.swap( _parents[n] );
+    std::sort( parents.begin(), parents.end() );
+    parents.erase( std::unique( parents.begin(), parents.end() ), parents.end() );
+    return parents;
+  }
+
+  bool has_outputs( Node const& n ) const
+  {
+    return _output_refs[n] != 0u;
+  }
+
+  void move_outputs( Node const& from, Node const& to )
+  {
+    if ( from == to )
+      return;
+    _output_refs[to] += _output_refs[from];
+    _output_refs[from] = 0u;
+  }
+
+private:
+  std::vector<std::vector<Node>> _parents;
+  std::vector<uint32_t> _output_refs;
+};
+
+} /* namespace mockturtle::detail */
@@ -42,7 +42,11 @@
 #include <kitty/constructors.hpp>
 #include <kitty/dynamic_truth_table.hpp>
 
+#include <array>
+#include <iterator>
 #include <memory>
+#include <type_traits>
+#include <vector>
 
 namespace mockturtle
 {
@@ -54,13 +58,16 @@ struct klut_storage_data
 };
 
 /*! \brief k-LUT node
+ *
+ * Up to 8 fan-ins are stored in the node, larger LUTs allocate their fan-in
+ * list on the heap.
  *
  * `data[0].h1`: Fan-out size
  * `data[0].h2`: Application-specific value
  * `data[1].h1`: Function literal in truth table cache
  * `data[2].h2`: Visited flags
  */
-struct klut_storage_node : mixed_fanin_node<2>
+struct klut_storage_node : small_fanin_node<2, 8u>
 {
   bool operator==( klut_storage_node const& other ) const
   {
@@ -80,6 +87,9 @@ public:
   static constexpr auto min_fanin_size = 1;
   static constexpr auto max_fanin_size = 32;
 
+  /*! \brief Largest fan-in whose function `compute` evaluates word by word. */
+  static constexpr uint32_t max_word_fanin_size = 8u;
+
   using base_type = klut_network;
   using storage = std::shared_ptr<klut_storage>;
   using node = uint64_t;
@@ -192,18 +202,20 @@ public:
   signal _create_node( std::vector<signal> const& children, uint32_t literal )
   {
     storage::element_type::node_type node;
+    node.children.reserve( children.size() );
     std::copy( children.begin(), children.end(), std::back_inserter( node.children ) );
     node.data[1].h1 = literal;
 
-    const auto it = _storage->hash.find( node );
-    if ( it != _storage->hash.end() )
+    const auto index = _storage->nodes.size();
+
+    /* structural hashing, the lookup inserts the node if it is new */
+    const auto [it, inserted] = _storage->hash.insert( {node, index} );
+    if ( !inserted )
     {
       return it->second;
     }
 
-    const auto index = _storage->nodes.size();
-    _storage->nodes.push_back( node );
-    _storage->hash[node] = index;
+    _storage->nodes.push_back( std::move( node ) );
 
     /* increase ref-count to children */
     for ( auto c : children )
@@ -381,7 +393,7 @@ public:
     if ( n == 0 || is_pi( n ) )
       return;
 
-    using IteratorType = decltype( _storage->outputs.begin() );
+    using IteratorType = decltype( _storage->nodes[n].children.begin() );
     detail::foreach_element_transform<IteratorType, uint32_t>( _storage->nodes[n].children.begin(), _storage->nodes[n].children.end(), []( auto f ) { return f.index; }, fn );
   }
 #pragma endregion
@@ -397,22 +409,72 @@ public:
       index <<= 1;
       index ^= *begin++ ? 1 : 0;
     }
-    return kitty::get_bit( _storage->data.cache[_storage->nodes[n].data[1].h1], index );
+    const auto literal = _storage->nodes[n].data[1].h1;
+    return kitty::get_bit( _storage->data.cache.normal( literal ), index ) != ( literal & 1 );
   }
 
   template<typename Iterator>
   iterates_over_truth_table_t<Iterator>
   compute( node const& n, Iterator begin, Iterator end ) const
   {
+    using TT = typename Iterator::value_type;
+
     const auto nfanin = _storage->nodes[n].children.size();
-    std::vector<typename Iterator::value_type> tts( begin, end );
+    const auto literal = _storage->nodes[n].data[1].h1;
+    auto const& gate_tt = _storage->data.cache.normal( literal );
 
     assert( nfanin != 0 );
-    assert( tts.size() == nfanin );
+    assert( static_cast<std::size_t>( std::distance( begin, end ) ) == nfanin );
+
+    if constexpr ( std::is_reference_v<typename std::iterator_traits<Iterator>::reference> )
+    {
+      if ( nfanin <= max_word_fanin_size )
+      {
+        /* LUTs that fit into a word are evaluated 64 patterns at a time, as a
+           multiplexer tree over the LUT's bits with the fanins as select
+           inputs; this needs neither copies of the fanin truth tables nor
+           temporary allocations */
+        std::array<TT const*, max_word_fanin_size> tts;
+        for ( auto j = 0u; j < nfanin; ++j, ++begin )
+        {
+          tts[j] = &*begin;
+        }
+
+        std::array<uint64_t, 1u << max_word_fanin_size> leaves;
+        const auto num_leaves = 1u << nfanin;
+        for ( auto p = 0u; p < num_leaves; ++p )
+        {
+          leaves[p] = ( kitty::get_bit( gate_tt, p ) != ( literal & 1 ) ) ? ~UINT64_C( 0 ) : UINT64_C( 0 );
+        }
+
+        /* resulting truth table has the same size as any of the children */
+        auto result = tts[0]->construct();
+        auto out = result.begin();
+        std::array<uint64_t, 1u << max_word_fanin_size> mux;
+        for ( auto w = 0u; w < static_cast<uint32_t>( result.num_blocks() ); ++w )
+        {
+          std::copy( leaves.begin(), leaves.begin() + num_leaves, mux.begin() );
+          for ( auto j = 0u, half = num_leaves >> 1; j < nfanin; ++j, half >>= 1 )
+          {
+            const auto x = *( tts[j]->cbegin() + w );
+            for ( auto q = 0u; q < half; ++q )
+            {
+              mux[q] = ( x & mux[2 * q + 1] ) | ( ~x & mux[2 * q] );
+            }
+          }
+          *out++ = mux[0];
+        }
+        result.mask_bits();
+
+        return result;
+      }
+    }
+
+    std::vector<TT> tts( begin, end );
 
     /* resulting truth table has the same size as any of the children */
     auto result = tts.front().construct();
-    const auto gate_tt = _storage->data.cache[_storage->nodes[n].data[1].h1];
+    const auto gate_tt_copy = _storage->data.cache[literal];
 
     for ( auto i = 0u; i < result.num_bits(); ++i )
     {
@@ -421,7 +483,7 @@ public:
       {
         pattern |= kitty::get_bit( tts[j], i ) << j;
       }
-      if ( kitty::get_bit( gate_tt, pattern ) )
+      if ( kitty::get_bit( gate_tt_copy, pattern ) )
       {
         kitty::set_bit( result, i );
       }
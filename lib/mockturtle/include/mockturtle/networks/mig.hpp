@@ -44,6 +44,7 @@
 #include "../traits.hpp"
 #include "../utils/algorithm.hpp"
 #include "detail/foreach.hpp"
+#include "detail/parent_index.hpp"
 #include "events.hpp"
 #include "storage.hpp"
 
@@ -330,15 +331,15 @@ public:
     node.children[1] = b;
     node.children[2] = c;
 
-    /* structural hashing */
-    const auto it = _storage->hash.find( node );
-    if ( it != _storage->hash.end() )
+    const auto index = _storage->nodes.size();
+
+    /* structural hashing, the lookup inserts the node if it is new */
+    const auto [it, inserted] = _storage->hash.insert( {node, index} );
+    if ( !inserted )
     {
       return {it->second, node_complement};
     }
 
-    const auto index = _storage->nodes.size();
-
     if ( index >= .9 * _storage->nodes.capacity() )
     {
       _storage->nodes.reserve( static_cast<uint64_t>( 3.1415f * index ) );
@@ -347,8 +348,6 @@ public:
 
     _storage->nodes.push_back( node );
 
-    _storage->hash[node] = index;
-
     /* increase ref-count to children */
     _storage->nodes[a.index].data[0].h1++;
     _storage->nodes[b.index].data[0].h1++;
@@ -738,8 +737,8 @@ public:
 
       for ( auto idx = 1u; idx < _storage->nodes.size(); ++idx )
       {
-        if ( is_pi( idx ) )
-          continue; /* ignore PIs */
+        if ( is_ci( idx ) || is_dead( idx ) )
+          continue; /* ignore CIs and deleted nodes */
 
         if ( const auto repl = replace_in_node( idx, _old, _new ); repl )
         {
@@ -767,8 +766,8 @@ public:
 
       for ( auto idx = 1u; idx < _storage->nodes.size(); ++idx )
       {
-        if ( is_pi( idx ) )
-          continue; /* ignore PIs */
+        if ( is_ci( idx ) || is_dead( idx ) )
+          continue; /* ignore CIs and deleted nodes */
 
         if ( const auto repl = replace_in_node_part( idx, _old, _new ); repl )
         {
@@ -784,6 +783,82 @@ public:
     }
   }
 
+
+  /*! \brief Applies a batch of substitutions in one sweep.
+   *
+   * The parent index is built once for the whole batch.  `substitutions`
+   * is any range of (node, signal) pairs, e.g., a `std::unordered_map`;
+   * entries are applied in iteration order, exactly as if
+   * `substitute_node` had been called for each of them.
+   */
+  template<class Substitutions>
+  void substitute_nodes( Substitutions const& substitutions )
+  {
+    auto index = compute_parent_index();
+    for ( auto const& [old_node, new_signal] : substitutions )
+    {
+      substitute_node_in_index( index, old_node, new_signal, false );
+    }
+  }
+
+  detail::parent_index<node> compute_parent_index() const
+  {
+    detail::parent_index<node> index( _storage->nodes.size() );
+    for ( auto idx = 1u; idx < _storage->nodes.size(); ++idx )
+    {
+      if ( is_ci( idx ) || is_dead( idx ) )
+        continue; /* ignore CIs and deleted nodes */
+
+      for ( auto const& child : _storage->nodes[idx].children )
+      {
+        index.add_parent( child.index, idx );
+      }
+    }
+    for ( auto const& output : _storage->outputs )
+    {
+      index.add_output( output.index );
+    }
+    return index;
+  }
+
+  void substitute_node_in_index( detail::parent_index<node>& index, node const& old_node, signal const& new_signal, bool part )
+  {
+    std::stack<std::pair<node, signal>> to_substitute;
+    to_substitute.push( {old_node, new_signal} );
+
+    while ( !to_substitute.empty() )
+    {
+      const auto [_old, _new] = to_substitute.top();
+      to_substitute.pop();
+
+      for ( auto const& p : index.take_parents( _old ) )
+      {
+        if ( is_dead( p ) )
+          continue;
+
+        const auto repl = part ? replace_in_node_part( p, _old, _new ) : replace_in_node( p, _old, _new );
+        if ( repl )
+        {
+          to_substitute.push( *repl );
+        }
+        else
+        {
+          index.add_parent( _new.index, p );
+        }
+      }
+
+      /* check outputs */
+      if ( index.has_outputs( _old ) )
+      {
+        replace_in_outputs( _old, _new );
+        index.move_outputs( _old, _new.index );
+      }
+
+      // reset fan-in of old node
+      take_out_node( _old );
+    }
+  }
+
   void substitute_node_of_parents( std::vector<node> const& parents, node const& old_node, signal const& new_signal )
   {
     for ( auto& p : parents )
@@ -13,6 +13,9 @@ public:
     void set_lib_path(const std::string &lib){
         this->timer.read_celllib(lib,std::nullopt);
     }
+    void set_lib_cache(const std::string &dir){
+        this->timer.set_celllib_cache(dir);
+    }
     void set_netlist_path(const std::string &netlist){
         this->timer.read_verilog(netlist);
     }
@@ -34,7 +34,9 @@
 #pragma once
 
 #include<map>
+#include <algorithm>
 #include <array>
+#include <cstdint>
 #include <iostream>
 #include <unordered_map>
 #include <vector>
@@ -131,6 +133,153 @@ struct mixed_fanin_node
   }
 };
 
+/*! \brief Fan-in list that keeps up to `Inline` children inside the node.
+ *
+ * Longer lists are moved to the heap.  Nodes with small fan-in, such as the
+ * LUTs of a k-LUT network for k <= `Inline`, are then created, hashed, and
+ * copied without any allocation.
+ */
+template<typename Pointer, uint32_t Inline>
+class small_fanin_vector
+{
+public:
+  using value_type = Pointer;
+  using iterator = Pointer*;
+  using const_iterator = Pointer const*;
+
+  small_fanin_vector() {}
+
+  small_fanin_vector( small_fanin_vector const& other )
+  {
+    reserve( other._size );
+    std::copy( other.begin(), other.end(), begin() );
+    _size = other._size;
+  }
+
+  small_fanin_vector( small_fanin_vector&& other ) noexcept
+  {
+    _steal( other );
+  }
+
+  small_fanin_vector& operator=( small_fanin_vector const& other )
+  {
+    if ( this != &other )
+    {
+      _size = 0u;
+      reserve( other._size );
+      std::copy( other.begin(), other.end(), begin() );
+      _size = other._size;
+    }
+    return *this;
+  }
+
+  small_fanin_vector& operator=( small_fanin_vector&& other ) noexcept
+  {
+    if ( this != &other )
+    {
+      _release();
+      _steal( other );
+    }
+    return *this;
+  }
+
+  ~small_fanin_vector()
+  {
+    _release();
+  }
+
+  iterator begin() { return _is_inline() ? _inline : _heap; }
+  iterator end() { return begin() + _size; }
+  const_iterator begin() const { return _is_inline() ? _inline : _heap; }
+  const_iterator end() const { return begin() + _size; }
+
+  std::size_t size() const { return _size; }
+  bool empty() const { return _size == 0u; }
+
+  Pointer& operator[]( std::size_t i ) { return begin()[i]; }
+  Pointer const& operator[]( std::size_t i ) const { return begin()[i]; }
+
+  void clear() { _size = 0u; }
+
+  void reserve( std::size_t capacity )
+  {
+    if ( capacity <= _capacity )
+    {
+      return;
+    }
+    auto data = new Pointer[capacity];
+    std::copy( begin(), end(), data );
+    _release();
+    _heap = data;
+    _capacity = static_cast<uint32_t>( capacity );
+  }
+
+  void push_back( Pointer const& p )
+  {
+    if ( _size == _capacity )
+    {
+      reserve( 2u * _capacity );
+    }
+    begin()[_size++] = p;
+  }
+
+  bool operator==( small_fanin_vector const& other ) const
+  {
+    return _size == other._size && std::equal( begin(), end(), other.begin() );
+  }
+
+private:
+  bool _is_inline() const { return _capacity == Inline; }
+
+  void _release()
+  {
+    if ( !_is_inline() )
+    {
+      delete[] _heap;
+      _capacity = Inline;
+    }
+  }
+
+  void _steal( small_fanin_vector& other )
+  {
+    if ( other._is_inline() )
+    {
+      std::copy( other.begin(), other.end(), _inline );
+    }
+    else
+    {
+      _heap = other._heap;
+      _capacity = other._capacity;
+      other._capacity = Inline;
+    }
+    _size = other._size;
+    other._size = 0u;
+  }
+
+  uint32_t _size{0u};
+  uint32_t _capacity{Inline};
+  union
+  {
+    Pointer _inline[Inline];
+    Pointer* _heap;
+  };
+};
+
+/*! \brief Node with a variable number of children, of which `Inline` are stored in place */
+template<int Size = 0, uint32_t Inline = 8u, int PointerFieldSize = 0>
+struct small_fanin_node
+{
+  using pointer_type = node_pointer<PointerFieldSize>;
+
+  small_fanin_vector<pointer_type, Inline> children;
+  std::array<cauint64_t, Size> data;
+
+  bool operator==( small_fanin_node<Size, Inline, PointerFieldSize> const& other ) const
+  {
+    return children == other.children;
+  }
+};
+
 /*! \brief Hash function for 64-bit word */
 inline std::size_t hash_block( uint64_t word )
 {
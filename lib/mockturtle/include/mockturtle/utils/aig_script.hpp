@@ -16,59 +16,78 @@ namespace mockturtle{
             mockturtle::xag_npn_resynthesis<mockturtle::aig_network> resyn;
             mockturtle::cut_rewriting_params ps;
             ps.cut_enumeration_ps.cut_size = 4;
+            ps.time_limit = time_limit;
 
             mockturtle::cut_rewriting(aig, resyn, ps);
             // std::cout << "done cut rewriting\n";
             aig = mockturtle::cleanup_dangling(aig);
             // std::cout << "done cleaning up\n";
+            if(time_limit.expired())
+                return aig;
             mockturtle::cut_rewriting(aig, resyn, ps);
             aig = mockturtle::cleanup_dangling(aig);
 
             // std::cout << "2nd round area recovering " << std::endl;
 
             // AREA RECOVERING
+            if(time_limit.expired())
+                return aig;
             mockturtle::cut_rewriting(aig, resyn, ps);
             aig = mockturtle::cleanup_dangling(aig);
 
             // std::cout << "2nd round depth optimization" << std::endl;
 
             //DEPTH REWRITING
+            if(time_limit.expired())
+                return aig;
             mockturtle::cut_rewriting(aig, resyn, ps);
             aig = mockturtle::cleanup_dangling(aig);
 
             // std::cout << "3rd round area recovering" << std::endl;
 
             // AREA RECOVERING
+            if(time_limit.expired())
+                return aig;
             mockturtle::cut_rewriting(aig, resyn, ps);
             aig = mockturtle::cleanup_dangling(aig);
 
             // std::cout << "4th round area recovering" << std::endl;
 
             // AREA RECOVERING
+            if(time_limit.expired())
+                return aig;
             mockturtle::cut_rewriting(aig, resyn, ps);
             aig = mockturtle::cleanup_dangling(aig);
 
             // std::cout << "3rd round depth optimization" << std::endl;
 
             //DEPTH REWRITING
+            if(time_limit.expired())
+                return aig;
             mockturtle::cut_rewriting(aig, resyn, ps);
             aig = mockturtle::cleanup_dangling(aig);
 
             // std::cout << "5th round area recovering" << std::endl;
 
             // AREA RECOVERING
+            if(time_limit.expired())
+                return aig;
             mockturtle::cut_rewriting(aig, resyn, ps);
             aig = mockturtle::cleanup_dangling(aig);
 
             // std::cout << "6th round area recovering" << std::endl;
 
             // AREA RECOVERING
+            if(time_limit.expired())
+                return aig;
             mockturtle::cut_rewriting(aig, resyn, ps);
             aig = mockturtle::cleanup_dangling(aig);
 
             // std::cout << "Final depth optimization" << std::endl;
 
             //DEPTH REWRITING
+            if(time_limit.expired())
+                return aig;
             mockturtle::cut_rewriting(aig, resyn, ps);
             aig = mockturtle::cleanup_dangling(aig);
 
@@ -76,5 +95,8 @@ namespace mockturtle{
 
             return aig;
         }
+
+        //the running pass stops early and the remaining passes are skipped once this has passed
+        mockturtle::deadline time_limit{};
     };
 }
\ No newline at end of file
@@ -0,0 +1,86 @@
+/*!
+  \file deadline.hpp
+  \brief Cooperative time limits for optimization passes
+
+  Passes that accept a deadline check it between units of work and stop
+  early once it has passed, leaving a valid, partially optimized network.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+
+namespace mockturtle
+{
+
+/*! \brief Point in time after which a pass should stop.
+ *
+ * A default constructed deadline never expires.
+ *
+   \verbatim embed:rst
+
+   Example
+
+   .. code-block:: c++
+
+      cut_rewriting_params ps;
+      ps.time_limit = deadline::after( 2.5 );
+      cut_rewriting( aig, resyn, ps );
+   \endverbatim
+ */
+class deadline
+{
+public:
+  using clock = std::chrono::steady_clock;
+
+  deadline() = default;
+
+  explicit deadline( clock::time_point end )
+      : _end( end )
+  {
+  }
+
+  /*! \brief Deadline the given number of seconds from now. */
+  static deadline after( double seconds )
+  {
+    /* also avoids overflowing the time point for infinite budgets */
+    if ( !( seconds < 1e9 ) )
+    {
+      return deadline();
+    }
+    return deadline( clock::now() + std::chrono::duration_cast<clock::duration>( std::chrono::duration<double>( seconds ) ) );
+  }
+
+  bool is_set() const
+  {
+    return _end != clock::time_point::max();
+  }
+
+  bool expired() const
+  {
+    return is_set() && clock::now() >= _end;
+  }
+
+  /*! \brief Seconds left, infinity if the deadline is not set. */
+  double remaining() const
+  {
+    if ( !is_set() )
+    {
+      return std::numeric_limits<double>::infinity();
+    }
+    return std::max( 0.0, std::chrono::duration<double>( _end - clock::now() ).count() );
+  }
+
+  /*! \brief The earlier of both deadlines. */
+  deadline earliest( deadline const& other ) const
+  {
+    return deadline( std::min( _end, other._end ) );
+  }
+
+private:
+  clock::time_point _end{clock::time_point::max()};
+};
+
+} /* namespace mockturtle */
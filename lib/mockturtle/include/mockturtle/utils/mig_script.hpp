@@ -16,6 +16,7 @@ namespace mockturtle{
 
             mockturtle::mig_algebraic_depth_rewriting_params pm;
             pm.selective;
+            pm.time_limit = time_limit;
 
             // std::cout << "1st round depth optimization " << std::endl;
 
@@ -30,13 +31,18 @@ namespace mockturtle{
             mockturtle::cut_rewriting_params ps;
 
             ps.cut_enumeration_ps.cut_size = 4;
+            ps.time_limit = time_limit;
 
+            if(time_limit.expired())
+                return mig;
             mockturtle::cut_rewriting(mig, resyn, ps);
             mig = mockturtle::cleanup_dangling( mig );
 
             // std::cout << "2nd round area recovering " << std::endl;
 
             // AREA RECOVERING
+            if(time_limit.expired())
+                return mig;
             mockturtle::cut_rewriting(mig, resyn, ps);
             mig = mockturtle::cleanup_dangling( mig );
 
@@ -45,18 +51,24 @@ namespace mockturtle{
             //DEPTH REWRITING
             mockturtle::depth_view mig_depth1{mig};
 
+            if(time_limit.expired())
+                return mig;
             mockturtle::mig_algebraic_depth_rewriting(mig_depth1, pm);
             mig = mockturtle::cleanup_dangling( mig );
 
             // std::cout << "3rd round area recovering" << std::endl;
 
             // AREA RECOVERING
+            if(time_limit.expired())
+                return mig;
             mockturtle::cut_rewriting(mig, resyn, ps);
             mig = mockturtle::cleanup_dangling( mig );
 
             // std::cout << "4th round area recovering" << std::endl;
 
             // AREA RECOVERING
+            if(time_limit.expired())
+                return mig;
             mockturtle::cut_rewriting(mig, resyn, ps);
             mig = mockturtle::cleanup_dangling( mig );
 
@@ -65,18 +77,24 @@ namespace mockturtle{
             //DEPTH REWRITING
             mockturtle::depth_view mig_depth2{mig};
 
+            if(time_limit.expired())
+                return mig;
             mockturtle::mig_algebraic_depth_rewriting(mig_depth2, pm);
             mig = mockturtle::cleanup_dangling( mig );
 
             // std::cout << "5th round area recovering" << std::endl;
 
             // AREA RECOVERING
+            if(time_limit.expired())
+                return mig;
             mockturtle::cut_rewriting(mig, resyn, ps);
             mig = mockturtle::cleanup_dangling( mig );
 
             // std::cout << "6th round area recovering" << std::endl;
 
             // AREA RECOVERING
+            if(time_limit.expired())
+                return mig;
             mockturtle::cut_rewriting(mig, resyn, ps);
             mig = mockturtle::cleanup_dangling( mig );
 
@@ -87,6 +105,8 @@ namespace mockturtle{
 
             // std::cout << "Network Optimized" << std::endl;
 
+            if(time_limit.expired())
+                return mig;
             mockturtle::mig_algebraic_depth_rewriting(mig_depth3, pm);
             mig = mockturtle::cleanup_dangling( mig );
 
@@ -94,5 +114,8 @@ namespace mockturtle{
 
             return mig;
         }
+
+        //the running pass stops early and the remaining passes are skipped once this has passed
+        mockturtle::deadline time_limit{};
     };
 }
\ No newline at end of file
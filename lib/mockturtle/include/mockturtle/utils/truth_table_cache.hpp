@@ -32,8 +32,12 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cstdint>
+#include <unordered_map>
 #include <vector>
 
+#include <kitty/hash.hpp>
 #include <kitty/operations.hpp>
 #include <kitty/operators.hpp>
 
@@ -103,17 +107,27 @@ public:
    */
   TT operator[]( uint32_t lit ) const;
 
+  /*! \brief Returns the stored normal truth table of a literal without copying it.
+   *
+   * The function of `lit` is the complement of the result if `lit` is odd.
+   */
+  TT const& normal( uint32_t lit ) const { return _data[lit >> 1]; }
+
   /*! \brief Returns number of normalized truth tables in the cache. */
   auto size() const { return _data.size(); }
 
 private:
   std::vector<TT> _data;
+
+  /* position of each truth table in _data */
+  std::unordered_map<TT, uint32_t, kitty::hash<TT>> _index;
 };
 
 template<typename TT>
 truth_table_cache<TT>::truth_table_cache( std::size_t capacity )
 {
   _data.reserve( capacity );
+  _index.reserve( capacity );
 }
 
 template<typename TT>
@@ -124,20 +138,22 @@ uint32_t truth_table_cache<TT>::insert( TT tt )
   if ( kitty::get_bit( tt, 0 ) )
   {
     is_compl = 1;
-    tt = ~tt;
+    std::transform( tt.begin(), tt.end(), tt.begin(), []( auto word ) { return ~word; } );
+    tt.mask_bits();
   }
 
   /* is truth table already in cache? */
-  const auto it = std::find( _data.begin(), _data.end(), tt );
-  if ( it != _data.end() )
+  const auto it = _index.find( tt );
+  if ( it != _index.end() )
   {
-    return 2 * std::distance( _data.begin(), it ) + is_compl;
+    return 2 * it->second + is_compl;
   }
 
   /* add truth table to end of cache */
-  const auto index = 2 * _data.size() + is_compl;
-  _data.push_back( tt );
-  return index;
+  const auto index = static_cast<uint32_t>( _data.size() );
+  _index.emplace( tt, index );
+  _data.push_back( std::move( tt ) );
+  return 2 * index + is_compl;
 }
 
 template<typename TT>
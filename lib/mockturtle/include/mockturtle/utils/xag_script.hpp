@@ -0,0 +1,57 @@
+#pragma once
+
+#include <kitty/kitty.hpp>
+#include <mockturtle/mockturtle.hpp>
+#include <mockturtle/networks/xag.hpp>
+#include <mockturtle/algorithms/node_resynthesis/xag_npn.hpp>
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <fmt/format.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+namespace mockturtle{
+    class xag_script{
+    public:
+        mockturtle::xag_network run(mockturtle::xag_network& xag){
+            //XOR gates are kept as single nodes, so the NPN database is used natively
+            mockturtle::xag_npn_resynthesis<mockturtle::xag_network> resyn;
+            mockturtle::cut_rewriting_params ps;
+            ps.cut_enumeration_ps.cut_size = 4;
+            ps.time_limit = time_limit;
+
+            // REWRITING
+            mockturtle::cut_rewriting(xag, resyn, ps);
+            xag = mockturtle::cleanup_dangling(xag);
+
+            // RESTRUCTURING, zero-gain replacements move the network out of the local minimum
+            if(time_limit.expired())
+                return xag;
+            auto zero_gain_ps = ps;
+            zero_gain_ps.allow_zero_gain = true;
+            mockturtle::cut_rewriting(xag, resyn, zero_gain_ps);
+            xag = mockturtle::cleanup_dangling(xag);
+
+            // REWRITING of the restructured network
+            if(time_limit.expired())
+                return xag;
+            mockturtle::cut_rewriting(xag, resyn, ps);
+            xag = mockturtle::cleanup_dangling(xag);
+
+            // GREEDY REWRITING, takes the best cut of every node instead of a weighted cover
+            if(time_limit.expired())
+                return xag;
+            auto greedy_ps = ps;
+            greedy_ps.candidate_selection_strategy = mockturtle::cut_rewriting_params::greedy;
+            mockturtle::cut_rewriting(xag, resyn, greedy_ps);
+            xag = mockturtle::cleanup_dangling(xag);
+
+            return xag;
+        }
+
+        //the running pass stops early and the remaining passes are skipped once this has passed
+        mockturtle::deadline time_limit{};
+    };
+}
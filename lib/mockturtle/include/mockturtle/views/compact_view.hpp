@@ -0,0 +1,538 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file compact_view.hpp
+  \brief Structure-of-arrays copy of a network for fast traversal
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include <kitty/dynamic_truth_table.hpp>
+#include <kitty/operations.hpp>
+#include <kitty/operators.hpp>
+
+#include "../networks/detail/foreach.hpp"
+#include "../traits.hpp"
+#include "immutable_view.hpp"
+
+namespace mockturtle
+{
+
+/*! \brief Traverses a network through compact, separate arrays.
+ *
+ * The nodes of AIGs, XAGs and MIGs store their fanins together with the
+ * fanout counter, the value and the visited flag.  Traversals that only
+ * need one of these fields load whole nodes into the cache.  This view
+ * copies the structure *on construction* into separate arrays: the fanins
+ * as 32-bit literals (`index << 1 | complement`), one byte with the gate
+ * type, and the levels, values and visited flags.
+ *
+ * `foreach_node` and `foreach_gate` visit the constants, the CIs and the
+ * gates reachable from the outputs in topological order.  If all fanins
+ * have smaller indexes than their gates, which holds, e.g., after
+ * `cleanup_dangling`, gates are visited by index, so that the arrays are
+ * read front to back; otherwise in depth-first order as in `topo_view`.
+ * `level` and `depth` are available as in `depth_view`.  The methods used by
+ * `simulate`, `cut_enumeration` and similar algorithms read only these
+ * arrays; the remaining methods are those of the network.  Values and
+ * visited flags are kept apart from the network, so that traversals on the
+ * view do not disturb marks on the network.
+ *
+ * Since the arrays are computed only once, this view disables changes to
+ * the network.  The network must have a fixed number of fanins and fewer
+ * than 2^31 nodes.
+ *
+ * **Required network functions:**
+ * - `size`
+ * - `get_node`
+ * - `get_constant`
+ * - `foreach_pi`
+ * - `foreach_po`
+ * - `foreach_fanin`
+ * - `is_constant`
+ * - `is_pi`
+ * - `is_ci`
+ * - `is_and`
+ * - `is_xor`
+ * - `is_maj`
+ *
+ * Example
+ *
+   \verbatim embed:rst
+   .. code-block:: c++
+      aig_network aig = ...;
+      compact_view compact{aig};
+      const auto tts = simulate<kitty::static_truth_table<8>>( compact, sim );
+      const auto cuts = cut_enumeration( compact );
+   \endverbatim
+ */
+template<typename Ntk>
+class compact_view : public immutable_view<Ntk>
+{
+public:
+  using storage = typename Ntk::storage;
+  using node = typename Ntk::node;
+  using signal = typename Ntk::signal;
+
+  static constexpr bool is_topologically_sorted = true;
+  static constexpr uint32_t fanin_count = Ntk::max_fanin_size;
+
+  explicit compact_view( Ntk const& ntk )
+      : immutable_view<Ntk>( ntk )
+  {
+    static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
+    static_assert( Ntk::min_fanin_size == Ntk::max_fanin_size, "Ntk does not have a fixed number of fanins" );
+    static_assert( has_size_v<Ntk>, "Ntk does not implement the size method" );
+    static_assert( has_get_node_v<Ntk>, "Ntk does not implement the get_node method" );
+    static_assert( has_get_constant_v<Ntk>, "Ntk does not implement the get_constant method" );
+    static_assert( has_foreach_pi_v<Ntk>, "Ntk does not implement the foreach_pi method" );
+    static_assert( has_foreach_po_v<Ntk>, "Ntk does not implement the foreach_po method" );
+    static_assert( has_foreach_fanin_v<Ntk>, "Ntk does not implement the foreach_fanin method" );
+    static_assert( has_is_constant_v<Ntk>, "Ntk does not implement the is_constant method" );
+    static_assert( has_is_pi_v<Ntk>, "Ntk does not implement the is_pi method" );
+    static_assert( has_is_ci_v<Ntk>, "Ntk does not implement the is_ci method" );
+    static_assert( has_is_and_v<Ntk>, "Ntk does not implement the is_and method" );
+    static_assert( has_is_xor_v<Ntk>, "Ntk does not implement the is_xor method" );
+    static_assert( has_is_maj_v<Ntk>, "Ntk does not implement the is_maj method" );
+
+    update();
+  }
+
+  /*! \brief Copies the structure of the network again. */
+  void update()
+  {
+    const auto size = Ntk::size();
+    assert( size < ( UINT32_C( 1 ) << 31 ) );
+
+    _kinds.assign( size, kind_constant );
+    _literals.assign( size * fanin_count, 0u );
+    _values.assign( size, 0u );
+    _visited.assign( size, 0u );
+    _levels.assign( size, 0u );
+    _order.clear();
+    _num_leaves = 0u;
+    _depth = 0u;
+
+    /* most networks, e.g., results of `cleanup_dangling`, are already sorted by index */
+    bool sorted = true;
+    for ( auto n = 0u; n < size; ++n )
+    {
+      if ( Ntk::is_constant( n ) )
+      {
+        _kinds[n] = kind_constant;
+      }
+      else if ( Ntk::is_pi( n ) )
+      {
+        _kinds[n] = kind_pi;
+      }
+      else if ( Ntk::is_ci( n ) )
+      {
+        _kinds[n] = kind_ro;
+      }
+      else
+      {
+        _kinds[n] = Ntk::is_maj( n ) ? kind_maj : ( Ntk::is_xor( n ) ? kind_xor : kind_and );
+        assert( Ntk::is_maj( n ) || Ntk::is_xor( n ) || Ntk::is_and( n ) );
+        Ntk::foreach_fanin( n, [&]( auto const& f, auto i ) {
+          const auto child = Ntk::node_to_index( Ntk::get_node( f ) );
+          sorted = sorted && child < n;
+          _literals[n * fanin_count + i] = static_cast<uint32_t>( child << 1 | ( Ntk::is_complemented( f ) ? 1u : 0u ) );
+        } );
+      }
+    }
+
+    /* constants and CIs first, in the order of the network */
+    _order.reserve( size );
+    const auto c0 = Ntk::get_node( Ntk::get_constant( false ) );
+    _order.push_back( c0 );
+    _values[c0] = 2u;
+    if ( const auto c1 = Ntk::get_node( Ntk::get_constant( true ) ); _values[c1] != 2u )
+    {
+      _order.push_back( c1 );
+      _values[c1] = 2u;
+    }
+    Ntk::foreach_ci( [&]( auto const& n ) {
+      if ( _values[n] != 2u )
+      {
+        _order.push_back( n );
+        _values[n] = 2u;
+      }
+    } );
+    _num_leaves = static_cast<uint32_t>( _order.size() );
+
+    if ( sorted )
+    {
+      collect_sorted();
+    }
+    else
+    {
+      collect_dfs();
+    }
+
+    Ntk::foreach_co( [&]( auto const& f ) {
+      _depth = std::max( _depth, _levels[Ntk::get_node( f )] );
+    } );
+
+    std::fill( _values.begin(), _values.end(), 0u );
+  }
+
+#pragma region Structural properties
+  bool is_constant( node const& n ) const
+  {
+    return _kinds[n] == kind_constant;
+  }
+
+  bool is_ci( node const& n ) const
+  {
+    return _kinds[n] == kind_pi || _kinds[n] == kind_ro;
+  }
+
+  bool is_pi( node const& n ) const
+  {
+    return _kinds[n] == kind_pi;
+  }
+
+  bool is_ro( node const& n ) const
+  {
+    return _kinds[n] == kind_ro;
+  }
+
+  bool is_and( node const& n ) const
+  {
+    return _kinds[n] == kind_and;
+  }
+
+  bool is_xor( node const& n ) const
+  {
+    return _kinds[n] == kind_xor;
+  }
+
+  bool is_maj( node const& n ) const
+  {
+    return _kinds[n] == kind_maj;
+  }
+
+  uint32_t fanin_size( node const& n ) const
+  {
+    return _kinds[n] >= kind_and ? fanin_count : 0u;
+  }
+
+  /*! \brief Number of gates reachable from the outputs. */
+  uint32_t num_reachable_gates() const
+  {
+    return static_cast<uint32_t>( _order.size() ) - _num_leaves;
+  }
+#pragma endregion
+
+#pragma region Functional properties
+  kitty::dynamic_truth_table node_function( node const& n ) const
+  {
+    kitty::dynamic_truth_table tt( fanin_count );
+    switch ( _kinds[n] )
+    {
+    case kind_maj:
+      tt._bits[0] = 0xe8;
+      break;
+    case kind_xor:
+      tt._bits[0] = 0x6;
+      break;
+    default:
+      tt._bits[0] = 0x8;
+      break;
+    }
+    return tt;
+  }
+#pragma endregion
+
+#pragma region Node and signal iterators
+  /*! \brief Visits constants, CIs and reachable gates in topological order. */
+  template<typename Fn>
+  void foreach_node( Fn&& fn ) const
+  {
+    detail::foreach_element( _order.begin(), _order.end(), fn );
+  }
+
+  /*! \brief Visits the reachable gates in topological order. */
+  template<typename Fn>
+  void foreach_gate( Fn&& fn ) const
+  {
+    detail::foreach_element( _order.begin() + _num_leaves, _order.end(), fn );
+  }
+
+  template<typename Fn>
+  void foreach_fanin( node const& n, Fn&& fn ) const
+  {
+    if ( _kinds[n] < kind_and )
+      return;
+
+    static_assert( detail::is_callable_without_index_v<Fn, signal, bool> ||
+                   detail::is_callable_with_index_v<Fn, signal, bool> ||
+                   detail::is_callable_without_index_v<Fn, signal, void> ||
+                   detail::is_callable_with_index_v<Fn, signal, void> );
+
+    auto const* lits = &_literals[n * fanin_count];
+    for ( auto i = 0u; i < fanin_count; ++i )
+    {
+      const signal f{static_cast<uint64_t>( lits[i] )};
+      if constexpr ( detail::is_callable_without_index_v<Fn, signal, bool> )
+      {
+        if ( !fn( f ) )
+          return;
+      }
+      else if constexpr ( detail::is_callable_with_index_v<Fn, signal, bool> )
+      {
+        if ( !fn( f, i ) )
+          return;
+      }
+      else if constexpr ( detail::is_callable_without_index_v<Fn, signal, void> )
+      {
+        fn( f );
+      }
+      else
+      {
+        fn( f, i );
+      }
+    }
+  }
+#pragma endregion
+
+#pragma region Value simulation
+  template<typename Iterator>
+  iterates_over_t<Iterator, bool>
+  compute( node const& n, Iterator begin, Iterator end ) const
+  {
+    (void)end;
+    assert( _kinds[n] >= kind_and );
+
+    auto const* lits = &_literals[n * fanin_count];
+    const bool v1 = *begin++ ^ ( lits[0] & 1u );
+    const bool v2 = *begin++ ^ ( lits[1] & 1u );
+    switch ( _kinds[n] )
+    {
+    case kind_maj:
+    {
+      const bool v3 = *begin++ ^ ( lits[2] & 1u );
+      return ( v1 && v2 ) || ( v1 && v3 ) || ( v2 && v3 );
+    }
+    case kind_xor:
+      return v1 != v2;
+    default:
+      return v1 && v2;
+    }
+  }
+
+  template<typename Iterator>
+  iterates_over_truth_table_t<Iterator>
+  compute( node const& n, Iterator begin, Iterator end ) const
+  {
+    (void)end;
+    assert( _kinds[n] >= kind_and );
+
+    auto const* lits = &_literals[n * fanin_count];
+    auto tt1 = *begin++;
+    auto tt2 = *begin++;
+    if ( lits[0] & 1u )
+      tt1 = ~tt1;
+    if ( lits[1] & 1u )
+      tt2 = ~tt2;
+    switch ( _kinds[n] )
+    {
+    case kind_maj:
+    {
+      auto tt3 = *begin++;
+      if ( lits[2] & 1u )
+        tt3 = ~tt3;
+      return kitty::ternary_majority( tt1, tt2, tt3 );
+    }
+    case kind_xor:
+      return tt1 ^ tt2;
+    default:
+      return tt1 & tt2;
+    }
+  }
+#pragma endregion
+
+#pragma region Levels
+  uint32_t depth() const
+  {
+    return _depth;
+  }
+
+  uint32_t level( node const& n ) const
+  {
+    return _levels[n];
+  }
+
+  /*! \brief Levels are computed by `update`, the structure cannot change. */
+  void update_levels()
+  {
+  }
+#pragma endregion
+
+#pragma region Custom node values
+  void clear_values() const
+  {
+    std::fill( _values.begin(), _values.end(), 0u );
+  }
+
+  uint32_t value( node const& n ) const
+  {
+    return _values[n];
+  }
+
+  void set_value( node const& n, uint32_t v ) const
+  {
+    _values[n] = v;
+  }
+
+  uint32_t incr_value( node const& n ) const
+  {
+    return _values[n]++;
+  }
+
+  uint32_t decr_value( node const& n ) const
+  {
+    return --_values[n];
+  }
+#pragma endregion
+
+#pragma region Visited flags
+  void clear_visited() const
+  {
+    std::fill( _visited.begin(), _visited.end(), 0u );
+  }
+
+  uint32_t visited( node const& n ) const
+  {
+    return _visited[n];
+  }
+
+  void set_visited( node const& n, uint32_t v ) const
+  {
+    _visited[n] = v;
+  }
+#pragma endregion
+
+private:
+  /* gates reachable from the outputs in index order, marked in one backward sweep */
+  void collect_sorted()
+  {
+    Ntk::foreach_co( [&]( auto const& f ) {
+      _values[Ntk::get_node( f )] |= 1u;
+    } );
+    for ( auto n = static_cast<uint32_t>( _kinds.size() ); n-- > 0u; )
+    {
+      if ( _kinds[n] < kind_and || _values[n] == 0u )
+        continue;
+      for ( auto i = 0u; i < fanin_count; ++i )
+      {
+        _values[_literals[n * fanin_count + i] >> 1] |= 1u;
+      }
+    }
+
+    for ( auto n = 0u; n < _kinds.size(); ++n )
+    {
+      if ( _kinds[n] < kind_and || _values[n] == 0u )
+        continue;
+      update_level( n );
+      _order.push_back( n );
+    }
+  }
+
+  /* gates reachable from the outputs in depth-first order, with an explicit stack to support deep networks */
+  void collect_dfs()
+  {
+    std::vector<std::pair<uint32_t, uint32_t>> stack;
+    Ntk::foreach_co( [&]( auto const& f ) {
+      const auto root = static_cast<uint32_t>( Ntk::node_to_index( Ntk::get_node( f ) ) );
+      if ( _values[root] == 2u )
+      {
+        return;
+      }
+      _values[root] = 1u;
+      stack.emplace_back( root, 0u );
+      while ( !stack.empty() )
+      {
+        auto& [n, next] = stack.back();
+        if ( next < fanin_count )
+        {
+          const auto child = _literals[n * fanin_count + next++] >> 1;
+          if ( _values[child] == 0u )
+          {
+            _values[child] = 1u;
+            stack.emplace_back( child, 0u );
+          }
+          continue;
+        }
+
+        update_level( n );
+        _values[n] = 2u;
+        _order.push_back( n );
+        stack.pop_back();
+      }
+    } );
+  }
+
+  void update_level( uint32_t n )
+  {
+    uint32_t level = 0u;
+    for ( auto i = 0u; i < fanin_count; ++i )
+    {
+      level = std::max( level, _levels[_literals[n * fanin_count + i] >> 1] );
+    }
+    _levels[n] = level + 1u;
+  }
+
+  enum : uint8_t
+  {
+    kind_constant,
+    kind_pi,
+    kind_ro,
+    kind_and,
+    kind_xor,
+    kind_maj
+  };
+
+  std::vector<uint8_t> _kinds;
+  std::vector<uint32_t> _literals;
+  std::vector<uint32_t> _levels;
+  std::vector<uint32_t> _order;
+  mutable std::vector<uint32_t> _values;
+  mutable std::vector<uint32_t> _visited;
+  uint32_t _num_leaves{0u};
+  uint32_t _depth{0u};
+};
+
+template<class T>
+compact_view( T const& ) -> compact_view<T>;
+
+} // namespace mockturtle
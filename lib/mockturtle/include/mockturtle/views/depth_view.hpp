@@ -140,6 +140,48 @@ public:
     _levels.resize();
   }
 
+  /*! \brief Recomputes the level of a single node.
+   *
+   * The level of `n` is derived from the current levels of its fanins, which
+   * are assumed to be up to date.  Unlike `update_levels`, this does not
+   * touch any other node and does not update the depth.
+   *
+   * \return New level of `n`
+   */
+  uint32_t update_level( node const& n )
+  {
+    if ( this->is_constant( n ) || this->is_pi( n ) )
+    {
+      return _levels[n] = 0;
+    }
+
+    uint32_t level{0};
+    this->foreach_fanin( n, [&]( auto const& f ) {
+      auto clevel = _levels[f];
+      if ( _count_complements && this->is_complemented( f ) )
+      {
+        clevel++;
+      }
+      level = std::max( level, clevel );
+    } );
+
+    return _levels[n] = level + 1;
+  }
+
+  /*! \brief Recomputes the depth from the current levels of the outputs. */
+  void update_depth()
+  {
+    _depth = 0;
+    this->foreach_po( [&]( auto const& f ) {
+      auto clevel = _levels[f];
+      if ( _count_complements && this->is_complemented( f ) )
+      {
+        clevel++;
+      }
+      _depth = std::max( _depth, clevel );
+    } );
+  }
+
 private:
   uint32_t compute_levels( node const& n )
   {
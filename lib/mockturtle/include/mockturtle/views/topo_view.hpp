@@ -32,7 +32,9 @@
 #pragma once
 
 #include <cassert>
+#include <cstdint>
 #include <optional>
+#include <utility>
 #include <vector>
 
 #include "../networks/detail/foreach.hpp"
@@ -261,4 +263,76 @@ topo_view(T const&) -> topo_view<T>;
 template<class T>
 topo_view(T const&, typename T::signal const&) -> topo_view<T>;
 
+/*! \brief Gates in the transitive fanin of all combinational outputs, in topological order.
+ *
+ * Unlike `topo_view`, which starts from `foreach_po`, the traversal starts
+ * from `foreach_co` and stops at `is_ci`.  It therefore includes the logic
+ * that only feeds register inputs in networks whose `foreach_po` leaves the
+ * registers out, such as the XAG, and never looks at the fanins of
+ * register outputs.  Constants and combinational inputs are not returned.
+ *
+ * **Required network functions:**
+ * - `size`
+ * - `get_node`
+ * - `node_to_index`
+ * - `is_constant`
+ * - `is_ci`
+ * - `foreach_co`
+ * - `foreach_fanin`
+ */
+template<class Ntk>
+std::vector<node<Ntk>> combinational_topo_order( Ntk const& ntk )
+{
+  static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
+  static_assert( has_size_v<Ntk>, "Ntk does not implement the size method" );
+  static_assert( has_get_node_v<Ntk>, "Ntk does not implement the get_node method" );
+  static_assert( has_node_to_index_v<Ntk>, "Ntk does not implement the node_to_index method" );
+  static_assert( has_is_constant_v<Ntk>, "Ntk does not implement the is_constant method" );
+  static_assert( has_is_ci_v<Ntk>, "Ntk does not implement the is_ci method" );
+  static_assert( has_foreach_co_v<Ntk>, "Ntk does not implement the foreach_co method" );
+  static_assert( has_foreach_fanin_v<Ntk>, "Ntk does not implement the foreach_fanin method" );
+
+  /* 0: not visited, 1: on the stack, 2: done */
+  std::vector<uint8_t> mark( ntk.size(), 0u );
+  std::vector<node<Ntk>> order;
+  std::vector<std::pair<node<Ntk>, bool>> stack;
+
+  ntk.foreach_co( [&]( auto const& f ) {
+    stack.emplace_back( ntk.get_node( f ), false );
+    while ( !stack.empty() )
+    {
+      const auto [n, expanded] = stack.back();
+      stack.pop_back();
+      auto& m = mark[ntk.node_to_index( n )];
+      if ( expanded )
+      {
+        m = 2u;
+        order.push_back( n );
+        continue;
+      }
+      if ( m != 0u )
+      {
+        continue;
+      }
+      if ( ntk.is_constant( n ) || ntk.is_ci( n ) )
+      {
+        m = 2u;
+        continue;
+      }
+      m = 1u;
+      stack.emplace_back( n, true );
+      ntk.foreach_fanin( n, [&]( auto const& g ) {
+        const auto child = ntk.get_node( g );
+        assert( mark[ntk.node_to_index( child )] != 1u );
+        if ( mark[ntk.node_to_index( child )] == 0u )
+        {
+          stack.emplace_back( child, false );
+        }
+      } );
+    }
+  } );
+
+  return order;
+}
+
 } // namespace mockturtle
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include <mockturtle/algorithms/cleanup.hpp>
 #include <mockturtle/networks/aig.hpp>
 #include <mockturtle/networks/mig.hpp>
+#include <mockturtle/networks/xag.hpp>
 
 using namespace mockturtle;
 
@@ -31,3 +32,58 @@ TEST_CASE( "cleanup networks without PO", "[cleanup]" )
   test_cleanup_network<aig_network>();
   test_cleanup_network<mig_network>();
 }
+
+template<class Ntk>
+void test_cleanup_registers()
+{
+  Ntk ntk;
+
+  const auto a = ntk.create_pi();
+  const auto b = ntk.create_pi();
+  const auto r1 = ntk.create_ro();
+  const auto r2 = ntk.create_ro();
+
+  const auto f1 = ntk.create_and( a, r1 );
+  const auto f2 = ntk.create_and( r1, r2 );
+  ntk.create_and( b, r2 ); /* dangling */
+
+  ntk.create_po( f2 );
+  ntk.create_ri( f1, 1 );
+  ntk.create_ri( ntk.create_not( f2 ), 0 );
+
+  const auto ntk2 = cleanup_dangling( ntk );
+
+  /* XAGs leave registers out of num_pis and num_pos, so count the combinational inputs and outputs */
+  auto num_cis = 0u, num_cos = 0u;
+  ntk2.foreach_ci( [&]( auto n, auto i ) {
+    CHECK( ntk2.is_ro( n ) == ( i >= 2u ) );
+    ++num_cis;
+  } );
+  ntk2.foreach_co( [&]( auto const&, auto ) {
+    ++num_cos;
+  } );
+
+  CHECK( ntk2.num_gates() == 2 );
+  CHECK( num_cis == 4 );
+  CHECK( num_cos == 3 );
+  REQUIRE( ntk2.num_latches() == 2 );
+  CHECK( ntk2.latch_reset( 0 ) == 1 );
+  CHECK( ntk2.latch_reset( 1 ) == 0 );
+
+  /* the primary output stays a primary output */
+  auto num_pos = 0u;
+  ntk2.foreach_po( [&]( auto const& f, auto ) {
+    if ( num_pos++ == 0u )
+    {
+      CHECK( !ntk2.is_complemented( f ) );
+    }
+  } );
+  CHECK( num_pos == ntk.num_pos() );
+}
+
+TEST_CASE( "cleanup networks with registers", "[cleanup]" )
+{
+  test_cleanup_registers<aig_network>();
+  test_cleanup_registers<mig_network>();
+  test_cleanup_registers<xag_network>();
+}
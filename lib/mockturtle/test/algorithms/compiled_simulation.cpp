@@ -0,0 +1,224 @@
+#include <catch.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include <mockturtle/algorithms/compiled_simulation.hpp>
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/klut.hpp>
+#include <mockturtle/networks/mig.hpp>
+#include <mockturtle/networks/xag.hpp>
+
+#include <kitty/constructors.hpp>
+#include <kitty/dynamic_truth_table.hpp>
+
+using namespace mockturtle;
+
+namespace
+{
+
+/* exhaustive patterns, word w of PI i at [i * num_words + w] */
+std::vector<uint64_t> exhaustive_patterns( uint32_t num_pis )
+{
+  const auto num_words = std::max<uint64_t>( 1u, ( uint64_t( 1u ) << num_pis ) >> 6 );
+  std::vector<uint64_t> words;
+  for ( auto i = 0u; i < num_pis; ++i )
+  {
+    kitty::dynamic_truth_table tt( num_pis );
+    kitty::create_nth_var( tt, i );
+    for ( auto w = 0u; w < num_words; ++w )
+    {
+      words.push_back( tt._bits[w] );
+    }
+  }
+  return words;
+}
+
+template<class Ntk>
+void check_against_simulate( Ntk const& ntk, compiled_simulation_params const& ps = {} )
+{
+  const auto num_pis = ntk.num_pis();
+  const auto num_words = std::max<uint64_t>( 1u, ( uint64_t( 1u ) << num_pis ) >> 6 );
+  const auto mask = num_pis < 6u ? ( UINT64_C( 1 ) << ( 1u << num_pis ) ) - 1u : ~UINT64_C( 0 );
+
+  default_simulator<kitty::dynamic_truth_table> sim( num_pis );
+  const auto expected = simulate<kitty::dynamic_truth_table>( ntk, sim );
+
+  const compiled_simulation csim( ntk );
+  const auto pos = csim.simulate( exhaustive_patterns( num_pis ), num_words, ps );
+
+  REQUIRE( pos.size() == expected.size() * num_words );
+  for ( auto o = 0u; o < expected.size(); ++o )
+  {
+    for ( auto w = 0u; w < num_words; ++w )
+    {
+      CHECK( ( pos[o * num_words + w] & mask ) == expected[o]._bits[w] );
+    }
+  }
+}
+
+template<class Ntk, class Fn>
+Ntk random_network( uint32_t num_pis, uint32_t num_gates, uint32_t num_pos, Fn&& create_gate )
+{
+  std::mt19937 rng( 42u );
+  Ntk ntk;
+  std::vector<typename Ntk::signal> fs;
+  for ( auto i = 0u; i < num_pis; ++i )
+  {
+    fs.push_back( ntk.create_pi() );
+  }
+  const auto pick = [&]() {
+    const auto f = fs[rng() % fs.size()];
+    return ( rng() & 1u ) ? ntk.create_not( f ) : f;
+  };
+  for ( auto i = 0u; i < num_gates; ++i )
+  {
+    fs.push_back( create_gate( ntk, pick, rng ) );
+  }
+  for ( auto i = 0u; i < num_pos; ++i )
+  {
+    ntk.create_po( pick() );
+  }
+  return ntk;
+}
+
+} // namespace
+
+TEST_CASE( "compiled simulation of AIG, XAG, and MIG", "[compiled_simulation]" )
+{
+  const auto aig = random_network<aig_network>( 8u, 300u, 20u, []( auto& ntk, auto& pick, auto& ) {
+    return ntk.create_and( pick(), pick() );
+  } );
+  const auto xag = random_network<xag_network>( 8u, 300u, 20u, []( auto& ntk, auto& pick, auto& rng ) {
+    return ( rng() & 1u ) ? ntk.create_xor( pick(), pick() ) : ntk.create_and( pick(), pick() );
+  } );
+  const auto mig = random_network<mig_network>( 8u, 300u, 20u, []( auto& ntk, auto& pick, auto& ) {
+    return ntk.create_maj( pick(), pick(), pick() );
+  } );
+
+  check_against_simulate( aig );
+  check_against_simulate( xag );
+  check_against_simulate( mig );
+
+  /* several threads on partial blocks */
+  check_against_simulate( aig, {3u, 1u} );
+  check_against_simulate( mig, {2u, 3u} );
+}
+
+TEST_CASE( "compiled simulation of k-LUT network", "[compiled_simulation]" )
+{
+  const auto klut = random_network<klut_network>( 10u, 200u, 20u, []( auto& ntk, auto& pick, auto& rng ) {
+    const auto k = 1u + rng() % 9u;
+    std::vector<klut_network::signal> children;
+    for ( auto i = 0u; i < k; ++i )
+    {
+      children.push_back( pick() );
+    }
+    kitty::dynamic_truth_table tt( k );
+    kitty::create_random( tt, rng() );
+    return ntk.create_node( children, tt );
+  } );
+
+  check_against_simulate( klut );
+  check_against_simulate( klut, {2u, 5u} );
+
+  /* constant outputs */
+  klut_network ntk;
+  const auto a = ntk.create_pi();
+  ntk.create_po( ntk.get_constant( false ) );
+  ntk.create_po( ntk.get_constant( true ) );
+  ntk.create_po( ntk.create_not( a ) );
+  check_against_simulate( ntk );
+}
+
+TEST_CASE( "compiled simulation rejects too large LUTs", "[compiled_simulation]" )
+{
+  klut_network ntk;
+  std::vector<klut_network::signal> children;
+  for ( auto i = 0u; i < compiled_simulation::max_lut_size + 1u; ++i )
+  {
+    children.push_back( ntk.create_pi() );
+  }
+  kitty::dynamic_truth_table tt( static_cast<uint32_t>( children.size() ) );
+  kitty::create_random( tt );
+  ntk.create_po( ntk.create_node( children, tt ) );
+
+  CHECK_THROWS_AS( compiled_simulation( ntk ), std::invalid_argument );
+}
+
+TEST_CASE( "observe nodes in compiled simulation", "[compiled_simulation]" )
+{
+  aig_network aig;
+  const auto a = aig.create_pi();
+  const auto b = aig.create_pi();
+  const auto c = aig.create_pi();
+  const auto f1 = aig.create_and( a, b );
+  const auto f2 = aig.create_and( !f1, c );
+  aig.create_po( f2 );
+
+  const compiled_simulation sim( aig );
+  CHECK( sim.num_pis() == 3u );
+  CHECK( sim.num_pos() == 1u );
+  CHECK( sim.num_instructions() == 2u );
+
+  /* 64 * 100 patterns, all 8 assignments equally often */
+  const uint64_t num_words = 100u;
+  std::vector<std::vector<uint64_t>> ones( 2u, std::vector<uint64_t>( aig.size(), 0u ) );
+  std::atomic<uint64_t> po_ones{0u};
+  sim.run(
+      num_words,
+      []( uint32_t pi, uint64_t, uint32_t count, uint64_t* words ) {
+        const uint64_t patterns[] = {0xaaaaaaaaaaaaaaaa, 0xcccccccccccccccc, 0xf0f0f0f0f0f0f0f0};
+        std::fill_n( words, count, patterns[pi] );
+      },
+      [&]( uint32_t, uint64_t, uint32_t count, uint64_t const* words ) {
+        for ( auto w = 0u; w < count; ++w )
+        {
+          po_ones += __builtin_popcountll( words[w] );
+        }
+      },
+      [&]( uint32_t thread, uint32_t node, uint64_t, uint32_t count, uint64_t const* words ) {
+        for ( auto w = 0u; w < count; ++w )
+        {
+          ones[thread][node] += __builtin_popcountll( words[w] );
+        }
+      },
+      {2u, 7u} );
+
+  const auto count = [&]( uint32_t node ) { return ones[0][node] + ones[1][node]; };
+  CHECK( count( aig.node_to_index( aig.get_node( a ) ) ) == 3200u );
+  CHECK( count( aig.node_to_index( aig.get_node( f1 ) ) ) == 1600u );
+  CHECK( count( aig.node_to_index( aig.get_node( f2 ) ) ) == 2400u );
+  CHECK( po_ones == 2400u );
+}
+
+template<class Ntk>
+void check_sequential()
+{
+  Ntk ntk;
+  const auto a = ntk.create_pi();
+  const auto r = ntk.create_ro();
+  const auto g = ntk.create_and( a, r );
+  ntk.create_po( g );
+  ntk.create_ri( !g );
+
+  const compiled_simulation sim( ntk );
+  CHECK( sim.num_pis() == 2u );
+  CHECK( sim.num_pos() == 2u );
+  CHECK( sim.num_instructions() == 1u );
+
+  const auto pos = sim.simulate( {0xaaaaaaaaaaaaaaaa, 0xcccccccccccccccc}, 1u );
+  CHECK( pos[0] == 0x8888888888888888 );
+  CHECK( pos[1] == ~UINT64_C( 0x8888888888888888 ) );
+}
+
+TEST_CASE( "compiled simulation of sequential networks", "[compiled_simulation]" )
+{
+  check_sequential<aig_network>();
+  check_sequential<xag_network>();
+  check_sequential<mig_network>();
+}
@@ -81,3 +81,50 @@ TEST_CASE( "MIG depth optimization with distributivity", "[mig_algebraic_rewriti
 
   CHECK( depth_mig.depth() == 2 );
 }
+
+TEST_CASE( "MIG depth optimization keeps levels up to date", "[mig_algebraic_rewriting]" )
+{
+  mig_network mig;
+
+  std::vector<mig_network::signal> pis;
+  for ( auto i = 0u; i < 10u; ++i )
+  {
+    pis.push_back( mig.create_pi() );
+  }
+
+  auto f = mig.create_and( pis[0], pis[1] );
+  for ( auto i = 2u; i < pis.size(); ++i )
+  {
+    f = i % 2 ? mig.create_and( f, pis[i] ) : mig.create_or( pis[i], f );
+  }
+  mig.create_po( f );
+  mig.create_po( mig.create_maj( pis[0], pis[2], f ) );
+
+  depth_view depth_mig{mig};
+  CHECK( depth_mig.depth() == 10 );
+
+  mig_algebraic_depth_rewriting_params ps;
+  ps.strategy = mig_algebraic_depth_rewriting_params::selective;
+  mig_algebraic_depth_rewriting( depth_mig, ps );
+
+  const auto depth = depth_mig.depth();
+  std::vector<uint32_t> levels;
+  depth_mig.foreach_po( [&]( auto const& po ) {
+    topo_view topo{depth_mig, po};
+    topo.foreach_node( [&]( auto n ) {
+      levels.push_back( depth_mig.level( n ) );
+    } );
+  } );
+
+  depth_mig.update_levels();
+  CHECK( depth_mig.depth() == depth );
+  CHECK( depth < 10 );
+
+  auto i = 0u;
+  depth_mig.foreach_po( [&]( auto const& po ) {
+    topo_view topo{depth_mig, po};
+    topo.foreach_node( [&]( auto n ) {
+      CHECK( depth_mig.level( n ) == levels[i++] );
+    } );
+  } );
+}
@@ -0,0 +1,169 @@
+#include <catch.hpp>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <mockturtle/algorithms/cleanup.hpp>
+#include <mockturtle/algorithms/compiled_simulation.hpp>
+#include <mockturtle/algorithms/node_resynthesis/mig_npn.hpp>
+#include <mockturtle/algorithms/node_resynthesis/xag_npn.hpp>
+#include <mockturtle/algorithms/seq_rewriting.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/mig.hpp>
+#include <mockturtle/traits.hpp>
+
+using namespace mockturtle;
+
+namespace
+{
+
+/* primary outputs of 64 random input sequences of `cycles` cycles, all starting in the reset state */
+template<class Ntk>
+std::vector<uint64_t> simulate_cycles( Ntk const& ntk, uint32_t cycles )
+{
+  const compiled_simulation sim( ntk );
+  const auto num_regs = ntk.num_latches();
+  const auto num_pis = sim.num_pis() - num_regs;
+  const auto num_pos = sim.num_pos() - num_regs;
+
+  std::vector<uint64_t> state;
+  for ( auto i = 0u; i < num_regs; ++i )
+  {
+    state.push_back( ntk.latch_reset( i ) == 1 ? ~UINT64_C( 0 ) : UINT64_C( 0 ) );
+  }
+
+  std::mt19937_64 rng( 42u );
+  std::vector<uint64_t> trace;
+  for ( auto c = 0u; c < cycles; ++c )
+  {
+    std::vector<uint64_t> words;
+    for ( auto i = 0u; i < num_pis; ++i )
+    {
+      words.push_back( rng() );
+    }
+    words.insert( words.end(), state.begin(), state.end() );
+
+    const auto outputs = sim.simulate( words, 1u );
+    trace.insert( trace.end(), outputs.begin(), outputs.begin() + num_pos );
+    state.assign( outputs.begin() + num_pos, outputs.end() );
+  }
+  return trace;
+}
+
+} // namespace
+
+TEST_CASE( "Sequential rewriting keeps registers", "[seq_rewriting]" )
+{
+  aig_network aig;
+  const auto a = aig.create_pi();
+  const auto b = aig.create_pi();
+  const auto r1 = aig.create_ro();
+  const auto r2 = aig.create_ro();
+
+  /* redundant logic on both sides of the registers */
+  const auto f1 = aig.create_or( aig.create_and( a, b ), aig.create_and( a, r1 ) );
+  const auto f2 = aig.create_or( aig.create_and( r1, r2 ), aig.create_and( r1, b ) );
+
+  aig.create_po( f2 );
+  aig.create_ri( f1, 1 );
+  aig.create_ri( f2, 0 );
+
+  CHECK( aig.num_gates() == 6 );
+
+  xag_npn_resynthesis<aig_network> resyn;
+  seq_rewriting_stats st;
+  const auto opt = seq_rewriting( aig, resyn, {}, &st );
+
+  CHECK( st.registers_before == 2 );
+  CHECK( opt.num_latches() == 2 );
+  CHECK( opt.num_gates() == 4 );
+  CHECK( opt.latch_reset( 0 ) == 1 );
+  CHECK( opt.latch_reset( 1 ) == 0 );
+  CHECK( simulate_cycles( opt, 8u ) == simulate_cycles( aig, 8u ) );
+}
+
+TEST_CASE( "Sequential rewriting removes and merges registers", "[seq_rewriting]" )
+{
+  aig_network aig;
+  const auto a = aig.create_pi();
+  const auto b = aig.create_pi();
+  const auto r1 = aig.create_ro();
+  const auto r2 = aig.create_ro();
+  const auto r3 = aig.create_ro();
+  const auto r4 = aig.create_ro();
+  const auto r5 = aig.create_ro();
+
+  const auto g = aig.create_and( a, b );
+  aig.create_po( aig.create_xor( aig.create_and( r1, a ), aig.create_and( r2, b ) ) );
+  aig.create_po( aig.create_or( r3, r4 ) );
+
+  aig.create_ri( g, 0 );                          /* r1 */
+  aig.create_ri( g, 0 );                          /* r2, same as r1 */
+  aig.create_ri( aig.get_constant( false ), 0 );  /* r3, always 0 */
+  aig.create_ri( r4, 1 );                         /* r4, always 1 */
+  aig.create_ri( aig.create_and( a, r5 ), 1 );    /* r5, does not reach an output */
+
+  seq_rewriting_params ps;
+  ps.rewrite = false;
+  ps.retime_forward = false;
+  seq_rewriting_stats st;
+  const auto opt = seq_rewriting( aig, xag_npn_resynthesis<aig_network>{}, ps, &st );
+
+  CHECK( st.dangling == 1 );
+  CHECK( st.constant == 2 );
+  CHECK( st.merged == 1 );
+  CHECK( opt.num_latches() == 1 );
+  CHECK( simulate_cycles( opt, 8u ) == simulate_cycles( aig, 8u ) );
+}
+
+TEST_CASE( "Sequential rewriting retimes registers forward", "[seq_rewriting]" )
+{
+  aig_network aig;
+  const auto a = aig.create_pi();
+  const auto b = aig.create_pi();
+  const auto c = aig.create_pi();
+  const auto r1 = aig.create_ro();
+  const auto r2 = aig.create_ro();
+
+  aig.create_po( aig.create_and( aig.create_and( r1, !r2 ), c ) );
+  aig.create_ri( aig.create_xor( a, b ), 1 );
+  aig.create_ri( aig.create_and( a, b ), 0 );
+
+  seq_rewriting_params ps;
+  ps.rewrite = false;
+  seq_rewriting_stats st;
+  const auto opt = seq_rewriting( aig, xag_npn_resynthesis<aig_network>{}, ps, &st );
+
+  CHECK( st.retimed == 1 );
+  REQUIRE( opt.num_latches() == 1 );
+  /* the reset value of and( r1, !r2 ) */
+  CHECK( opt.latch_reset( 0 ) == 1 );
+  CHECK( simulate_cycles( opt, 8u ) == simulate_cycles( aig, 8u ) );
+}
+
+TEST_CASE( "Sequential rewriting of MIGs", "[seq_rewriting]" )
+{
+  mig_network mig;
+  const auto a = mig.create_pi();
+  const auto b = mig.create_pi();
+  const auto r1 = mig.create_ro();
+  const auto r2 = mig.create_ro();
+  const auto r3 = mig.create_ro();
+  const auto r4 = mig.create_ro();
+
+  const auto f = mig.create_maj( r1, r2, !r3 );
+  mig.create_po( mig.create_and( f, r4 ) );
+  mig.create_ri( a, 1 );
+  mig.create_ri( mig.create_and( a, b ), 0 );
+  mig.create_ri( b, 0 );
+  mig.create_ri( mig.create_or( mig.create_and( a, b ), f ), 1 );
+
+  mig_npn_resynthesis resyn;
+  seq_rewriting_stats st;
+  const auto opt = seq_rewriting( mig, resyn, {}, &st );
+
+  CHECK( st.retimed >= 1 );
+  CHECK( opt.num_latches() < mig.num_latches() );
+  CHECK( simulate_cycles( opt, 16u ) == simulate_cycles( mig, 16u ) );
+}
@@ -0,0 +1,138 @@
+#include <catch.hpp>
+
+#include <cstdint>
+#include <vector>
+
+#include <mockturtle/algorithms/switching_activity.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/klut.hpp>
+#include <mockturtle/networks/xag.hpp>
+
+using namespace mockturtle;
+
+TEST_CASE( "switching activity with random patterns", "[switching_activity]" )
+{
+  aig_network aig;
+  const auto a = aig.create_pi();
+  const auto b = aig.create_pi();
+  const auto f = aig.create_and( a, b );
+  aig.create_po( f );
+  aig.create_po( aig.create_or( f, !a ) );
+
+  switching_activity_params ps;
+  ps.num_patterns = 1u << 16;
+  const auto act = switching_activity( aig, ps );
+
+  const auto na = aig.node_to_index( aig.get_node( a ) );
+  const auto nf = aig.node_to_index( aig.get_node( f ) );
+  CHECK( act.probability[0] == 0.0 );
+  CHECK( act.probability[na] == Approx( 0.5 ).epsilon( 0.02 ) );
+  CHECK( act.toggle_rate[na] == Approx( 0.5 ).epsilon( 0.02 ) );
+  CHECK( act.probability[nf] == Approx( 0.25 ).epsilon( 0.02 ) );
+  CHECK( act.toggle_rate[nf] == Approx( 0.375 ).epsilon( 0.02 ) );
+
+  /* the patterns do not depend on the number of threads */
+  ps.simulation_ps.num_threads = 3u;
+  const auto act3 = switching_activity( aig, ps );
+  CHECK( act3.probability == act.probability );
+  CHECK( act3.toggle_rate == act.toggle_rate );
+  CHECK( act3.activity == act.activity );
+}
+
+TEST_CASE( "switching activity ignores dangling gates", "[switching_activity]" )
+{
+  aig_network aig;
+  const auto a = aig.create_pi();
+  const auto b = aig.create_pi();
+  const auto f = aig.create_and( a, b );
+  const auto g = aig.create_and( !a, b );
+  aig.create_po( f );
+  aig.create_and( g, !b );
+
+  const auto act = switching_activity( aig );
+  CHECK( act.num_gates == 1u );
+  CHECK( act.gate_probability == act.probability[aig.node_to_index( aig.get_node( f ) )] );
+  CHECK( act.gate_toggles == act.toggle_rate[aig.node_to_index( aig.get_node( f ) )] );
+  CHECK( act.probability[aig.node_to_index( aig.get_node( g ) )] == 0.0 );
+}
+
+TEST_CASE( "switching activity of a pattern sequence", "[switching_activity]" )
+{
+  klut_network klut;
+  const auto a = klut.create_pi();
+  const auto b = klut.create_pi();
+  const auto f = klut.create_and( a, b );
+  const auto g = klut.create_not( f );
+  klut.create_po( f );
+  klut.create_po( g );
+  klut.create_po( klut.get_constant( true ) );
+
+  /* a toggles with every pattern, b is constant 1 in the first half */
+  std::vector<uint64_t> pis( 2u * 4u );
+  std::fill_n( pis.begin(), 4u, UINT64_C( 0xaaaaaaaaaaaaaaaa ) );
+  std::fill_n( pis.begin() + 4u, 2u, ~UINT64_C( 0 ) );
+
+  switching_activity_params ps;
+  ps.simulation_ps.block_words = 4u;
+  const auto act = switching_activity( klut, pis, 256u, ps );
+
+  CHECK( act.probability[klut.get_node( a )] == 0.5 );
+  CHECK( act.toggle_rate[klut.get_node( a )] == 1.0 );
+  CHECK( act.probability[klut.get_node( b )] == 0.5 );
+  CHECK( act.toggle_rate[klut.get_node( b )] == 1.0 / 255.0 );
+  CHECK( act.probability[klut.get_node( f )] == 0.25 );
+  CHECK( act.toggle_rate[klut.get_node( f )] == 128.0 / 255.0 );
+  CHECK( act.toggle_rate[klut.get_node( g )] == 128.0 / 255.0 );
+  CHECK( act.probability[klut.get_node( klut.get_constant( true ) )] == 1.0 );
+
+  /* fanout sizes: a 1, b 1, f 2, g 1 */
+  CHECK( act.activity == Approx( 1.0 + 1.0 / 255.0 + 3.0 * 128.0 / 255.0 ) );
+  CHECK( act.gate_toggles == Approx( 2.0 * 128.0 / 255.0 ) );
+}
+
+TEST_CASE( "switching activity of a short pattern sequence", "[switching_activity]" )
+{
+  aig_network aig;
+  const auto a = aig.create_pi();
+  aig.create_po( !a );
+
+  /* two patterns 0 and 1, the padding bits of the word are ignored */
+  const auto act = switching_activity( aig, std::vector<uint64_t>{UINT64_C( 0xfffffffffffffffe )}, 2u );
+  CHECK( act.probability[aig.get_node( a )] == 0.5 );
+  CHECK( act.toggle_rate[aig.get_node( a )] == 1.0 );
+
+  /* 100 patterns over two words, pattern i is 1 for odd i, followed by padding 1s */
+  const auto act2 = switching_activity( aig, std::vector<uint64_t>{UINT64_C( 0xaaaaaaaaaaaaaaaa ), UINT64_C( 0xaaaaaaaaaaaaaaaa ) | ( ~UINT64_C( 0 ) << 36 )}, 100u );
+  CHECK( act2.probability[aig.get_node( a )] == 0.5 );
+  CHECK( act2.toggle_rate[aig.get_node( a )] == 1.0 );
+}
+
+template<class Ntk>
+void check_sequential_activity()
+{
+  Ntk ntk;
+  const auto a = ntk.create_pi();
+  const auto r = ntk.create_ro();
+  const auto g = ntk.create_and( a, r );
+  ntk.create_po( g );
+  ntk.create_ri( !g );
+
+  switching_activity_params ps;
+  ps.num_patterns = 1u << 16;
+  const auto act = switching_activity( ntk, ps );
+
+  for ( auto p : act.probability )
+  {
+    CHECK( p >= 0.0 );
+    CHECK( p <= 1.0 );
+  }
+  CHECK( act.probability[ntk.node_to_index( ntk.get_node( r ) )] == Approx( 0.5 ).epsilon( 0.02 ) );
+  CHECK( act.probability[ntk.node_to_index( ntk.get_node( g ) )] == Approx( 0.25 ).epsilon( 0.02 ) );
+  CHECK( act.gate_toggles == Approx( 0.375 ).epsilon( 0.02 ) );
+}
+
+TEST_CASE( "switching activity of sequential networks", "[switching_activity]" )
+{
+  check_sequential_activity<aig_network>();
+  check_sequential_activity<xag_network>();
+}
@@ -0,0 +1,93 @@
+#include <catch.hpp>
+
+#include <memory>
+
+#include <mockturtle/algorithms/cleanup.hpp>
+#include <mockturtle/algorithms/cut_rewriting.hpp>
+#include <mockturtle/algorithms/node_resynthesis/xag_npn.hpp>
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/algorithms/window_rewriting.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/traits.hpp>
+
+#include <kitty/dynamic_truth_table.hpp>
+
+using namespace mockturtle;
+
+TEST_CASE( "Window rewriting of redundant fanout-free cones", "[window_rewriting]" )
+{
+  aig_network aig;
+  const auto a = aig.create_pi();
+  const auto b = aig.create_pi();
+  const auto c = aig.create_pi();
+  const auto d = aig.create_pi();
+
+  /* two cones with redundant logic, the second one reads the first one twice */
+  const auto f1 = aig.create_or( aig.create_and( a, b ), aig.create_and( a, c ) );
+  const auto f2 = aig.create_or( aig.create_and( f1, d ), aig.create_and( f1, !c ) );
+  aig.create_po( f1 );
+  aig.create_po( f2 );
+
+  CHECK( aig.num_gates() == 6 );
+
+  default_simulator<kitty::dynamic_truth_table> sim( aig.num_pis() );
+  const auto tts = simulate<kitty::dynamic_truth_table>( aig, sim );
+
+  window_rewriting_params ps;
+  ps.num_threads = 2;
+  window_rewriting_stats st;
+  window_rewriting( aig, []() {
+    return [resyn = std::make_shared<xag_npn_resynthesis<aig_network>>()]( aig_network& win ) {
+      cut_rewriting( win, *resyn );
+      win = cleanup_dangling( win );
+    };
+  }, ps, &st );
+  aig = cleanup_dangling( aig );
+
+  CHECK( st.windows == 2 );
+  CHECK( st.committed == 2 );
+  CHECK( st.gain == 2 );
+  CHECK( aig.num_gates() == 4 );
+  CHECK( simulate<kitty::dynamic_truth_table>( aig, sim ) == tts );
+}
+
+TEST_CASE( "Window rewriting around given roots keeps shared gates", "[window_rewriting]" )
+{
+  aig_network aig;
+  const auto a = aig.create_pi();
+  const auto b = aig.create_pi();
+  const auto c = aig.create_pi();
+  const auto d = aig.create_pi();
+
+  /* a & b is also an output, so it survives when the cone of f is replaced */
+  const auto ab = aig.create_and( a, b );
+  const auto f = aig.create_or( aig.create_or( ab, aig.create_and( a, c ) ), aig.create_and( a, d ) );
+  const auto g = aig.create_and( f, d );
+  aig.create_po( ab );
+  aig.create_po( f );
+  aig.create_po( g );
+
+  CHECK( aig.num_gates() == 6 );
+
+  default_simulator<kitty::dynamic_truth_table> sim( aig.num_pis() );
+  const auto tts = simulate<kitty::dynamic_truth_table>( aig, sim );
+
+  window_rewriting_params ps;
+  ps.num_threads = 2;
+  ps.min_gates = 2;
+  window_rewriting_stats st;
+  window_rewriting( aig, std::vector<aig_network::node>{aig.get_node( g ), aig.get_node( f )}, []() {
+    return [resyn = std::make_shared<xag_npn_resynthesis<aig_network>>()]( aig_network& win ) {
+      cut_rewriting( win, *resyn );
+      win = cleanup_dangling( win );
+    };
+  }, ps, &st );
+  aig = cleanup_dangling( aig );
+
+  /* the window of g stops at the root f */
+  CHECK( st.windows == 1 );
+  CHECK( st.committed == 1 );
+  CHECK( st.gain == 1 );
+  CHECK( aig.num_gates() == 5 );
+  CHECK( simulate<kitty::dynamic_truth_table>( aig, sim ) == tts );
+}
@@ -0,0 +1,108 @@
+#include <catch.hpp>
+
+#include <algorithm>
+
+#include <mockturtle/algorithms/xor_maj_detection.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/mig.hpp>
+#include <mockturtle/networks/xag.hpp>
+#include <mockturtle/traits.hpp>
+
+using namespace mockturtle;
+
+TEST_CASE( "Detect a full adder in an AIG", "[xor_maj_detection]" )
+{
+  aig_network aig;
+  const auto a = aig.create_pi();
+  const auto b = aig.create_pi();
+  const auto c = aig.create_pi();
+
+  const auto sum = aig.create_xor( aig.create_xor( a, b ), c );
+  const auto carry = aig.create_maj( a, b, c );
+  aig.create_po( sum );
+  aig.create_po( carry );
+
+  const auto result = detect_xor_maj( aig );
+
+  CHECK( std::any_of( result.xor3.begin(), result.xor3.end(), [&]( auto const& g ) { return g.root == aig.get_node( sum ) && g.leaves.size() == 3u; } ) );
+  CHECK( std::any_of( result.maj3.begin(), result.maj3.end(), [&]( auto const& g ) { return g.root == aig.get_node( carry ); } ) );
+  REQUIRE( result.full_adders.size() == 1u );
+  CHECK( result.full_adders[0].sum == aig.get_node( sum ) );
+  CHECK( result.full_adders[0].carry == aig.get_node( carry ) );
+
+  /* the inner XOR of a and b only feeds the sum and is absorbed into its tree */
+  REQUIRE( result.xor_trees.size() == 1u );
+  CHECK( result.xor_trees[0].root == aig.get_node( sum ) );
+  CHECK( result.xor_trees[0].leaves.size() == 3u );
+}
+
+TEST_CASE( "Detect a half adder and an XNOR in an AIG", "[xor_maj_detection]" )
+{
+  aig_network aig;
+  const auto a = aig.create_pi();
+  const auto b = aig.create_pi();
+
+  const auto sum = aig.create_xor( a, b );
+  const auto carry = aig.create_and( a, b );
+  aig.create_po( sum );
+  aig.create_po( carry );
+
+  const auto result = detect_xor_maj( aig );
+
+  REQUIRE( result.xor2.size() == 1u );
+  CHECK( result.xor2[0].root == aig.get_node( sum ) );
+  CHECK( result.xor2[0].complemented == aig.is_complemented( sum ) );
+  REQUIRE( result.half_adders.size() == 1u );
+  CHECK( result.half_adders[0].carry == aig.get_node( carry ) );
+  CHECK( result.full_adders.empty() );
+}
+
+TEST_CASE( "Detect majority gates and XOR trees in MIGs and XAGs", "[xor_maj_detection]" )
+{
+  mig_network mig;
+  const auto a = mig.create_pi();
+  const auto b = mig.create_pi();
+  const auto c = mig.create_pi();
+  mig.create_po( mig.create_maj( a, !b, c ) );
+
+  const auto mig_result = detect_xor_maj( mig );
+  CHECK( mig_result.maj3.size() == 1u );
+  CHECK( mig_result.xor2.empty() );
+
+  xag_network xag;
+  std::vector<xag_network::signal> pis;
+  for ( auto i = 0u; i < 5u; ++i )
+  {
+    pis.push_back( xag.create_pi() );
+  }
+  const auto x = xag.create_xor( xag.create_xor( pis[0], pis[1] ), xag.create_xor( pis[2], xag.create_xor( pis[3], pis[4] ) ) );
+  xag.create_po( x );
+
+  const auto xag_result = detect_xor_maj( xag );
+  REQUIRE( xag_result.xor_trees.size() == 1u );
+  CHECK( xag_result.xor_trees[0].root == xag.get_node( x ) );
+  CHECK( xag_result.xor_trees[0].leaves.size() == 5u );
+}
+
+TEST_CASE( "Detect XORs when node indices are not topological", "[xor_maj_detection]" )
+{
+  aig_network aig;
+  const auto a = aig.create_pi();
+  const auto b = aig.create_pi();
+  const auto d = aig.create_pi();
+
+  /* the placeholder is replaced by an XOR with larger node indices than its fanout */
+  const auto placeholder = aig.create_and( a, b );
+  const auto f = aig.create_xor( placeholder, d );
+  aig.create_po( f );
+  const auto x = aig.create_xor( a, b );
+  aig.substitute_node( aig.get_node( placeholder ), x );
+  REQUIRE( aig.node_to_index( aig.get_node( x ) ) > aig.node_to_index( aig.get_node( f ) ) );
+
+  const auto result = detect_xor_maj( aig );
+
+  CHECK( std::any_of( result.xor3.begin(), result.xor3.end(), [&]( auto const& g ) { return g.root == aig.get_node( f ) && g.leaves.size() == 3u; } ) );
+  REQUIRE( result.xor_trees.size() == 1u );
+  CHECK( result.xor_trees[0].root == aig.get_node( f ) );
+  CHECK( result.xor_trees[0].leaves.size() == 3u );
+}
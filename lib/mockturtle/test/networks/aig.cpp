@@ -7,6 +7,9 @@
 #include <kitty/operations.hpp>
 #include <kitty/operators.hpp>
 
+#include <utility>
+#include <vector>
+
 using namespace mockturtle;
 
 TEST_CASE( "create and use constants in an AIG", "[aig]" )
@@ -466,3 +469,45 @@ TEST_CASE( "visited values in AIGs", "[aig]" )
     CHECK( aig.visited( n ) == 0 );
   } );
 }
+
+TEST_CASE( "batched node substitution in AIGs", "[aig]" )
+{
+  using pair_t = std::pair<aig_network::node, aig_network::signal>;
+
+  const auto build = []( aig_network& aig ) {
+    const auto a = aig.create_pi();
+    const auto b = aig.create_pi();
+    const auto c = aig.create_pi();
+    const auto f1 = aig.create_and( a, b );
+    const auto f2 = aig.create_and( f1, c );
+    const auto f3 = aig.create_or( f2, a );
+    aig.create_po( f2 );
+    aig.create_po( f3 );
+    return std::vector<pair_t>{{aig.get_node( f1 ), b}, {aig.get_node( f3 ), !a}};
+  };
+
+  aig_network aig1, aig2;
+  const auto subst1 = build( aig1 );
+  const auto subst2 = build( aig2 );
+
+  /* one by one */
+  for ( auto const& [n, s] : subst1 )
+  {
+    aig1.substitute_node( n, s );
+  }
+
+  /* as a batch */
+  aig2.substitute_nodes( subst2 );
+
+  CHECK( aig1.num_gates() == aig2.num_gates() );
+  /* substituted nodes lose their fanout, but are not taken out of the AIG */
+  CHECK( aig1.fanout_size( subst1[0].first ) == 0u );
+  CHECK( aig2.fanout_size( subst2[0].first ) == 0u );
+  std::vector<aig_network::signal> pos;
+  aig2.foreach_po( [&]( auto const& f ) {
+    pos.push_back( f );
+  } );
+  aig1.foreach_po( [&]( auto const& f, auto i ) {
+    CHECK( f == pos[i] );
+  } );
+}
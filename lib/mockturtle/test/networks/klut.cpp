@@ -1,5 +1,7 @@
 #include <catch.hpp>
 
+#include <algorithm>
+#include <memory>
 #include <vector>
 
 #include <mockturtle/networks/klut.hpp>
@@ -202,6 +204,64 @@ TEST_CASE( "create nodes and compute a function in a k-LUT network", "[klut]" )
   CHECK( sim_xor == ( xs[0] ^ xs[1] ^ xs[2] ) );
 }
 
+TEST_CASE( "compute functions of small and large LUTs in a k-LUT network", "[klut]" )
+{
+  klut_network klut;
+
+  std::vector<klut_network::signal> pis;
+  std::vector<kitty::dynamic_truth_table> xs;
+  for ( auto i = 0u; i < 10u; ++i )
+  {
+    pis.push_back( klut.create_pi() );
+    xs.emplace_back( 10u );
+    kitty::create_nth_var( xs.back(), i );
+  }
+
+  /* fan-ins up to 8 are stored in the node, larger ones on the heap */
+  for ( auto k : {2u, 5u, 6u, 8u, 9u, 10u} )
+  {
+    kitty::dynamic_truth_table tt( k );
+    kitty::create_random( tt, k );
+
+    std::vector<klut_network::signal> children( pis.begin(), pis.begin() + k );
+    std::reverse( children.begin(), children.end() );
+    const auto f = klut.create_node( children, tt );
+    CHECK( klut.fanin_size( klut.get_node( f ) ) == k );
+
+    klut.foreach_fanin( klut.get_node( f ), [&]( auto const& g, auto i ) {
+      CHECK( g == children[i] );
+    } );
+
+    /* a copy of the network keeps the fan-ins */
+    klut_network copy( std::make_shared<klut_storage>( *klut._storage ) );
+    CHECK( copy.create_node( children, tt ) == f );
+
+    /* the fan-in truth tables are in the order of the children */
+    std::vector<kitty::dynamic_truth_table> fanin_tts( xs.rend() - k, xs.rend() );
+    std::vector<kitty::dynamic_truth_table> fanin_projections( k, kitty::dynamic_truth_table( k ) );
+    for ( auto i = 0u; i < k; ++i )
+    {
+      kitty::create_nth_var( fanin_projections[i], i );
+    }
+
+    const auto sim = klut.compute( klut.get_node( f ), fanin_tts.begin(), fanin_tts.end() );
+    for ( auto m = 0u; m < sim.num_bits(); ++m )
+    {
+      uint32_t pattern = 0u;
+      for ( auto i = 0u; i < k; ++i )
+      {
+        pattern |= kitty::get_bit( fanin_tts[i], m ) << i;
+      }
+      CHECK( kitty::get_bit( sim, m ) == kitty::get_bit( tt, pattern ) );
+    }
+    CHECK( klut.compute( klut.get_node( f ), fanin_projections.begin(), fanin_projections.end() ) == tt );
+
+    /* complemented cache entries */
+    const auto nf = klut.create_node( children, ~tt );
+    CHECK( klut.compute( klut.get_node( nf ), fanin_tts.begin(), fanin_tts.end() ) == ~sim );
+  }
+}
+
 TEST_CASE( "hash nodes in K-LUT network", "[klut]" )
 {
   klut_network klut;
@@ -528,4 +528,45 @@ TEST_CASE( "node substitution in MIGs", "[mig]" )
       break;
     }
   } );
-}
\ No newline at end of file
+}
+
+TEST_CASE( "batched node substitution in MIGs", "[mig]" )
+{
+  using pair_t = std::pair<mig_network::node, mig_network::signal>;
+
+  const auto build = []( mig_network& mig ) {
+    const auto a = mig.create_pi();
+    const auto b = mig.create_pi();
+    const auto c = mig.create_pi();
+    const auto f1 = mig.create_maj( a, b, c );
+    const auto f2 = mig.create_and( f1, c );
+    const auto f3 = mig.create_or( f2, a );
+    mig.create_po( f2 );
+    mig.create_po( f3 );
+    return std::vector<pair_t>{{mig.get_node( f1 ), b}, {mig.get_node( f3 ), !a}};
+  };
+
+  mig_network mig1, mig2;
+  const auto subst1 = build( mig1 );
+  const auto subst2 = build( mig2 );
+
+  /* one by one */
+  for ( auto const& [n, s] : subst1 )
+  {
+    mig1.substitute_node( n, s );
+  }
+
+  /* as a batch */
+  mig2.substitute_nodes( subst2 );
+
+  CHECK( mig1.num_gates() == mig2.num_gates() );
+  CHECK( mig1.is_dead( subst1[0].first ) );
+  CHECK( mig2.is_dead( subst2[0].first ) );
+  std::vector<mig_network::signal> pos;
+  mig2.foreach_po( [&]( auto const& f ) {
+    pos.push_back( f );
+  } );
+  mig1.foreach_po( [&]( auto const& f, auto i ) {
+    CHECK( f == pos[i] );
+  } );
+}
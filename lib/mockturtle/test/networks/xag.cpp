@@ -0,0 +1,70 @@
+#include <catch.hpp>
+
+#include <utility>
+#include <vector>
+
+#include <mockturtle/networks/xag.hpp>
+#include <mockturtle/traits.hpp>
+
+using namespace mockturtle;
+
+TEST_CASE( "node substitution in XAGs", "[xag]" )
+{
+  xag_network xag;
+  const auto a = xag.create_pi();
+  const auto b = xag.create_pi();
+  const auto c = xag.create_pi();
+  const auto f1 = xag.create_xor( a, b );
+  const auto f2 = xag.create_and( f1, c );
+  xag.create_po( f2 );
+
+  xag.substitute_node( xag.get_node( f1 ), !c );
+
+  CHECK( xag.is_dead( xag.get_node( f1 ) ) );
+  CHECK( xag.num_gates() == 0u );
+  xag.foreach_po( [&]( auto const& f ) {
+    /* and( !c, c ) is constant 0 */
+    CHECK( f == xag.get_constant( false ) );
+  } );
+}
+
+TEST_CASE( "batched node substitution in XAGs", "[xag]" )
+{
+  using pair_t = std::pair<xag_network::node, xag_network::signal>;
+
+  const auto build = []( xag_network& xag ) {
+    const auto a = xag.create_pi();
+    const auto b = xag.create_pi();
+    const auto c = xag.create_pi();
+    const auto f1 = xag.create_xor( a, b );
+    const auto f2 = xag.create_and( f1, c );
+    const auto f3 = xag.create_xor( f2, a );
+    xag.create_po( f2 );
+    xag.create_po( f3 );
+    return std::vector<pair_t>{{xag.get_node( f1 ), b}, {xag.get_node( f3 ), !a}};
+  };
+
+  xag_network xag1, xag2;
+  const auto subst1 = build( xag1 );
+  const auto subst2 = build( xag2 );
+
+  /* one by one */
+  for ( auto const& [n, s] : subst1 )
+  {
+    xag1.substitute_node( n, s );
+  }
+
+  /* as a batch */
+  xag2.substitute_nodes( subst2 );
+
+  CHECK( xag1.num_gates() == xag2.num_gates() );
+  CHECK( xag1.is_dead( subst1[0].first ) );
+  CHECK( xag2.is_dead( subst2[0].first ) );
+  std::vector<xag_network::signal> pos;
+  xag2.foreach_po( [&]( auto const& f ) {
+    pos.push_back( f );
+  } );
+  xag1.foreach_po( [&]( auto const& f, auto i ) {
+    CHECK( f == pos[i] );
+  } );
+}
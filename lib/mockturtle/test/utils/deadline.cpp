@@ -0,0 +1,66 @@
+#include <catch.hpp>
+
+#include <limits>
+
+#include <mockturtle/algorithms/cut_rewriting.hpp>
+#include <mockturtle/algorithms/node_resynthesis/mig_npn.hpp>
+#include <mockturtle/networks/mig.hpp>
+#include <mockturtle/utils/deadline.hpp>
+
+using namespace mockturtle;
+
+TEST_CASE( "deadline basics", "[deadline]" )
+{
+  const deadline none;
+  CHECK( !none.is_set() );
+  CHECK( !none.expired() );
+  CHECK( none.remaining() == std::numeric_limits<double>::infinity() );
+
+  /* budgets too large for a time point are no deadline */
+  CHECK( !deadline::after( std::numeric_limits<double>::infinity() ).is_set() );
+
+  const auto now = deadline::after( 0.0 );
+  CHECK( now.is_set() );
+  CHECK( now.expired() );
+  CHECK( now.remaining() == 0.0 );
+
+  const auto later = deadline::after( 60.0 );
+  CHECK( later.is_set() );
+  CHECK( !later.expired() );
+  CHECK( later.remaining() > 0.0 );
+  CHECK( later.remaining() <= 60.0 );
+
+  CHECK( later.earliest( now ).expired() );
+  CHECK( now.earliest( later ).expired() );
+  CHECK( later.earliest( none ).remaining() <= 60.0 );
+  CHECK( !none.earliest( none ).is_set() );
+}
+
+TEST_CASE( "Cut rewriting stops at an expired deadline", "[deadline]" )
+{
+  mig_network mig;
+  const auto a = mig.create_pi();
+  const auto b = mig.create_pi();
+  const auto c = mig.create_pi();
+
+  const auto f = mig.create_maj( a, mig.create_maj( a, b, c ), c );
+  mig.create_po( f );
+
+  mig_npn_resynthesis resyn;
+  cut_rewriting_params ps;
+  ps.time_limit = deadline::after( 0.0 );
+  cut_rewriting_stats st;
+  cut_rewriting( mig, resyn, ps, &st );
+
+  mig = cleanup_dangling( mig );
+
+  CHECK( st.timed_out );
+  CHECK( mig.num_gates() == 2 );
+
+  ps.time_limit = deadline::after( 60.0 );
+  cut_rewriting( mig, resyn, ps, &st );
+
+  mig = cleanup_dangling( mig );
+
+  CHECK( mig.num_gates() == 1 );
+}
@@ -0,0 +1,142 @@
+#include <catch.hpp>
+
+#include <cstdint>
+#include <vector>
+
+#include <kitty/dynamic_truth_table.hpp>
+#include <kitty/static_truth_table.hpp>
+#include <mockturtle/algorithms/cut_enumeration.hpp>
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/mig.hpp>
+#include <mockturtle/networks/xag.hpp>
+#include <mockturtle/traits.hpp>
+#include <mockturtle/views/compact_view.hpp>
+#include <mockturtle/views/depth_view.hpp>
+#include <mockturtle/views/topo_view.hpp>
+
+using namespace mockturtle;
+
+template<class Ntk>
+void build_full_adders( Ntk& ntk )
+{
+  std::vector<signal<Ntk>> a, b;
+  for ( auto i = 0; i < 4; ++i )
+  {
+    a.push_back( ntk.create_pi() );
+    b.push_back( ntk.create_pi() );
+  }
+  auto carry = ntk.create_pi();
+  for ( auto i = 0; i < 4; ++i )
+  {
+    ntk.create_po( ntk.create_xor( ntk.create_xor( a[i], b[i] ), carry ) );
+    carry = ntk.create_maj( a[i], b[i], carry );
+  }
+  ntk.create_po( !carry );
+
+  /* dangling gate */
+  ntk.create_and( a[0], !b[3] );
+}
+
+template<class Ntk>
+void check_compact_view()
+{
+  Ntk ntk;
+  build_full_adders( ntk );
+
+  compact_view view{ntk};
+  CHECK( is_topologically_sorted_v<compact_view<Ntk>> );
+
+  default_simulator<kitty::static_truth_table<9>> sim;
+  CHECK( simulate<kitty::static_truth_table<9>>( view, sim ) == simulate<kitty::static_truth_table<9>>( ntk, sim ) );
+
+  depth_view depth{ntk};
+  CHECK( view.depth() == depth.depth() );
+  view.foreach_gate( [&]( auto n ) {
+    CHECK( view.level( n ) == depth.level( n ) );
+    CHECK( view.is_and( n ) == ntk.is_and( n ) );
+    CHECK( view.is_xor( n ) == ntk.is_xor( n ) );
+    CHECK( view.is_maj( n ) == ntk.is_maj( n ) );
+    view.foreach_fanin( n, [&]( auto const& f, auto i ) {
+      ntk.foreach_fanin( n, [&]( auto const& g, auto j ) {
+        if ( static_cast<uint32_t>( i ) == static_cast<uint32_t>( j ) )
+        {
+          CHECK( f == g );
+        }
+      } );
+    } );
+  } );
+
+  /* the dangling gate is not traversed */
+  CHECK( view.num_reachable_gates() + 1u == ntk.num_gates() );
+
+  cut_enumeration_params ps;
+  ps.cut_size = 4;
+  const auto cuts_view = cut_enumeration<compact_view<Ntk>, true>( view, ps );
+  const auto cuts_ntk = cut_enumeration<topo_view<Ntk>, true>( topo_view{ntk}, ps );
+  view.foreach_node( [&]( auto n ) {
+    CHECK( cuts_view.cuts( n ).size() == cuts_ntk.cuts( n ).size() );
+  } );
+  CHECK( cuts_view.total_cuts() == cuts_ntk.total_cuts() );
+}
+
+TEST_CASE( "compact_view on an AIG", "[compact_view]" )
+{
+  check_compact_view<aig_network>();
+}
+
+TEST_CASE( "compact_view on an XAG", "[compact_view]" )
+{
+  check_compact_view<xag_network>();
+}
+
+TEST_CASE( "compact_view on an MIG", "[compact_view]" )
+{
+  check_compact_view<mig_network>();
+}
+
+TEST_CASE( "compact_view on an AIG without topo order", "[compact_view]" )
+{
+  aig_network aig;
+
+  const auto x1 = aig.create_pi();
+  const auto x2 = aig.create_pi();
+  const auto x3 = aig.create_pi();
+  const auto gate1 = aig.create_and( x1, x2 );
+  const auto gate2 = aig.create_and( x3, gate1 );
+
+  /* switch gate order on storage */
+  aig._storage->nodes[aig.get_node( gate2 )].children[0].index = aig.get_node( x1 );
+  aig._storage->nodes[aig.get_node( gate2 )].children[1].index = aig.get_node( x2 );
+
+  aig._storage->nodes[aig.get_node( gate1 )].children[0].index = aig.get_node( x3 );
+  aig._storage->nodes[aig.get_node( gate1 )].children[1].index = aig.get_node( gate2 );
+
+  aig.create_po( gate1 );
+
+  compact_view view{aig};
+  std::vector<node<aig_network>> nodes;
+  view.foreach_node( [&nodes]( auto node ) { nodes.push_back( node ); } );
+  CHECK( nodes == std::vector<node<aig_network>>{{0, 1, 2, 3, 5, 4}} );
+  CHECK( view.level( aig.get_node( gate1 ) ) == 2u );
+  CHECK( view.depth() == 2u );
+}
+
+TEST_CASE( "values of a compact_view are separate from the network", "[compact_view]" )
+{
+  aig_network aig;
+  const auto a = aig.create_pi();
+  const auto b = aig.create_pi();
+  const auto f = aig.create_and( a, b );
+  aig.create_po( f );
+
+  compact_view view{aig};
+  aig.clear_values();
+  aig.set_value( aig.get_node( f ), 7u );
+
+  view.set_value( aig.get_node( f ), 3u );
+  view.set_visited( aig.get_node( f ), 1u );
+  CHECK( view.value( aig.get_node( f ) ) == 3u );
+  CHECK( view.visited( aig.get_node( f ) ) == 1u );
+  CHECK( aig.value( aig.get_node( f ) ) == 7u );
+}
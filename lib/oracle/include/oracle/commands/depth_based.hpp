@@ -16,7 +16,7 @@ class depth_partition_command : public alice::command{
 public:
   explicit depth_partition_command( const environment::ptr& env )
     : command( env, "Optimize partitions with MIGs or AIGs based on their logic depth." ){
-    opts.add_option( "--num_parts,p", num_parts, "Number of partitions to create" )->required();
+    opts.add_option( "--num_parts,p", num_parts, "Number of partitions to create (chosen automatically if omitted)" );
     opts.add_option( "--out,-o", out_file, "Verilog output" )->required();
   }
 
@@ -30,6 +30,10 @@ protected:
       mockturtle::depth_view depth{ntk};
       std::cout << "Ntk size = " << ntk.num_gates() << " and depth = " << depth.depth() << "\n";
 
+      if(!is_set("num_parts")){
+        num_parts = oracle::auto_partition_count(ntk.num_gates());
+        std::cout << "Using " << num_parts << " partitions\n";
+      }
       oracle::partition_manager<mockturtle::aig_network> partitions_aig(ntk, num_parts);
 
       std::vector<int> aig_based;
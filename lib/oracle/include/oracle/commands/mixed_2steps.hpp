@@ -24,7 +24,7 @@ namespace alice
       explicit mixed_2step_command( const environment::ptr& env )
         : command( env, "Performs AIG optimization on corresponding partitions and then repartition for MIG optimization" ){
         opts.add_option( "--nn_model,-c", nn_model, "Trained neural network model for classification" );
-        opts.add_option( "--num_parts,-p", num_parts, "Number of partitions to create" )->required();
+        opts.add_option( "--num_parts,-p", num_parts, "Number of partitions to create (chosen automatically if omitted)" );
         opts.add_option( "--out,-o", out_file, "Verilog output" )->required();
         add_flag("--brute,-b", "Uses a brute force approach instead of classification");
       }
@@ -42,6 +42,10 @@ namespace alice
           mockturtle::mig_npn_resynthesis resyn_mig;
           mockturtle::xag_npn_resynthesis<mockturtle::aig_network> resyn_aig;
 
+          if(!is_set("num_parts")){
+            num_parts = oracle::auto_partition_count(ntk.num_gates());
+            std::cout << "Using " << num_parts << " partitions\n";
+          }
           oracle::partition_manager<mockturtle::aig_network> partitions_aig(ntk, num_parts);
 
           std::vector<int> aig_parts1;
@@ -11,6 +11,7 @@
 
 #include <stdio.h>
 #include <fstream>
+#include <utility>
 
 #include <sys/stat.h>
 #include <stdlib.h>
@@ -24,13 +25,55 @@ namespace alice
       explicit partitioning_command( const environment::ptr& env )
         : command( env, "Partitionins current network using k-means hypergraph partitioner" ) {
 
-          opts.add_option( "--num,num", num_partitions, "Number of desired partitions" )->required();
-          opts.add_option( "--config_direc,-c", config_direc, "Path to the configuration file for KaHyPar (../../core/test.ini is default)" );
+          opts.add_option( "--num,num", num_partitions, "Number of desired partitions (chosen automatically if omitted)" );
+          opts.add_option( "--size,-s", sizing.target_size, "Automatic mode: desired gates per partition [DEFAULT = from the thread count]" );
+          opts.add_option( "--max_inputs,-i", sizing.max_inputs, "Automatic mode: repartition until no partition has more inputs" );
+          opts.add_option( "--threads,-t", num_threads, "Partitioning trials run at once and, in automatic mode, threads that optimize the partitions [DEFAULT = all hardware threads]" );
+          opts.add_option( "--trials,-T", trials.trials, "Partition with this many seeds and keep the best result [DEFAULT = 1]" );
+          opts.add_option( "--config_direc,-c", config_direc, "Path to a configuration file for KaHyPar, replaces the preset" );
+          opts.add_option( "--preset,-p", preset, "KaHyPar preset: fast, default or quality [DEFAULT = default]" );
+          opts.add_option( "--epsilon,-e", epsilon, "Allowed imbalance of the partition sizes [DEFAULT = 0.5]" );
+          opts.add_option( "--objective,-o", objective, "Partitioning objective: km1 or cut [DEFAULT = from the preset]" );
+          opts.add_option( "--seed", seed, "Random seed of KaHyPar [DEFAULT = from the preset]" );
+          opts.add_option( "--coarsening_limit", coarsening_limit, "Stop coarsening at this many hypernodes per partition [DEFAULT = from the preset]" );
+          opts.add_option( "--max_net_size", max_net_size, "Ignore larger hyperedges while coarsening [DEFAULT = from the preset]" );
+          add_flag("--boundary,-b", "Keep the trial with the fewest partition inputs and outputs instead of the best KaHyPar objective");
           add_flag("--mig,-m", "Partitions stored MIG network (AIG network is default)");
+          add_flag("--xag,-x", "Partitions stored XAG network (AIG network is default)");
         }
 
     protected:
       void execute(){
+        config = oracle::kahypar_config{preset, config_direc, epsilon};
+        preset = "default";
+        config_direc = "";
+        epsilon = 0.5;
+        auto sizing_ps = std::exchange(sizing, oracle::partition_sizing_params{});
+        sizing_ps.num_threads = trials.num_threads = std::exchange(num_threads, 0u);
+        if(is_set("objective")){
+          if(objective != "km1" && objective != "cut"){
+            std::cout << "Objective must be km1 or cut\n";
+            return;
+          }
+          config.objective = objective;
+        }
+        if(is_set("seed")){
+          config.seed = seed;
+        }
+        if(is_set("coarsening_limit")){
+          config.coarsening_limit = coarsening_limit;
+        }
+        if(is_set("max_net_size")){
+          config.max_net_size = max_net_size;
+        }
+        if(config.ini().empty()){
+          return;
+        }
+        trials.boundary_objective = is_set("boundary");
+        if(is_set("seed")){
+          trials.first_seed = seed;
+        }
+
         mockturtle::mig_npn_resynthesis resyn_mig;
         mockturtle::xag_npn_resynthesis<mockturtle::aig_network> resyn_aig;
         if(is_set("mig")){
@@ -38,32 +81,29 @@ namespace alice
             std::cout << "Partitioning stored MIG network\n";
             auto ntk = store<mockturtle::mig_network>().current();
 
-            if(config_direc != ""){
-              oracle::partition_manager<mockturtle::mig_network> partitions(ntk, num_partitions, config_direc);
-              store<oracle::partition_manager<mockturtle::mig_network>>().extend() = partitions;
-            }
-            else{
-              oracle::partition_manager<mockturtle::mig_network> partitions(ntk, num_partitions);
-              store<oracle::partition_manager<mockturtle::mig_network>>().extend() = partitions;
-            }           
+            store<oracle::partition_manager<mockturtle::mig_network>>().extend() = partition(ntk, sizing_ps);           
           }
           else{
             std::cout << "MIG network not stored\n";
           }
         }
+        else if(is_set("xag")){
+          if(!store<mockturtle::xag_network>().empty()){
+            std::cout << "Partitioning stored XAG network\n";
+            auto ntk = store<mockturtle::xag_network>().current();
+
+            store<oracle::partition_manager<mockturtle::xag_network>>().extend() = partition(ntk, sizing_ps);
+          }
+          else{
+            std::cout << "XAG network not stored\n";
+          }
+        }
         else{
           if(!store<mockturtle::aig_network>().empty()){
             std::cout << "Partitioning stored AIG network\n";
             auto ntk = store<mockturtle::aig_network>().current();
 
-            if(config_direc != ""){
-              oracle::partition_manager<mockturtle::aig_network> partitions(ntk, num_partitions, config_direc);
-              store<oracle::partition_manager<mockturtle::aig_network>>().extend() = partitions;
-            }
-            else{
-              oracle::partition_manager<mockturtle::aig_network> partitions(ntk, num_partitions);
-              store<oracle::partition_manager<mockturtle::aig_network>>().extend() = partitions;
-            }
+            store<oracle::partition_manager<mockturtle::aig_network>>().extend() = partition(ntk, sizing_ps);
           }
           else{
             std::cout << "AIG network not stored\n";
@@ -71,8 +111,39 @@ namespace alice
         }
       }
     private:
+      template<class Ntk>
+      oracle::partition_manager<Ntk> partition(Ntk const& ntk, oracle::partition_sizing_params sizing_ps){
+        oracle::partition_trials_stats st;
+        oracle::partition_manager<Ntk> partitions;
+        if(is_set("num")){
+          partitions = oracle::best_partition(ntk, num_partitions, config, trials, &st);
+        }
+        else{
+          sizing_ps.verbose = true;
+          partitions = oracle::auto_partition(ntk, sizing_ps, config, trials, &st);
+          std::cout << "Using " << partitions.get_part_num() << " partitions for " << ntk.num_gates() << " gates\n";
+        }
+
+        if(trials.trials > 1u){
+          std::cout << "Best of " << st.trials.size() << " trials: seed " << st.best_seed << ", objective " << st.best_objective
+                    << ", " << st.best_boundary << " partition inputs and outputs (reproduce with --seed " << st.best_seed << ")\n";
+        }
+        trials.trials = 1u;
+        return partitions;
+      }
+
       int num_partitions{};
+      oracle::partition_sizing_params sizing{};
       std::string config_direc = "";
+      std::string preset = "default";
+      double epsilon{0.5};
+      std::string objective = "";
+      int seed{-1};
+      uint32_t coarsening_limit{};
+      uint32_t max_net_size{};
+      oracle::kahypar_config config{};
+      uint32_t num_threads{0u};
+      oracle::partition_trials_params trials{};
   };
 
   ALICE_ADD_COMMAND(partitioning, "Partitioning");
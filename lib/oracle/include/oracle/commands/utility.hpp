@@ -93,7 +93,7 @@ namespace alice
     }
 
     aig.foreach_pi( [&]( auto n ) {
-      node2new[n] = mig.create_pi();
+      node2new[n] = aig.is_ro( n ) ? mig.create_ro() : mig.create_pi();
     } );
         
     aig.foreach_node( [&]( auto n ) {
@@ -115,9 +115,14 @@ namespace alice
           
     } );
 
-    /* map primary outputs */
-    aig.foreach_po( [&]( auto const& f ) {
-      mig.create_po( aig.is_complemented( f ) ? mig.create_not( node2new[f] ) : node2new[f] );
+    /* map primary outputs and register inputs */
+    auto const num_outputs = aig.num_pos() - aig.num_latches();
+    aig.foreach_po( [&]( auto const& f, auto i ) {
+      auto const out = aig.is_complemented( f ) ? mig.create_not( node2new[f] ) : node2new[f];
+      if ( i < num_outputs )
+        mig.create_po( out );
+      else
+        mig.create_ri( out, aig.latch_reset( i - num_outputs ) );
     } );
 
     return mig;
@@ -190,7 +195,7 @@ namespace alice
     }
 
     mig.foreach_pi( [&]( auto n ) {
-      node2new[n] = aig.create_pi();
+      node2new[n] = mig.is_ro( n ) ? aig.create_ro() : aig.create_pi();
     } );
     
     std::set<mockturtle::mig_network::node> nodes_to_change;    
@@ -226,14 +231,132 @@ namespace alice
           
     } );
 
-    /* map primary outputs */
-    mig.foreach_po( [&]( auto const& f ) {
-      aig.create_po( mig.is_complemented( f ) ? aig.create_not( node2new[f] ) : node2new[f] );
+    /* map primary outputs and register inputs */
+    auto const num_outputs = mig.num_pos() - mig.num_latches();
+    mig.foreach_po( [&]( auto const& f, auto i ) {
+      auto const out = mig.is_complemented( f ) ? aig.create_not( node2new[f] ) : node2new[f];
+      if ( i < num_outputs )
+        aig.create_po( out );
+      else
+        aig.create_ri( out, mig.latch_reset( i - num_outputs ) );
     } );
 
     return aig;
   }
 
+  mockturtle::xag_network aig_to_xag(mockturtle::aig_network aig){
+    mockturtle::xag_network xag;
+
+    mockturtle::node_map<mockturtle::xag_network::signal, mockturtle::aig_network> node2new( aig );
+
+    node2new[aig.get_node( aig.get_constant( false ) )] = xag.get_constant( false );
+
+    aig.foreach_pi( [&]( auto n ) {
+      node2new[n] = aig.is_ro( n ) ? xag.create_ro() : xag.create_pi();
+    } );
+
+    aig.foreach_node( [&]( auto n ) {
+      if ( aig.is_constant( n ) || aig.is_pi( n ) || aig.is_ci( n ) || aig.is_ro( n ))
+        return;
+
+      std::vector<mockturtle::xag_network::signal> children;
+      aig.foreach_fanin( n, [&]( auto const& f ) {
+        children.push_back( aig.is_complemented( f ) ? xag.create_not( node2new[f] ) : node2new[f] );
+      } );
+
+      node2new[n] = xag.create_and(children.at(0), children.at(1));
+    } );
+
+    /* map primary outputs and register inputs */
+    auto const num_outputs = aig.num_pos() - aig.num_latches();
+    aig.foreach_po( [&]( auto const& f, auto i ) {
+      auto const out = aig.is_complemented( f ) ? xag.create_not( node2new[f] ) : node2new[f];
+      if ( i < num_outputs )
+        xag.create_po( out );
+      else
+        xag.create_ri( out, aig.latch_reset( i - num_outputs ) );
+    } );
+
+    return xag;
+  }
+
+  mockturtle::xag_network part_to_xag(oracle::partition_view<mockturtle::xag_network> part){
+    mockturtle::xag_network xag;
+
+    std::unordered_map<mockturtle::xag_network::node, mockturtle::xag_network::signal> node2new;
+
+    node2new[part.get_node( part.get_constant( false ) )] = xag.get_constant( false );
+
+    part.foreach_pi( [&]( auto n ) {
+      node2new[n] = xag.create_pi();
+    } );
+
+    part.foreach_node( [&]( auto n ) {
+      if ( part.is_constant( n ) || part.is_pi( n ) || part.is_ci( n ) || part.is_ro( n ))
+        return;
+
+      std::vector<mockturtle::xag_network::signal> children;
+      part.foreach_fanin( n, [&]( auto const& f ) {
+        children.push_back( part.is_complemented( f ) ? xag.create_not( node2new[part.get_node(f)] ) : node2new[part.get_node(f)] );
+      } );
+
+      if(part.is_xor(n)){
+        node2new[n] = xag.create_xor(children.at(0), children.at(1));
+      }
+      else{
+        node2new[n] = xag.create_and(children.at(0), children.at(1));
+      }
+    } );
+
+    /* map primary outputs */
+    part.foreach_po( [&]( auto const& f ) {
+      xag.create_po( part.is_complemented( f ) ? xag.create_not( node2new[part.get_node(f)] ) : node2new[part.get_node(f)] );
+    } );
+
+    return xag;
+  }
+
+  mockturtle::mig_network xag_to_mig(mockturtle::xag_network xag){
+    mockturtle::mig_network mig;
+
+    mockturtle::node_map<mockturtle::mig_network::signal, mockturtle::xag_network> node2new( xag );
+
+    node2new[xag.get_node( xag.get_constant( false ) )] = mig.get_constant( false );
+
+    xag.foreach_ci( [&]( auto n ) {
+      node2new[n] = xag.is_ro( n ) ? mig.create_ro() : mig.create_pi();
+    } );
+
+    xag.foreach_node( [&]( auto n ) {
+      if ( xag.is_constant( n ) || xag.is_pi( n ) || xag.is_ci( n ) || xag.is_ro( n ))
+        return;
+
+      std::vector<mockturtle::mig_network::signal> children;
+      xag.foreach_fanin( n, [&]( auto const& f ) {
+        children.push_back( xag.is_complemented( f ) ? mig.create_not( node2new[f] ) : node2new[f] );
+      } );
+
+      if(xag.is_xor(n)){
+        node2new[n] = mig.create_xor(children.at(0), children.at(1));
+      }
+      else{
+        node2new[n] = mig.create_and(children.at(0), children.at(1));
+      }
+    } );
+
+    /* map primary outputs and register inputs */
+    auto const num_outputs = xag.num_pos();
+    xag.foreach_co( [&]( auto const& f, auto i ) {
+      auto const out = xag.is_complemented( f ) ? mig.create_not( node2new[f] ) : node2new[f];
+      if ( i < num_outputs )
+        mig.create_po( out );
+      else
+        mig.create_ri( out, xag.latch_reset( i - num_outputs ) );
+    } );
+
+    return mig;
+  }
+
   /***************************************************/
 
   /***************************************************
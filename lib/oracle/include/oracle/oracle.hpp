@@ -34,6 +34,12 @@
 
 #include "partitioning/partition_manager.hpp"
 #include "partitioning/partition_view.hpp"
+#include "partitioning/partition_store.hpp"
+#include "partitioning/partition_trials.hpp"
+#include "partitioning/seam_rewriting.hpp"
+#include "partitioning/partition_budget.hpp"
+#include "partitioning/optimize_loop.hpp"
+#include "partitioning/partition_sizing.hpp"
 #include "partitioning/hyperg.hpp"
 
 #include "partitioning/cluster.hpp"
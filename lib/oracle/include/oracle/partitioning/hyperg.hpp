@@ -14,6 +14,7 @@ class hypergraph {
 
   Ntk const& ntk;
   std::vector<std::vector<uint32_t>> hyperEdges;
+  std::vector<int> hyperEdgeWeights;
   std::set<Ntk::node> nodes;
   std::vector<uint32_t> connections;
 
@@ -24,6 +25,8 @@ public:
 
   void return_hyperedges(std::vector<uint32_t> &connections);
 
+  void return_hyperedge_weights(std::vector<int> &weights);
+
   int get_num_edges();
 
   int get_num_vertices();
@@ -77,6 +80,9 @@ void hypergraph<Ntk>::get_hypergraph(Ntk const& ntk) {
       //Add root node to the hyper edge
       connection_to_add.insert(connection_to_add.begin(), nodeNdx);
       hyperEdges.push_back(connection_to_add);
+      //Register outputs are inputs of every partition anyway, so cutting their nets is cheaper
+      //and pulls the partition boundaries towards the registers of sequential designs
+      hyperEdgeWeights.push_back(ntk.is_ro(node) ? 1 : 2);
     }
   });
 }
@@ -104,6 +110,11 @@ void hypergraph<Ntk>::return_hyperedges(std::vector<uint32_t> &connections) {
   }
 }
 
+template<class Ntk>
+void hypergraph<Ntk>::return_hyperedge_weights(std::vector<int> &weights) {
+  weights = hyperEdgeWeights;
+}
+
 template<class Ntk>
 int hypergraph<Ntk>::get_num_edges() {
   return hyperEdges.size();
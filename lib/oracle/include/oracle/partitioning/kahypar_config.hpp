@@ -0,0 +1,223 @@
+/*!
+  \file kahypar_config.hpp
+  \brief Built-in KaHyPar configurations
+
+  KaHyPar is configured from ini-style settings.  Instead of depending on a
+  file relative to the working directory, the presets below are compiled in
+  and handed to KaHyPar from memory.  A configuration file can still be
+  given, and single settings can be overridden on top of either.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <libkahypar.h>
+
+namespace oracle
+{
+
+  namespace detail
+  {
+    /* direct k-way km1 partitioning, as in core/test.ini */
+    inline const char* const kahypar_default_preset =
+      "mode=direct\n"
+      "objective=km1\n"
+      "seed=-1\n"
+      "cmaxnet=1000\n"
+      "vcycles=0\n"
+      "p-use-sparsifier=true\n"
+      "p-sparsifier-min-median-he-size=28\n"
+      "p-sparsifier-max-hyperedge-size=1200\n"
+      "p-sparsifier-max-cluster-size=10\n"
+      "p-sparsifier-min-cluster-size=2\n"
+      "p-sparsifier-num-hash-func=5\n"
+      "p-sparsifier-combined-num-hash-func=100\n"
+      "p-detect-communities=true\n"
+      "p-detect-communities-in-ip=true\n"
+      "p-reuse-communities=false\n"
+      "p-max-louvain-pass-iterations=100\n"
+      "p-min-eps-improvement=0.0001\n"
+      "p-louvain-edge-weight=hybrid\n"
+      "c-type=ml_style\n"
+      "c-s=1\n"
+      "c-t=160\n"
+      "c-rating-score=heavy_edge\n"
+      "c-rating-use-communities=true\n"
+      "c-rating-heavy_node_penalty=no_penalty\n"
+      "c-rating-acceptance-criterion=best_prefer_unmatched\n"
+      "c-fixed-vertex-acceptance-criterion=fixed_vertex_allowed\n"
+      "i-mode=recursive\n"
+      "i-technique=multi\n"
+      "i-c-type=ml_style\n"
+      "i-c-s=1\n"
+      "i-c-t=150\n"
+      "i-c-rating-score=heavy_edge\n"
+      "i-c-rating-use-communities=true\n"
+      "i-c-rating-heavy_node_penalty=no_penalty\n"
+      "i-c-rating-acceptance-criterion=best_prefer_unmatched\n"
+      "i-c-fixed-vertex-acceptance-criterion=fixed_vertex_allowed\n"
+      "i-algo=pool\n"
+      "i-runs=20\n"
+      "i-r-type=twoway_fm\n"
+      "i-r-runs=-1\n"
+      "i-r-fm-stop=simple\n"
+      "i-r-fm-stop-i=50\n"
+      "r-type=kway_fm_km1\n"
+      "r-runs=-1\n"
+      "r-fm-stop=adaptive_opt\n"
+      "r-fm-stop-alpha=1\n"
+      "r-fm-stop-i=350\n";
+  } /* namespace detail */
+
+  /*! \brief Settings handed to KaHyPar by partition_manager.
+   *
+   * The settings come from `config_file` if it is set and from the embedded
+   * preset otherwise.  The presets are
+   *
+   * - `default`: the configuration LSOracle has always used,
+   * - `fast`: fewer initial partitioning runs, no community detection and
+   *   earlier stopping local search,
+   * - `quality`: more initial partitioning runs, longer local search and
+   *   two V-cycles of refinement.
+   *
+   * The optional members override the corresponding setting of either.
+   */
+  struct kahypar_config
+  {
+    std::string preset{"default"};
+    std::string config_file{};
+
+    /*! \brief Allowed imbalance of the partition sizes. */
+    double epsilon{0.5};
+
+    /*! \brief Objective, `km1` or `cut`. */
+    std::optional<std::string> objective{};
+
+    std::optional<int> seed{};
+
+    /*! \brief Coarsening stops at `coarsening_limit * k` hypernodes. */
+    std::optional<uint32_t> coarsening_limit{};
+
+    /*! \brief Hyperedges larger than this are ignored while coarsening. */
+    std::optional<uint32_t> max_net_size{};
+
+    static std::vector<std::string> presets()
+    {
+      return {"fast", "default", "quality"};
+    }
+
+    /*! \brief Returns the settings as ini text, or an empty string for an unknown preset or unreadable file. */
+    std::string ini() const
+    {
+      std::string text;
+      if ( !config_file.empty() )
+      {
+        std::ifstream file( config_file );
+        if ( !file )
+        {
+          std::cerr << "[e] cannot read KaHyPar configuration " << config_file << "\n";
+          return "";
+        }
+        std::stringstream contents;
+        contents << file.rdbuf();
+        text = contents.str();
+      }
+      else if ( preset == "default" )
+      {
+        text = detail::kahypar_default_preset;
+      }
+      else if ( preset == "fast" )
+      {
+        text = detail::kahypar_default_preset;
+        set( text, "p-detect-communities", "false" );
+        set( text, "p-detect-communities-in-ip", "false" );
+        set( text, "c-rating-use-communities", "false" );
+        set( text, "i-c-rating-use-communities", "false" );
+        set( text, "i-runs", "5" );
+        set( text, "i-r-fm-stop-i", "25" );
+        set( text, "r-fm-stop-i", "50" );
+      }
+      else if ( preset == "quality" )
+      {
+        text = detail::kahypar_default_preset;
+        set( text, "vcycles", "2" );
+        set( text, "i-runs", "50" );
+        set( text, "r-fm-stop-i", "1000" );
+      }
+      else
+      {
+        std::cerr << "[e] unknown KaHyPar preset " << preset << " (fast, default and quality are available)\n";
+        return "";
+      }
+
+      if ( objective )
+      {
+        set( text, "objective", *objective );
+        /* the km1 local search only optimizes the km1 objective */
+        set( text, "r-type", *objective == "cut" ? "kway_fm" : "kway_fm_km1" );
+      }
+      if ( seed )
+      {
+        set( text, "seed", std::to_string( *seed ) );
+      }
+      if ( coarsening_limit )
+      {
+        set( text, "c-t", std::to_string( *coarsening_limit ) );
+      }
+      if ( max_net_size )
+      {
+        set( text, "cmaxnet", std::to_string( *max_net_size ) );
+      }
+      return text;
+    }
+
+    /*! \brief Configures a KaHyPar context, returns false if the settings could not be loaded. */
+    bool configure( kahypar_context_t* context ) const
+    {
+      const auto text = ini();
+      if ( text.empty() )
+      {
+        return false;
+      }
+      kahypar_configure_context_from_string( context, text.c_str() );
+      return true;
+    }
+
+  private:
+    /* replaces the value of key, or appends it if the text does not set it */
+    static void set( std::string& text, std::string const& key, std::string const& value )
+    {
+      std::size_t pos = 0;
+      while ( pos < text.size() )
+      {
+        auto end = text.find( '\n', pos );
+        if ( end == std::string::npos )
+        {
+          end = text.size();
+        }
+        auto name = text.substr( pos, end - pos );
+        name = name.substr( 0, name.find( '=' ) );
+        name.erase( name.find_last_not_of( ' ' ) + 1 );
+        if ( name == key )
+        {
+          text.replace( pos, end - pos, key + "=" + value );
+          return;
+        }
+        pos = end + 1;
+      }
+      if ( !text.empty() && text.back() != '\n' )
+      {
+        text += '\n';
+      }
+      text += key + "=" + value + "\n";
+    }
+  };
+
+} /* namespace oracle */
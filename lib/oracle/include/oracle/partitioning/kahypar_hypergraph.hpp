@@ -0,0 +1,85 @@
+/*!
+  \file kahypar_hypergraph.hpp
+  \brief Hypergraph of a network in the layout expected by KaHyPar
+
+  The hypergraph is built once and can be partitioned repeatedly, for
+  example with different seeds.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include <libkahypar.h>
+
+#include "hyperg.hpp"
+#include "kahypar_config.hpp"
+
+namespace oracle
+{
+
+  template<typename Ntk>
+  class kahypar_hypergraph
+  {
+  public:
+    explicit kahypar_hypergraph( Ntk const& ntk )
+    {
+      std::vector<unsigned long> set_indices;
+      std::vector<int> edge_weights;
+
+      oracle::hypergraph<Ntk> t( ntk );
+      t.get_hypergraph( ntk );
+      t.return_hyperedges( _hyperedges );
+      _num_hyperedges = t.get_num_edges();
+      _num_vertices = t.get_num_vertices();
+      t.get_indeces( set_indices );
+      t.return_hyperedge_weights( edge_weights );
+      t.dump();
+
+      //edges have the same weight except for register outputs, which are cheaper to cut
+      _hyperedge_weights.assign( edge_weights.begin(), edge_weights.end() );
+      _hyperedge_indices.assign( set_indices.begin(), set_indices.end() );
+    }
+
+    /*! \brief Returns the partition of every node index, and the value of the KaHyPar objective in objective. */
+    std::vector<int> partition( int part_num, kahypar_config const& config, int* objective = nullptr ) const
+    {
+      kahypar_context_t* context = kahypar_context_new();
+      if ( !config.configure( context ) )
+      {
+        kahypar_context_free( context );
+        throw std::invalid_argument( "invalid KaHyPar configuration" );
+      }
+
+      kahypar_hyperedge_weight_t value = 0;
+      std::vector<kahypar_partition_id_t> partition( _num_vertices, -1 );
+
+      kahypar_partition( _num_vertices, _num_hyperedges,
+                         config.epsilon, part_num, nullptr, _hyperedge_weights.data(),
+                         _hyperedge_indices.data(), _hyperedges.data(),
+                         &value, context, partition.data() );
+      kahypar_context_free( context );
+
+      if ( objective != nullptr )
+      {
+        *objective = value;
+      }
+      return std::vector<int>( partition.begin(), partition.end() );
+    }
+
+    uint32_t num_vertices() const
+    {
+      return _num_vertices;
+    }
+
+  private:
+    kahypar_hypernode_id_t _num_vertices{};
+    kahypar_hyperedge_id_t _num_hyperedges{};
+    std::vector<kahypar_hyperedge_weight_t> _hyperedge_weights;
+    std::vector<std::size_t> _hyperedge_indices;
+    std::vector<kahypar_hyperedge_id_t> _hyperedges;
+  };
+
+} /* namespace oracle */
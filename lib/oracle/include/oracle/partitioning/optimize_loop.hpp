@@ -0,0 +1,232 @@
+/*!
+  \file optimize_loop.hpp
+  \brief Repeated partitioning and per-partition optimization
+
+  Every iteration partitions the network with a new KaHyPar seed, so that
+  the partition boundaries move, optimizes the partitions in parallel and
+  merges them back.  Logic that was cut by a boundary in one iteration lies
+  inside a partition in a later one.  The loop stops when an iteration
+  improves the area-delay product by less than a threshold, or when the
+  time budget would be exceeded.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include <mockturtle/algorithms/cleanup.hpp>
+#include <mockturtle/views/depth_view.hpp>
+
+#include "kahypar_config.hpp"
+#include "partition_budget.hpp"
+#include "partition_manager.hpp"
+#include "partition_sizing.hpp"
+#include "partition_view.hpp"
+
+namespace oracle
+{
+
+  struct optimize_loop_params
+  {
+    /*! \brief Partitions per iteration (0 chooses the count from the network size). */
+    uint32_t num_parts{0u};
+
+    /*! \brief Largest number of iterations. */
+    uint32_t max_iterations{8u};
+
+    /*! \brief Stop once an iteration improves the area-delay product by less than this fraction. */
+    double min_improvement{0.01};
+
+    /*! \brief Time budget in seconds (0 for no budget). */
+    double time_budget{0.0};
+
+    /*! \brief Seed of the first iteration, the following ones use first_seed + 1, ... */
+    int first_seed{1};
+
+    /*! \brief Threads optimizing the partitions (0 uses all hardware threads). */
+    uint32_t num_threads{0u};
+
+    bool verbose{false};
+  };
+
+  struct optimize_loop_iteration
+  {
+    int seed{0};
+    uint32_t num_parts{0u};
+    uint32_t gates{0u};
+    uint32_t depth{0u};
+    int64_t milliseconds{0};
+
+    /*! \brief The result is kept only if it improved the area-delay product. */
+    bool accepted{false};
+  };
+
+  struct optimize_loop_stats
+  {
+    uint32_t initial_gates{0u};
+    uint32_t initial_depth{0u};
+    std::vector<optimize_loop_iteration> iterations;
+
+    /*! \brief The loop stopped because the time budget was exhausted. */
+    bool out_of_time{false};
+  };
+
+  namespace detail
+  {
+    template<typename Ntk>
+    uint64_t area_delay( Ntk const& ntk )
+    {
+      mockturtle::depth_view<Ntk> depth{ntk};
+      return uint64_t( ntk.num_gates() ) * std::max( 1u, depth.depth() );
+    }
+  } /* namespace detail */
+
+  /*! \brief Alternates repartitioning and parallel partition optimization until convergence.
+   *
+   * `extract` turns a `partition_view<Ntk>` into a stand-alone `Ntk`; it runs
+   * sequentially, because partition views share the traversal marks of the
+   * network.  `make_opt` is called once per thread and returns a callable
+   * that optimizes such a network in place, as for
+   * `mockturtle::window_rewriting`.  With a time budget, the optimizer may
+   * also take a `mockturtle::deadline` as second argument; the time left is
+   * then shared among the partitions of the iteration by their size.  An
+   * iteration whose result has a larger area-delay product than its input is
+   * discarded.
+   *
+   * \param ntk Network (replaced by the best network found)
+   * \param extract Partition extraction, `Ntk( partition_view<Ntk> const& )`
+   * \param make_opt Factory of per-thread partition optimizers
+   * \param config KaHyPar settings, the seed is set by the loop
+   */
+  template<typename Ntk, typename Extract, typename OptFactory>
+  void optimize_loop( Ntk& ntk, Extract&& extract, OptFactory&& make_opt, kahypar_config config, optimize_loop_params const& ps = {}, optimize_loop_stats* pst = nullptr )
+  {
+    using clock = std::chrono::steady_clock;
+    const auto start = clock::now();
+    const auto elapsed = [&]() {
+      return std::chrono::duration<double>( clock::now() - start ).count();
+    };
+
+    optimize_loop_stats st;
+    {
+      mockturtle::depth_view<Ntk> depth{ntk};
+      st.initial_gates = ntk.num_gates();
+      st.initial_depth = depth.depth();
+    }
+    auto best_adp = detail::area_delay( ntk );
+
+    partition_sizing_params sps;
+    sps.num_threads = ps.num_threads;
+    const uint32_t threads = ps.num_threads != 0u ? ps.num_threads : std::max( 1u, std::thread::hardware_concurrency() );
+
+    double last_iteration = 0.0;
+    for ( auto iteration = 0u; iteration < ps.max_iterations; ++iteration )
+    {
+      /* do not start an iteration that is expected to overrun the budget */
+      if ( ps.time_budget > 0.0 && elapsed() + last_iteration > ps.time_budget )
+      {
+        st.out_of_time = true;
+        break;
+      }
+      const auto iteration_start = clock::now();
+
+      optimize_loop_iteration it;
+      it.seed = ps.first_seed + static_cast<int>( iteration );
+      it.num_parts = ps.num_parts != 0u ? ps.num_parts : auto_partition_count( ntk.num_gates(), sps );
+      config.seed = it.seed;
+
+      Ntk work( std::make_shared<typename Ntk::storage::element_type>( *ntk._storage ) );
+      partition_manager<Ntk> partitions( work, it.num_parts, config );
+
+      std::vector<Ntk> parts;
+      parts.reserve( it.num_parts );
+      for ( auto i = 0u; i < it.num_parts; ++i )
+      {
+        parts.push_back( extract( partitions.create_part( work, i ) ) );
+      }
+
+      std::vector<uint32_t> sizes;
+      for ( auto const& part : parts )
+      {
+        sizes.push_back( part.num_gates() );
+      }
+      partition_budget budget( ps.time_budget > 0.0 ? std::max( ps.time_budget - elapsed(), 1e-3 ) : 0.0, sizes, {}, threads );
+
+      std::atomic<std::size_t> next{0u};
+      auto worker = [&]() {
+        auto opt = make_opt();
+        for ( auto i = next++; i < parts.size(); i = next++ )
+        {
+          if constexpr ( std::is_invocable_v<decltype( opt )&, Ntk&, mockturtle::deadline const&> )
+          {
+            opt( parts[i], budget.start( i ) );
+          }
+          else
+          {
+            opt( parts[i] );
+          }
+        }
+      };
+      std::vector<std::thread> workers;
+      for ( auto i = 1u; i < std::min<std::size_t>( threads, parts.size() ); ++i )
+      {
+        workers.emplace_back( worker );
+      }
+      worker();
+      for ( auto& t : workers )
+      {
+        t.join();
+      }
+
+      for ( auto i = 0u; i < it.num_parts; ++i )
+      {
+        auto part = partitions.create_part( work, i );
+        partitions.synchronize_part( part, parts[i], work );
+      }
+      partitions.connect_outputs( work );
+      work = mockturtle::cleanup_dangling( work );
+
+      const auto adp = detail::area_delay( work );
+      {
+        mockturtle::depth_view<Ntk> depth{work};
+        it.gates = work.num_gates();
+        it.depth = depth.depth();
+      }
+      it.accepted = adp < best_adp;
+      const auto improvement = best_adp != 0u && it.accepted ? double( best_adp - adp ) / best_adp : 0.0;
+      if ( it.accepted )
+      {
+        ntk = work;
+        best_adp = adp;
+      }
+
+      it.milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>( clock::now() - iteration_start ).count();
+      last_iteration = it.milliseconds / 1000.0;
+      if ( ps.verbose )
+      {
+        std::cout << "Iteration " << iteration << ": seed " << it.seed << ", " << it.num_parts << " partitions, size = " << it.gates
+                  << ", depth = " << it.depth << ", " << it.milliseconds << "ms" << ( it.accepted ? "" : " (discarded)" ) << "\n";
+      }
+      st.iterations.push_back( it );
+
+      if ( improvement < ps.min_improvement )
+      {
+        break;
+      }
+    }
+
+    if ( pst )
+    {
+      *pst = st;
+    }
+  }
+
+} /* namespace oracle */
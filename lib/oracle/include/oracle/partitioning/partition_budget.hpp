@@ -0,0 +1,82 @@
+/*!
+  \file partition_budget.hpp
+  \brief Global time budget shared by the partitions of a network
+
+  Every partition gets a deadline when its optimization starts.  The share
+  of a partition is proportional to its weight, its size times its expected
+  gain, among the partitions that have not started yet.  Time left over by
+  partitions that finish early is therefore passed on to the remaining ones.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include <mockturtle/utils/deadline.hpp>
+
+namespace oracle
+{
+
+  class partition_budget
+  {
+  public:
+    /*! \brief Budget of `seconds` for jobs of the given sizes, run on `num_threads` threads.
+     *
+     * `expected_gain` holds a relative gain estimate per job, all jobs are
+     * weighted by size only if it is empty.  A budget of 0 seconds means no
+     * budget.
+     */
+    partition_budget( double seconds, std::vector<uint32_t> const& sizes, std::vector<double> const& expected_gain = {}, uint32_t num_threads = 1u )
+        : _end( seconds > 0.0 ? mockturtle::deadline::after( seconds ) : mockturtle::deadline() ),
+          _started( sizes.size(), false ),
+          _num_threads( std::max( 1u, num_threads ) )
+    {
+      for ( auto i = 0u; i < sizes.size(); ++i )
+      {
+        const auto gain = i < expected_gain.size() ? std::max( expected_gain[i], 0.0 ) : 1.0;
+        _weights.push_back( std::max( 1u, sizes[i] ) * gain );
+        _pending_weight += _weights.back();
+      }
+      _pending = sizes.size();
+    }
+
+    /*! \brief Deadline for job i, which starts now. */
+    mockturtle::deadline start( std::size_t i )
+    {
+      std::lock_guard<std::mutex> lock( _mutex );
+      if ( !_end.is_set() || i >= _started.size() || _started[i] )
+      {
+        return _end;
+      }
+
+      const auto remaining = _end.remaining();
+      const auto parallel = std::min<std::size_t>( _num_threads, _pending );
+      const auto share = _pending_weight > 0.0 ? remaining * parallel * _weights[i] / _pending_weight : remaining;
+
+      _started[i] = true;
+      _pending_weight -= _weights[i];
+      --_pending;
+
+      return mockturtle::deadline::after( std::min( share, remaining ) ).earliest( _end );
+    }
+
+    /*! \brief The overall deadline. */
+    mockturtle::deadline end() const
+    {
+      return _end;
+    }
+
+  private:
+    mockturtle::deadline _end;
+    std::vector<double> _weights;
+    std::vector<bool> _started;
+    double _pending_weight{0.0};
+    std::size_t _pending{0u};
+    uint32_t _num_threads;
+    std::mutex _mutex;
+  };
+
+} /* namespace oracle */
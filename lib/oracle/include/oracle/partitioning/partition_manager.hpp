@@ -41,6 +41,7 @@
 #include <mockturtle/traits.hpp>
 #include "partition_view.hpp"
 #include "hyperg.hpp"
+#include "kahypar_hypergraph.hpp"
 #include <mockturtle/networks/detail/foreach.hpp>
 #include <mockturtle/views/fanout_view.hpp>
 #include <libkahypar.h>
@@ -144,7 +145,22 @@ namespace oracle
       partitionOutputs = outputs;
     }
 
-    partition_manager( Ntk const& ntk, int part_num, std::string config_direc="../../core/test.ini" ) : Ntk( ntk )
+    /*! \brief Partitions by the given partition of every node index. */
+    partition_manager( Ntk const& ntk, std::vector<int> const& partition, int part_num ) : Ntk( ntk )
+    {
+      num_partitions = part_num;
+      for(int i = 0; i < part_num; ++i)
+        _part_scope.push_back(std::set<node>());
+      map_partition(ntk, partition);
+    }
+
+    /*! \brief Partitions with the KaHyPar configuration file config_direc, or with the built-in default preset if it is empty. */
+    partition_manager( Ntk const& ntk, int part_num, std::string config_direc="" )
+      : partition_manager( ntk, part_num, kahypar_config{"default", config_direc} )
+    {
+    }
+
+    partition_manager( Ntk const& ntk, int part_num, kahypar_config const& config ) : Ntk( ntk )
     {
 
       static_assert( mockturtle::is_network_type_v<Ntk>, "Ntk is not a network type" );
@@ -182,120 +198,62 @@ namespace oracle
         }
       }
       else{
-        uint32_t kahyp_num_hyperedges = 0;
-        uint32_t kahyp_num_vertices = 0;
-        uint32_t kahyp_num_indeces_hyper = 0;
-        unsigned long kahyp_num_sets = 0;
-        std::vector<uint32_t> kahypar_connections;
-        std::vector<unsigned long> kahyp_set_indeces;
-
-        /******************
-        Generate HyperGraph
-        ******************/
-
-        oracle::hypergraph<Ntk> t(ntk);
-        t.get_hypergraph(ntk);
-        t.return_hyperedges(kahypar_connections);
-        kahyp_num_hyperedges = t.get_num_edges();
-        kahyp_num_vertices = t.get_num_vertices();
-        kahyp_num_indeces_hyper = t.get_num_indeces();
-        kahyp_num_sets = t.get_num_sets();
-        t.get_indeces(kahyp_set_indeces);
-        t.dump();
-
-        /******************
-        Partition with kahypar
-        ******************/
-        //configures kahypar
-        kahypar_context_t* context = kahypar_context_new();
-        kahypar_configure_context_from_file(context, config_direc.c_str());
-
-        //set number of hyperedges and vertices. These variables are defined by the hyperG command
-        const kahypar_hyperedge_id_t num_hyperedges = kahyp_num_hyperedges;
-        const kahypar_hypernode_id_t num_vertices = kahyp_num_vertices;
-
-        //set all edges to have the same weight
-        std::unique_ptr<kahypar_hyperedge_weight_t[]> hyperedge_weights = std::make_unique<kahypar_hyperedge_weight_t[]>(kahyp_num_vertices);
-
-        for( int i = 0; i < kahyp_num_vertices; i++ )
-          hyperedge_weights[i] = 2;
-
-        //vector with indeces where each set starts
-        std::unique_ptr<size_t[]> hyperedge_indices = std::make_unique<size_t[]>(kahyp_num_sets+1);
-
-        for ( int j = 0; j < kahyp_num_sets+1; j++){
-          hyperedge_indices[j] = kahyp_set_indeces[j];
-        }
+        map_partition(ntk, kahypar_hypergraph<Ntk>(ntk).partition(part_num, config));
+      }
+      
+    }
 
-        std::unique_ptr<kahypar_hyperedge_id_t[]> hyperedges = std::make_unique<kahypar_hyperedge_id_t[]>(kahyp_num_indeces_hyper);
+  private:
+    /* fills the partition scopes and I/O from the partition of every node index */
+    void map_partition(Ntk const& ntk, std::vector<int> const& partition){
+      const int part_num = num_partitions;
 
-        for ( int i = 0; i < kahyp_num_indeces_hyper; i++){
-          hyperedges[i] = kahypar_connections[i];
+      ntk.foreach_node( [&](auto curr_node){
+        //get rid of circuit PIs
+        if (ntk.is_pi(curr_node) ) {
+          _part_scope[partition[ntk.node_to_index(curr_node)]].insert(curr_node);
+          _part_pis.insert(std::pair<int, node>(partition[ntk.node_to_index(curr_node)], curr_node));
         }
 
-        const double imbalance = 0.5;
-        const kahypar_partition_id_t k = part_num;
-
-        kahypar_hyperedge_weight_t objective = 0;
-
-        std::vector<kahypar_partition_id_t> partition(num_vertices, -1);
-
-        kahypar_partition(num_vertices, num_hyperedges,
-                          imbalance, k, nullptr, hyperedge_weights.get(),
-                          hyperedge_indices.get(), hyperedges.get(),
-                          &objective, context, partition.data());
-
-        
-        ntk.foreach_node( [&](auto curr_node){
-          //get rid of circuit PIs
-          if (ntk.is_pi(curr_node) ) {
-            _part_scope[partition[ntk.node_to_index(curr_node)]].insert(curr_node);
-            _part_pis.insert(std::pair<int, node>(partition[ntk.node_to_index(curr_node)], curr_node));
-          }
-
-          if (ntk.is_ro(curr_node)) {
-            _part_scope[partition[ntk.node_to_index(curr_node)]].insert(curr_node);
-            _part_pis.insert(std::pair<int, node>(partition[ntk.node_to_index(curr_node)], curr_node));
-            if(ntk.is_po(curr_node)){
-              _part_pos.insert(std::pair<int, node>(partition[ntk.node_to_index(curr_node)], curr_node));
-            }
-          }
-
-          //get rid of circuit POs
-          else if (ntk.is_po(curr_node)) {
-            _part_scope[partition[ntk.node_to_index(curr_node)]].insert(curr_node);
+        if (ntk.is_ro(curr_node)) {
+          _part_scope[partition[ntk.node_to_index(curr_node)]].insert(curr_node);
+          _part_pis.insert(std::pair<int, node>(partition[ntk.node_to_index(curr_node)], curr_node));
+          if(ntk.is_po(curr_node)){
             _part_pos.insert(std::pair<int, node>(partition[ntk.node_to_index(curr_node)], curr_node));
           }
+        }
 
-         else if (!ntk.is_constant(curr_node)) {
-           _part_scope[partition[ntk.node_to_index(curr_node)]].insert(curr_node);
-         }
-
-          //look to partition inputs (those that are not circuit PIs)
-          if (!ntk.is_pi(curr_node) && !ntk.is_ro(curr_node)){
-            ntk.foreach_fanin(curr_node, [&](auto const &conn, auto j) {
-              if (partition[conn.index] != partition[ntk.node_to_index(curr_node)] && !ntk.is_constant(ntk.index_to_node(conn.index))) {
-                _part_scope[partition[ntk.node_to_index(curr_node)]].insert(curr_node);
-                _part_pis.insert(std::pair<int, node>(partition[ntk.node_to_index(curr_node)], ntk.index_to_node(conn.index)));
-                _part_pos.insert(std::pair<int, node>(partition[conn.index],ntk.index_to_node(conn.index)));
-                
-              }
-            });
-          }
-        });
+        //get rid of circuit POs
+        else if (ntk.is_po(curr_node)) {
+          _part_scope[partition[ntk.node_to_index(curr_node)]].insert(curr_node);
+          _part_pos.insert(std::pair<int, node>(partition[ntk.node_to_index(curr_node)], curr_node));
+        }
 
-        for(int i = 0; i < part_num; i++){
-          partitionInputs[i] = create_part_inputs(i);
-          typename std::set<node>::iterator it;
-          partitionOutputs[i] = create_part_outputs(i);
-          update_io(i);
+       else if (!ntk.is_constant(curr_node)) {
+         _part_scope[partition[ntk.node_to_index(curr_node)]].insert(curr_node);
+       }
+
+        //look to partition inputs (those that are not circuit PIs)
+        if (!ntk.is_pi(curr_node) && !ntk.is_ro(curr_node)){
+          ntk.foreach_fanin(curr_node, [&](auto const &conn, auto j) {
+            if (partition[conn.index] != partition[ntk.node_to_index(curr_node)] && !ntk.is_constant(ntk.index_to_node(conn.index))) {
+              _part_scope[partition[ntk.node_to_index(curr_node)]].insert(curr_node);
+              _part_pis.insert(std::pair<int, node>(partition[ntk.node_to_index(curr_node)], ntk.index_to_node(conn.index)));
+              _part_pos.insert(std::pair<int, node>(partition[conn.index],ntk.index_to_node(conn.index)));
+              
+            }
+          });
         }
-        kahypar_context_free(context);
+      });
+
+      for(int i = 0; i < part_num; i++){
+        partitionInputs[i] = create_part_inputs(i);
+        typename std::set<node>::iterator it;
+        partitionOutputs[i] = create_part_outputs(i);
+        update_io(i);
       }
-      
     }
 
-  private:
 
     /***************************************************
     Utility functions to be moved later
@@ -414,6 +372,48 @@ namespace oracle
       }
     }
 
+    //Matches the AND structure of an XOR/XNOR: !( !(x & y) & !(!x & !y) ) and its variants
+    bool is_xor_root(Ntk const& ntk, node curr_node){
+      if(ntk.is_constant(curr_node) || ntk.is_ci(curr_node) || ntk.fanin_size(curr_node) != 2)
+        return false;
+
+      std::vector<signal> fanins;
+      ntk.foreach_fanin(curr_node, [&](auto const& f){
+        fanins.push_back(f);
+      });
+      if(!ntk.is_complemented(fanins[0]) || !ntk.is_complemented(fanins[1]))
+        return false;
+
+      std::vector<signal> grand_fanins;
+      for(auto const& f : fanins){
+        auto child = ntk.get_node(f);
+        if(ntk.is_constant(child) || ntk.is_ci(child) || ntk.fanin_size(child) != 2)
+          return false;
+        ntk.foreach_fanin(child, [&](auto const& g){
+          grand_fanins.push_back(g);
+        });
+      }
+
+      return ntk.get_node(grand_fanins[0]) == ntk.get_node(grand_fanins[2]) &&
+             ntk.get_node(grand_fanins[1]) == ntk.get_node(grand_fanins[3]) &&
+             ntk.is_complemented(grand_fanins[0]) != ntk.is_complemented(grand_fanins[2]) &&
+             ntk.is_complemented(grand_fanins[1]) != ntk.is_complemented(grand_fanins[3]);
+    }
+
+    //A partition is XOR dominated when at least half of its gates belong to XOR structures
+    bool is_xor_dominated(Ntk const& ntk, int partition){
+      int num_gates = 0;
+      int num_xors = 0;
+      for(auto curr_node : _part_scope[partition]){
+        if(ntk.is_constant(curr_node) || ntk.is_ci(curr_node))
+          continue;
+        num_gates++;
+        if(is_xor_root(ntk, curr_node))
+          num_xors++;
+      }
+      return num_gates > 0 && 2 * 3 * num_xors >= num_gates;
+    }
+
     std::string to_binary(int dec){
 
       std::string bin;
@@ -601,7 +601,8 @@ namespace oracle
 
         }
 
-        if(!opt.is_constant(opt_node) && !opt.is_pi(opt_node) && !opt.is_ro(opt_node)){
+        //an unchanged output is hashed back onto the original node, which must not be substituted by itself
+        if(!opt.is_constant(opt_node) && !opt.is_pi(opt_node) && !opt.is_ro(opt_node) && ntk.get_node(opt_out) != ntk.get_node(part_out)){
           // std::cout << "Replace " << ntk.node_to_index(ntk.get_node(part_out)) << " by "
           //           << ntk.node_to_index(ntk.get_node(opt_out)) << std::endl;
           output_substitutions[ntk.get_node(part_out)] = opt_out;
@@ -771,6 +772,12 @@ namespace oracle
       }
 
       for(int i = 0; i < num_partitions; i++){
+        //XOR dominated logic is a candidate for the XAG script, the CNN only decides between AIG and MIG
+        if(is_xor_dominated(ntk, i)){
+          xag_parts.push_back(i);
+          continue;
+        }
+
         int aig_score = 0;
         int mig_score = 0;
 
@@ -1130,9 +1137,8 @@ namespace oracle
     }//create_aig_from_part()
 
     void connect_outputs(Ntk ntk){
-      for(auto it = output_substitutions.begin(); it != output_substitutions.end(); ++it){
-        ntk.substitute_node(it->first, it->second);
-      }
+      //applies all partition substitutions with a single parent index instead of scanning the network per output
+      ntk.substitute_nodes(output_substitutions);
     }
 
     std::set<node> create_part_outputs(int part_index){
@@ -1167,6 +1173,29 @@ namespace oracle
       }
     }
 
+    /* nodes of ntk that drive an input of another partition, after connect_outputs(ntk) */
+    std::set<node> get_seam_nodes(Ntk const& ntk){
+      std::set<node> outputs;
+      for(int i = 0; i < num_partitions; i++){
+        outputs.insert(partitionOutputs[i].begin(), partitionOutputs[i].end());
+      }
+
+      std::set<node> seams;
+      for(int i = 0; i < num_partitions; i++){
+        for(auto const& n : partitionInputs[i]){
+          if(outputs.count(n) == 0){
+            continue;
+          }
+          auto it = output_substitutions.find(n);
+          auto seam = it == output_substitutions.end() ? n : ntk.get_node(it->second);
+          if(!ntk.is_constant(seam) && !ntk.is_ci(seam)){
+            seams.insert(seam);
+          }
+        }
+      }
+      return seams;
+    }
+
     std::set<node> get_shared_io(int part_1, int part_2){
       std::set<node> part_1_inputs = partitionInputs[part_1];
       std::set<node> part_1_outputs = partitionOutputs[part_1];
@@ -1305,6 +1334,9 @@ namespace oracle
     std::vector<int> get_mig_parts(){
       return mig_parts;
     }
+    std::vector<int> get_xag_parts(){
+      return xag_parts;
+    }
 
     std::set<int> get_connected_parts( Ntk const& ntk, int partition_num ){
       std::set<int> conn_parts;
@@ -1357,6 +1389,7 @@ namespace oracle
 
     std::vector<int> aig_parts;
     std::vector<int> mig_parts;
+    std::vector<int> xag_parts;
 
     std::unordered_map<int, std::set<int>> conn_parts;
     std::unordered_map<node, std::vector<int>> input_partition;
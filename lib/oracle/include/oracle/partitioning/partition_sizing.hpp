@@ -0,0 +1,112 @@
+/*!
+  \file partition_sizing.hpp
+  \brief Automatic choice of the number of partitions
+
+  Picks the partition count from a target partition size and the number of
+  threads that optimize the partitions, instead of a user-supplied count,
+  and optionally refines it until every partition respects an input bound.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <thread>
+
+#include "kahypar_config.hpp"
+#include "partition_manager.hpp"
+#include "partition_trials.hpp"
+
+namespace oracle
+{
+
+  struct partition_sizing_params
+  {
+    /*! \brief Desired gates per partition (0 derives it from the thread count). */
+    uint32_t target_size{0u};
+
+    /*! \brief Partitions are not made smaller than this, to bound the boundary overhead. */
+    uint32_t min_size{300u};
+
+    /*! \brief Largest number of inputs of a partition (0 for no bound). */
+    uint32_t max_inputs{0u};
+
+    /*! \brief Threads or worker processes optimizing the partitions (0 uses all hardware threads). */
+    uint32_t num_threads{0u};
+
+    /*! \brief Partitions per thread when the size is derived from the thread count. */
+    uint32_t parts_per_thread{4u};
+
+    /*! \brief Re-partitioning rounds to meet the input bound. */
+    uint32_t max_rounds{4u};
+
+    bool verbose{false};
+  };
+
+  /*! \brief Number of partitions for a network with the given number of gates.
+   *
+   * Without a target size, every thread gets `parts_per_thread` partitions so
+   * that uneven partitions still balance out, unless that would make them
+   * smaller than `min_size`.  Counts above the thread count are rounded up to
+   * a multiple of it, so that every thread gets the same number of partitions.
+   */
+  inline uint32_t auto_partition_count( uint32_t num_gates, partition_sizing_params const& ps = {} )
+  {
+    const uint32_t threads = ps.num_threads != 0u ? ps.num_threads : std::max( 1u, std::thread::hardware_concurrency() );
+
+    uint32_t k;
+    if ( ps.target_size != 0u )
+    {
+      k = ( num_gates + ps.target_size - 1u ) / ps.target_size;
+    }
+    else
+    {
+      k = std::min( threads * ps.parts_per_thread, num_gates / std::max( 1u, ps.min_size ) );
+    }
+
+    if ( k > threads )
+    {
+      k = ( ( k + threads - 1u ) / threads ) * threads;
+    }
+    return std::clamp( k, 1u, std::max( 1u, num_gates ) );
+  }
+
+  /*! \brief Partitions a network with an automatically chosen partition count.
+   *
+   * Starts from `auto_partition_count` and, if `max_inputs` is set, grows
+   * the count in proportion to the largest partition input count until the
+   * bound holds or `max_rounds` partitionings were tried.
+   */
+  template<typename Ntk>
+  partition_manager<Ntk> auto_partition( Ntk const& ntk, partition_sizing_params const& ps = {}, kahypar_config const& config = {},
+                                         partition_trials_params const& trials = {}, partition_trials_stats* pst = nullptr )
+  {
+    auto k = auto_partition_count( ntk.num_gates(), ps );
+    for ( auto round = 0u;; ++round )
+    {
+      if ( pst )
+      {
+        *pst = {};
+      }
+      auto partitions = best_partition( ntk, k, config, trials, pst );
+
+      std::size_t widest = 0u;
+      for ( auto i = 0; i < partitions.get_part_num(); ++i )
+      {
+        widest = std::max( widest, partitions.get_part_inputs( i ).size() );
+      }
+      if ( ps.verbose )
+      {
+        std::cout << k << " partitions, at most " << widest << " inputs\n";
+      }
+
+      if ( ps.max_inputs == 0u || widest <= ps.max_inputs || round + 1u >= ps.max_rounds || k >= ntk.num_gates() )
+      {
+        return partitions;
+      }
+      k = std::min<uint32_t>( ntk.num_gates(), static_cast<uint32_t>( ( uint64_t( k ) * widest + ps.max_inputs - 1u ) / ps.max_inputs ) );
+    }
+  }
+
+} /* namespace oracle */
@@ -0,0 +1,554 @@
+/*!
+  \file partition_store.hpp
+  \brief File exchange of partition networks
+
+  Keeps the networks extracted from the partitions of a design in a
+  directory, so that worker processes can load, optimize and write
+  them back, and so that the design can be stitched back from disk
+  without the original network.
+*/
+
+#pragma once
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include <sys/stat.h>
+#include <sys/types.h>
+
+#include <mockturtle/networks/mig.hpp>
+#include <mockturtle/traits.hpp>
+#include <mockturtle/views/topo_view.hpp>
+
+namespace oracle
+{
+
+  /*! \brief Where a partition sits in the design.
+   *
+   * Node indices of the design that drive the partition inputs, and
+   * literals (index << 1 | complement) of the design nodes the partition
+   * outputs stand for, both in the order of the partition network.
+   */
+  struct partition_boundary
+  {
+    std::vector<uint32_t> inputs;
+    std::vector<uint32_t> outputs;
+  };
+
+  /*! \brief Combinational inputs and outputs of a design.
+   *
+   * Node indices of the primary inputs and register outputs, literals of
+   * the primary outputs and register inputs, and the register resets.
+   */
+  struct design_interface
+  {
+    std::vector<uint32_t> pis;
+    std::vector<uint32_t> ros;
+    std::vector<uint32_t> pos;
+    std::vector<uint32_t> ris;
+    std::vector<uint32_t> resets;
+  };
+
+  /*! \brief File store of partition networks.
+   *
+   * Every partition network is written to its own file in a compact binary
+   * format: the primary inputs, the gates in topological order and the
+   * primary outputs, with fanins encoded as literals (index << 1 | complement).
+   * The order of the primary inputs and outputs is kept, so a network read
+   * back can be handed to `partition_manager::synchronize_part` like the one
+   * that was written.
+   *
+   * AND, XOR and majority gates are supported, which covers AIGs, XAGs and
+   * MIGs.  MIG nodes are read back without complemented edge normalization,
+   * so their fanins are exactly the ones that were written.
+   *
+   * With the boundary of every partition and the interface of the design
+   * on disk as well, `stitch` rebuilds the design from the files alone,
+   * loading one partition at a time.  The design and its partition manager
+   * can be released once everything is written.
+   */
+  template<typename Ntk>
+  class partition_store
+  {
+  public:
+    using node = typename Ntk::node;
+    using signal = typename Ntk::signal;
+
+    explicit partition_store( std::string const& directory )
+        : _directory( directory )
+    {
+      if ( mkdir( _directory.c_str(), 0777 ) != 0 && errno != EEXIST )
+      {
+        throw std::runtime_error( "could not create partition directory " + _directory + ": " + std::strerror( errno ) );
+      }
+    }
+
+    std::string path( uint32_t part ) const
+    {
+      return _directory + "/part_" + std::to_string( part ) + ".lsp";
+    }
+
+    bool contains( uint32_t part ) const
+    {
+      struct stat st;
+      return stat( path( part ).c_str(), &st ) == 0;
+    }
+
+    void remove( uint32_t part ) const
+    {
+      std::remove( path( part ).c_str() );
+      std::remove( boundary_path( part ).c_str() );
+    }
+
+    void remove_interface() const
+    {
+      std::remove( interface_path().c_str() );
+    }
+
+    uint64_t bytes_written() const { return _bytes_written; }
+    uint64_t bytes_read() const { return _bytes_read; }
+
+    void write( uint32_t part, Ntk const& ntk )
+    {
+      /* written next to the target and renamed, so a reader never sees a partial file */
+      const auto tmp = path( part ) + ".tmp";
+      std::ofstream os( tmp, std::ios::binary );
+      if ( !os )
+      {
+        throw std::runtime_error( "could not write partition file " + path( part ) );
+      }
+
+      std::unordered_map<node, uint32_t> index;
+      index[ntk.get_node( ntk.get_constant( false ) )] = 0u;
+      ntk.foreach_pi( [&]( auto const& n ) {
+        index[n] = static_cast<uint32_t>( index.size() );
+      } );
+
+      std::vector<uint32_t> words{MAGIC, static_cast<uint32_t>( index.size() - 1u ), 0u, 0u};
+
+      mockturtle::topo_view topo{ntk};
+      topo.foreach_node( [&]( auto const& n ) {
+        if ( ntk.is_constant( n ) || ntk.is_pi( n ) )
+        {
+          return;
+        }
+
+        std::vector<uint32_t> fanins;
+        ntk.foreach_fanin( n, [&]( auto const& f ) {
+          fanins.push_back( literal( index, f, ntk ) );
+        } );
+        words.push_back( gate_kind( ntk, n, fanins.size() ) );
+        words.insert( words.end(), fanins.begin(), fanins.end() );
+
+        index[n] = static_cast<uint32_t>( index.size() );
+        ++words[2];
+      } );
+
+      ntk.foreach_po( [&]( auto const& f ) {
+        words.push_back( literal( index, f, ntk ) );
+        ++words[3];
+      } );
+
+      os.write( reinterpret_cast<char const*>( words.data() ), words.size() * sizeof( uint32_t ) );
+      os.close();
+      if ( !os || std::rename( tmp.c_str(), path( part ).c_str() ) != 0 )
+      {
+        throw std::runtime_error( "could not write partition file " + path( part ) );
+      }
+      _bytes_written += words.size() * sizeof( uint32_t );
+    }
+
+    /*! \brief Reads the network of a partition back.
+     *
+     * Throws `std::runtime_error` if the file is missing, truncated, or
+     * refers to a signal that was not defined before its use.
+     */
+    Ntk read( uint32_t part )
+    {
+      std::ifstream is( path( part ), std::ios::binary | std::ios::ate );
+      if ( !is )
+      {
+        throw std::runtime_error( "could not read partition file " + path( part ) );
+      }
+
+      const auto bytes = static_cast<std::size_t>( is.tellg() );
+      std::vector<uint32_t> words( bytes / sizeof( uint32_t ) );
+      is.seekg( 0 );
+      is.read( reinterpret_cast<char*>( words.data() ), words.size() * sizeof( uint32_t ) );
+      _bytes_read += words.size() * sizeof( uint32_t );
+      if ( !is || bytes % sizeof( uint32_t ) != 0u || words.size() < 4u || words[0] != MAGIC ||
+           words[1] > words.size() || words[2] > words.size() || words[3] > words.size() )
+      {
+        throw std::runtime_error( "corrupt partition file " + path( part ) );
+      }
+
+      Ntk ntk;
+      std::vector<signal> signals{ntk.get_constant( false )};
+      signals.reserve( 1u + words[1] + words[2] );
+      for ( auto i = 0u; i < words[1]; ++i )
+      {
+        signals.push_back( ntk.create_pi() );
+      }
+
+      std::size_t pos = 4u;
+      auto lit = [&]( uint32_t l ) {
+        if ( ( l >> 1 ) >= signals.size() )
+        {
+          throw std::runtime_error( "corrupt partition file " + path( part ) );
+        }
+        return ( l & 1 ) ? ntk.create_not( signals[l >> 1] ) : signals[l >> 1];
+      };
+      auto take = [&]( std::size_t count ) {
+        if ( words.size() - pos < count )
+        {
+          throw std::runtime_error( "truncated partition file " + path( part ) );
+        }
+        const auto first = pos;
+        pos += count;
+        return first;
+      };
+
+      for ( auto i = 0u; i < words[2]; ++i )
+      {
+        const auto kind = words[take( 1u )];
+        switch ( kind )
+        {
+        case AND:
+        {
+          const auto f = take( 2u );
+          signals.push_back( ntk.create_and( lit( words[f] ), lit( words[f + 1] ) ) );
+          break;
+        }
+        case XOR:
+        {
+          const auto f = take( 2u );
+          signals.push_back( ntk.create_xor( lit( words[f] ), lit( words[f + 1] ) ) );
+          break;
+        }
+        case MAJ:
+        {
+          const auto f = take( 3u );
+          if constexpr ( std::is_same_v<Ntk, mockturtle::mig_network> )
+          {
+            /* keep the fanins as written, mig_to_aig reads the raw children */
+            signals.push_back( ntk.create_maj_part( lit( words[f] ), lit( words[f + 1] ), lit( words[f + 2] ) ) );
+            break;
+          }
+          else if constexpr ( mockturtle::has_create_maj_v<Ntk> )
+          {
+            signals.push_back( ntk.create_maj( lit( words[f] ), lit( words[f + 1] ), lit( words[f + 2] ) ) );
+            break;
+          }
+          throw std::runtime_error( "majority gate in partition file " + path( part ) );
+        }
+        default:
+          throw std::runtime_error( "corrupt partition file " + path( part ) );
+        }
+      }
+
+      const auto outputs = take( words[3] );
+      for ( auto i = 0u; i < words[3]; ++i )
+      {
+        ntk.create_po( lit( words[outputs + i] ) );
+      }
+      if ( pos != words.size() )
+      {
+        throw std::runtime_error( "corrupt partition file " + path( part ) );
+      }
+
+      return ntk;
+    }
+
+    /*! \brief Boundary of a partition view of `ntk`, in the order of its primary inputs and outputs. */
+    template<typename View>
+    static partition_boundary boundary_of( Ntk const& ntk, View const& part )
+    {
+      partition_boundary boundary;
+      part.foreach_pi( [&]( auto const& n ) {
+        boundary.inputs.push_back( static_cast<uint32_t>( ntk.node_to_index( n ) ) );
+      } );
+      part.foreach_po( [&]( auto const& f ) {
+        boundary.outputs.push_back( static_cast<uint32_t>( ntk.node_to_index( ntk.get_node( f ) ) << 1 ) | ( ntk.is_complemented( f ) ? 1u : 0u ) );
+      } );
+      return boundary;
+    }
+
+    void write_boundary( uint32_t part, partition_boundary const& boundary )
+    {
+      std::vector<uint32_t> words{BOUNDARY_MAGIC, static_cast<uint32_t>( boundary.inputs.size() ), static_cast<uint32_t>( boundary.outputs.size() )};
+      words.insert( words.end(), boundary.inputs.begin(), boundary.inputs.end() );
+      words.insert( words.end(), boundary.outputs.begin(), boundary.outputs.end() );
+      write_words( boundary_path( part ), words );
+    }
+
+    partition_boundary read_boundary( uint32_t part )
+    {
+      const auto words = read_words( boundary_path( part ) );
+      if ( words.size() < 3u || words[0] != BOUNDARY_MAGIC || words.size() != 3u + std::size_t( words[1] ) + words[2] )
+      {
+        throw std::runtime_error( "corrupt boundary file " + boundary_path( part ) );
+      }
+      return {{words.begin() + 3, words.begin() + 3 + words[1]}, {words.begin() + 3 + words[1], words.end()}};
+    }
+
+    /*! \brief Writes the combinational inputs and outputs of `ntk`, registers come last. */
+    template<typename Design>
+    void write_interface( Design const& ntk )
+    {
+      design_interface io;
+      std::vector<uint32_t> cis;
+      ntk.foreach_ci( [&]( auto const& n ) {
+        cis.push_back( static_cast<uint32_t>( ntk.node_to_index( n ) ) );
+      } );
+      std::vector<uint32_t> cos;
+      ntk.foreach_co( [&]( auto const& f ) {
+        cos.push_back( static_cast<uint32_t>( ntk.node_to_index( ntk.get_node( f ) ) << 1 ) | ( ntk.is_complemented( f ) ? 1u : 0u ) );
+      } );
+
+      const auto num_latches = ntk.num_latches();
+      io.pis.assign( cis.begin(), cis.end() - num_latches );
+      io.ros.assign( cis.end() - num_latches, cis.end() );
+      io.pos.assign( cos.begin(), cos.end() - num_latches );
+      io.ris.assign( cos.end() - num_latches, cos.end() );
+      for ( auto i = 0u; i < num_latches; ++i )
+      {
+        io.resets.push_back( static_cast<uint32_t>( ntk.latch_reset( i ) ) );
+      }
+
+      std::vector<uint32_t> words{INTERFACE_MAGIC, static_cast<uint32_t>( io.pis.size() ), static_cast<uint32_t>( io.pos.size() ), num_latches};
+      for ( auto const* v : {&io.pis, &io.ros, &io.pos, &io.ris, &io.resets} )
+      {
+        words.insert( words.end(), v->begin(), v->end() );
+      }
+      write_words( interface_path(), words );
+    }
+
+    design_interface read_interface()
+    {
+      const auto words = read_words( interface_path() );
+      if ( words.size() < 4u || words[0] != INTERFACE_MAGIC ||
+           words.size() != 4u + std::size_t( words[1] ) + words[2] + 3u * std::size_t( words[3] ) )
+      {
+        throw std::runtime_error( "corrupt interface file " + interface_path() );
+      }
+
+      design_interface io;
+      auto it = words.begin() + 4;
+      for ( auto [v, count] : {std::make_pair( &io.pis, words[1] ), std::make_pair( &io.ros, words[3] ), std::make_pair( &io.pos, words[2] ),
+                               std::make_pair( &io.ris, words[3] ), std::make_pair( &io.resets, words[3] )} )
+      {
+        v->assign( it, it + count );
+        it += count;
+      }
+      return io;
+    }
+
+    /*! \brief Builds the design from the partition files of `parts`.
+     *
+     * Only the partition being stitched and the signals of the partition
+     * outputs are held in memory next to the result.  Partitions are
+     * loaded in passes: a gate is created once all its fanins exist, and a
+     * partition is done when all its outputs exist.  This resolves
+     * partitions that feed each other, which a hypergraph partitioner may
+     * produce, as long as the design itself is acyclic.  Gates created for
+     * outputs that are never used are left dangling, so run
+     * `cleanup_dangling` afterwards.
+     *
+     * Throws `std::runtime_error` if an output of the design is not driven
+     * by a design input or a partition output.
+     */
+    Ntk stitch( std::vector<uint32_t> const& parts )
+    {
+      const auto io = read_interface();
+
+      Ntk ntk;
+      std::unordered_map<uint32_t, signal> signals{{0u, ntk.get_constant( false )}};
+      for ( auto const& n : io.pis )
+      {
+        signals[n] = ntk.create_pi();
+      }
+      for ( auto const& n : io.ros )
+      {
+        signals[n] = ntk.create_ro();
+      }
+      auto lookup = [&]( uint32_t lit, signal& f ) {
+        const auto it = signals.find( lit >> 1 );
+        if ( it == signals.end() )
+        {
+          return false;
+        }
+        f = ( lit & 1 ) ? ntk.create_not( it->second ) : it->second;
+        return true;
+      };
+
+      std::vector<uint32_t> pending = parts;
+      while ( !pending.empty() )
+      {
+        const auto num_signals = signals.size();
+        std::vector<uint32_t> next;
+        for ( auto const& part : pending )
+        {
+          const auto boundary = read_boundary( part );
+          const auto opt = read( part );
+          if ( opt.num_pis() != boundary.inputs.size() || opt.num_pos() != boundary.outputs.size() )
+          {
+            throw std::runtime_error( "partition file " + path( part ) + " does not match its boundary" );
+          }
+
+          std::vector<signal> local( opt.size() );
+          std::vector<uint8_t> known( opt.size(), 0u );
+          local[0] = ntk.get_constant( false );
+          known[0] = 1u;
+          opt.foreach_pi( [&]( auto const& n, auto i ) {
+            known[opt.node_to_index( n )] = lookup( boundary.inputs[i] << 1, local[opt.node_to_index( n )] );
+          } );
+
+          /* read back in creation order, which is topological */
+          opt.foreach_gate( [&]( auto const& n ) {
+            std::vector<signal> children;
+            bool ready = true;
+            opt.foreach_fanin( n, [&]( auto const& f ) {
+              const auto c = opt.node_to_index( opt.get_node( f ) );
+              ready = ready && known[c];
+              if ( ready )
+              {
+                children.push_back( opt.is_complemented( f ) ? ntk.create_not( local[c] ) : local[c] );
+              }
+            } );
+            if ( ready )
+            {
+              local[opt.node_to_index( n )] = ntk.clone_node( opt, n, children );
+              known[opt.node_to_index( n )] = 1u;
+            }
+          } );
+
+          bool done = true;
+          opt.foreach_po( [&]( auto const& f, auto i ) {
+            const auto c = opt.node_to_index( opt.get_node( f ) );
+            if ( !known[c] )
+            {
+              done = false;
+              return;
+            }
+            const auto s = opt.is_complemented( f ) ? ntk.create_not( local[c] ) : local[c];
+            signals[boundary.outputs[i] >> 1] = ( boundary.outputs[i] & 1 ) ? ntk.create_not( s ) : s;
+          } );
+          if ( !done )
+          {
+            next.push_back( part );
+          }
+        }
+
+        if ( !next.empty() && signals.size() == num_signals )
+        {
+          throw std::runtime_error( "partitions in " + _directory + " form a combinational cycle" );
+        }
+        pending = std::move( next );
+      }
+
+      for ( auto const& lit : io.pos )
+      {
+        signal f;
+        if ( !lookup( lit, f ) )
+        {
+          throw std::runtime_error( "output node " + std::to_string( lit >> 1 ) + " is not driven by a partition" );
+        }
+        ntk.create_po( f );
+      }
+      for ( auto i = 0u; i < io.ris.size(); ++i )
+      {
+        signal f;
+        if ( !lookup( io.ris[i], f ) )
+        {
+          throw std::runtime_error( "register input node " + std::to_string( io.ris[i] >> 1 ) + " is not driven by a partition" );
+        }
+        ntk.create_ri( f, static_cast<int8_t>( io.resets[i] ) );
+      }
+      return ntk;
+    }
+
+  private:
+    std::string boundary_path( uint32_t part ) const
+    {
+      return _directory + "/part_" + std::to_string( part ) + ".lsb";
+    }
+
+    std::string interface_path() const
+    {
+      return _directory + "/interface.lsi";
+    }
+
+    void write_words( std::string const& filename, std::vector<uint32_t> const& words )
+    {
+      std::ofstream os( filename, std::ios::binary );
+      os.write( reinterpret_cast<char const*>( words.data() ), words.size() * sizeof( uint32_t ) );
+      if ( !os )
+      {
+        throw std::runtime_error( "could not write " + filename );
+      }
+      _bytes_written += words.size() * sizeof( uint32_t );
+    }
+
+    std::vector<uint32_t> read_words( std::string const& filename )
+    {
+      std::ifstream is( filename, std::ios::binary | std::ios::ate );
+      if ( !is )
+      {
+        throw std::runtime_error( "could not read " + filename );
+      }
+      const auto bytes = static_cast<std::size_t>( is.tellg() );
+      std::vector<uint32_t> words( bytes / sizeof( uint32_t ) );
+      is.seekg( 0 );
+      is.read( reinterpret_cast<char*>( words.data() ), words.size() * sizeof( uint32_t ) );
+      if ( !is || bytes % sizeof( uint32_t ) != 0u )
+      {
+        throw std::runtime_error( "corrupt file " + filename );
+      }
+      _bytes_read += bytes;
+      return words;
+    }
+
+    static uint32_t literal( std::unordered_map<node, uint32_t> const& index, signal const& f, Ntk const& ntk )
+    {
+      return ( index.at( ntk.get_node( f ) ) << 1 ) | ( ntk.is_complemented( f ) ? 1u : 0u );
+    }
+
+    static uint32_t gate_kind( Ntk const& ntk, node const& n, std::size_t num_fanins )
+    {
+      if ( num_fanins == 3u )
+      {
+        return MAJ;
+      }
+      if constexpr ( mockturtle::has_is_xor_v<Ntk> )
+      {
+        if ( ntk.is_xor( n ) )
+        {
+          return XOR;
+        }
+      }
+      (void)ntk;
+      (void)n;
+      return AND;
+    }
+
+    static constexpr uint32_t MAGIC = 0x5053534cu; /* "LSSP" */
+    static constexpr uint32_t BOUNDARY_MAGIC = 0x4253534cu; /* "LSSB" */
+    static constexpr uint32_t INTERFACE_MAGIC = 0x4953534cu; /* "LSSI" */
+    static constexpr uint32_t AND = 0u;
+    static constexpr uint32_t XOR = 1u;
+    static constexpr uint32_t MAJ = 2u;
+
+    std::string _directory;
+    uint64_t _bytes_written{0u};
+    uint64_t _bytes_read{0u};
+  };
+
+} /* namespace oracle */
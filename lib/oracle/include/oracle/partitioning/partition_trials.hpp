@@ -0,0 +1,269 @@
+/*!
+  \file partition_trials.hpp
+  \brief Best of several KaHyPar runs with different seeds
+
+  KaHyPar keeps its random generator in a process-wide singleton, so the
+  trials run in forked worker processes rather than threads.  Every trial
+  uses its own fixed seed, which makes the selected partition reproducible
+  with `partitioning --seed`.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <set>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "kahypar_config.hpp"
+#include "kahypar_hypergraph.hpp"
+#include "partition_manager.hpp"
+
+namespace oracle
+{
+
+  struct partition_trials_params
+  {
+    /*! \brief Number of partitionings, with seeds first_seed, first_seed + 1, ... */
+    uint32_t trials{1u};
+
+    int first_seed{1};
+
+    /*! \brief Trials running at the same time (0 uses all hardware threads). */
+    uint32_t num_threads{0u};
+
+    /*! \brief Select by the number of partition inputs and outputs instead of the KaHyPar objective. */
+    bool boundary_objective{false};
+
+    bool verbose{false};
+  };
+
+  struct partition_trials_stats
+  {
+    int best_seed{-1};
+    int best_objective{0};
+    uint64_t best_boundary{0u};
+
+    /*! \brief Seed, KaHyPar objective and boundary size of every trial. */
+    std::vector<std::tuple<int, int, uint64_t>> trials;
+  };
+
+  namespace detail
+  {
+    /* partition inputs plus partition outputs, without circuit inputs and outputs */
+    template<typename Ntk>
+    uint64_t partition_boundary( Ntk const& ntk, std::vector<int> const& partition )
+    {
+      std::set<std::pair<int, uint64_t>> inputs;
+      std::set<uint64_t> outputs;
+      ntk.foreach_gate( [&]( auto const& n ) {
+        /* register outputs are visited as gates, but their fanins are placeholders */
+        if constexpr ( mockturtle::has_is_ci_v<Ntk> )
+        {
+          if ( ntk.is_ci( n ) )
+          {
+            return;
+          }
+        }
+        const auto part = partition[ntk.node_to_index( n )];
+        ntk.foreach_fanin( n, [&]( auto const& f ) {
+          const auto index = ntk.node_to_index( ntk.get_node( f ) );
+          if ( !ntk.is_constant( ntk.get_node( f ) ) && partition[index] != part )
+          {
+            inputs.emplace( part, index );
+            outputs.insert( index );
+          }
+        } );
+      } );
+      return inputs.size() + outputs.size();
+    }
+
+    inline bool write_all( int fd, void const* data, std::size_t size )
+    {
+      auto bytes = static_cast<char const*>( data );
+      while ( size > 0u )
+      {
+        const auto written = ::write( fd, bytes, size );
+        if ( written <= 0 )
+        {
+          return false;
+        }
+        bytes += written;
+        size -= written;
+      }
+      return true;
+    }
+
+    inline bool read_all( int fd, void* data, std::size_t size )
+    {
+      auto bytes = static_cast<char*>( data );
+      while ( size > 0u )
+      {
+        const auto got = ::read( fd, bytes, size );
+        if ( got <= 0 )
+        {
+          return false;
+        }
+        bytes += got;
+        size -= got;
+      }
+      return true;
+    }
+  } /* namespace detail */
+
+  /*! \brief Partitions ntk `ps.trials` times with different seeds and keeps the best partition.
+   *
+   * Trials whose worker fails are skipped; if every worker fails, the
+   * partitioning falls back to a single run in this process.
+   */
+  template<typename Ntk>
+  partition_manager<Ntk> best_partition( Ntk const& ntk, int part_num, kahypar_config config, partition_trials_params const& ps = {}, partition_trials_stats* pst = nullptr )
+  {
+    if ( part_num <= 1 || ps.trials <= 1u )
+    {
+      if ( pst )
+      {
+        pst->best_seed = config.seed ? *config.seed : -1;
+      }
+      return partition_manager<Ntk>( ntk, part_num, config );
+    }
+
+    const kahypar_hypergraph<Ntk> hypergraph( ntk );
+    const auto num_vertices = hypergraph.num_vertices();
+    const uint32_t threads = ps.num_threads != 0u ? ps.num_threads : std::max( 1u, std::thread::hardware_concurrency() );
+
+    struct worker
+    {
+      pid_t pid;
+      int fd;
+      int seed;
+    };
+    std::vector<worker> running;
+    std::vector<int> best;
+    int best_objective = std::numeric_limits<int>::max();
+    uint64_t best_boundary = std::numeric_limits<uint64_t>::max();
+    int best_seed = -1;
+
+    auto consider = [&]( int seed, int objective, std::vector<int>&& partition ) {
+      const auto boundary = detail::partition_boundary( ntk, partition );
+      if ( ps.verbose )
+      {
+        std::cout << "seed " << seed << ": objective " << objective << ", boundary " << boundary << "\n";
+      }
+      if ( pst )
+      {
+        pst->trials.emplace_back( seed, objective, boundary );
+      }
+      const auto better = ps.boundary_objective ? std::make_pair( boundary, uint64_t( objective ) ) < std::make_pair( best_boundary, uint64_t( best_objective ) )
+                                                : std::make_pair( uint64_t( objective ), boundary ) < std::make_pair( uint64_t( best_objective ), best_boundary );
+      if ( best.empty() || better )
+      {
+        best = std::move( partition );
+        best_objective = objective;
+        best_boundary = boundary;
+        best_seed = seed;
+      }
+    };
+
+    /* collects the oldest worker; the others may block on a full pipe meanwhile */
+    auto collect = [&]() {
+      auto const w = running.front();
+      running.erase( running.begin() );
+
+      int objective = 0;
+      std::vector<int> partition( num_vertices );
+      const bool ok = detail::read_all( w.fd, &objective, sizeof( objective ) ) &&
+                      detail::read_all( w.fd, partition.data(), partition.size() * sizeof( int ) );
+      close( w.fd );
+
+      int status = 0;
+      waitpid( w.pid, &status, 0 );
+      if ( ok && WIFEXITED( status ) && WEXITSTATUS( status ) == 0 )
+      {
+        consider( w.seed, objective, std::move( partition ) );
+      }
+      else
+      {
+        std::cerr << "[w] partitioning trial with seed " << w.seed << " failed\n";
+      }
+    };
+
+    std::cout.flush();
+    std::cerr.flush();
+    for ( auto trial = 0u; trial < ps.trials; ++trial )
+    {
+      const int seed = ps.first_seed + static_cast<int>( trial );
+      config.seed = seed;
+
+      int fds[2];
+      const bool piped = pipe( fds ) == 0;
+      const pid_t pid = piped ? fork() : -1;
+      if ( pid == 0 )
+      {
+        close( fds[0] );
+        bool ok = false;
+        try
+        {
+          int objective = 0;
+          const auto partition = hypergraph.partition( part_num, config, &objective );
+          ok = detail::write_all( fds[1], &objective, sizeof( objective ) ) &&
+               detail::write_all( fds[1], partition.data(), partition.size() * sizeof( int ) );
+        }
+        catch ( ... )
+        {
+        }
+        close( fds[1] );
+        _exit( ok ? 0 : 1 );
+      }
+      else if ( pid < 0 )
+      {
+        /* no worker process, run the trial here */
+        if ( piped )
+        {
+          close( fds[0] );
+          close( fds[1] );
+        }
+        int objective = 0;
+        auto partition = hypergraph.partition( part_num, config, &objective );
+        consider( seed, objective, std::move( partition ) );
+        continue;
+      }
+
+      close( fds[1] );
+      running.push_back( {pid, fds[0], seed} );
+      if ( running.size() >= threads )
+      {
+        collect();
+      }
+    }
+    while ( !running.empty() )
+    {
+      collect();
+    }
+
+    if ( best.empty() )
+    {
+      config.seed = ps.first_seed;
+      int objective = 0;
+      auto partition = hypergraph.partition( part_num, config, &objective );
+      consider( ps.first_seed, objective, std::move( partition ) );
+    }
+
+    if ( pst )
+    {
+      pst->best_seed = best_seed;
+      pst->best_objective = best_objective;
+      pst->best_boundary = best_boundary;
+    }
+    return partition_manager<Ntk>( ntk, best, part_num );
+  }
+
+} /* namespace oracle */
@@ -0,0 +1,118 @@
+/*!
+  \file seam_rewriting.hpp
+  \brief Re-optimization of the logic around partition boundaries
+
+  Every partition is optimized on its own, so logic on both sides of a
+  partition boundary is never optimized together.  After the partitions are
+  merged back with `connect_outputs`, this pass places windows that straddle
+  the boundaries and rewrites them in parallel.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <set>
+#include <vector>
+
+#include <mockturtle/algorithms/window_rewriting.hpp>
+#include <mockturtle/views/fanout_view.hpp>
+
+#include "partition_manager.hpp"
+
+namespace oracle
+{
+
+  struct seam_rewriting_params
+  {
+    /*! \brief Levels of a window; half of them lie behind the boundary. */
+    uint32_t depth{6u};
+
+    /*! \brief Largest window. */
+    uint32_t max_gates{64u};
+
+    /*! \brief Threads optimizing the windows (0 uses all hardware threads). */
+    uint32_t num_threads{0u};
+
+    bool verbose{false};
+  };
+
+  /*! \brief Roots of the seam windows.
+   *
+   * Collects the gates up to depth / 2 levels after a boundary node and keeps
+   * those without a fanout among them, so that the windows reach back over
+   * the boundary and do not cut each other into small pieces.
+   */
+  template<typename Ntk>
+  std::vector<typename Ntk::node> seam_roots( Ntk const& ntk, std::set<typename Ntk::node> const& seams, uint32_t depth )
+  {
+    using node = typename Ntk::node;
+    mockturtle::fanout_view<Ntk> fanout_ntk{ntk};
+
+    auto foreach_gate_fanout = [&]( node const& n, auto&& fn ) {
+      fanout_ntk.foreach_fanout( n, [&]( auto const& f ) {
+        if ( !ntk.is_constant( f ) && !ntk.is_ci( f ) && !ntk.is_dead( f ) )
+        {
+          fn( f );
+        }
+      } );
+    };
+
+    std::set<node> near;
+    for ( auto const& s : seams )
+    {
+      std::vector<node> frontier{s};
+      for ( auto level = 0u; level < std::max( 1u, depth / 2u ); ++level )
+      {
+        std::vector<node> next;
+        for ( auto const& n : frontier )
+        {
+          foreach_gate_fanout( n, [&]( auto const& f ) {
+            if ( near.insert( f ).second )
+            {
+              next.push_back( f );
+            }
+          } );
+        }
+        frontier = std::move( next );
+      }
+    }
+
+    std::vector<node> roots;
+    for ( auto const& n : near )
+    {
+      bool has_near_fanout = false;
+      foreach_gate_fanout( n, [&]( auto const& f ) {
+        has_near_fanout = has_near_fanout || near.count( f ) != 0u;
+      } );
+      if ( !has_near_fanout )
+      {
+        roots.push_back( n );
+      }
+    }
+    return roots;
+  }
+
+  /*! \brief Rewrites windows across the partition boundaries of ntk.
+   *
+   * Must run after `partitions.connect_outputs( ntk )`.  `make_opt` is the
+   * per-thread window optimizer factory of `mockturtle::window_rewriting`.
+   * Replaced logic is left dangling, so run `cleanup_dangling` afterwards.
+   */
+  template<typename Ntk, typename OptFactory>
+  mockturtle::window_rewriting_stats seam_rewriting( Ntk& ntk, partition_manager<Ntk>& partitions, OptFactory&& make_opt, seam_rewriting_params const& ps = {} )
+  {
+    const auto roots = seam_roots( ntk, partitions.get_seam_nodes( ntk ), ps.depth );
+
+    mockturtle::window_rewriting_params wps;
+    wps.cone_depth = ps.depth;
+    wps.max_cone_gates = ps.max_gates;
+    wps.num_threads = ps.num_threads;
+    wps.verbose = ps.verbose;
+
+    mockturtle::window_rewriting_stats st;
+    mockturtle::window_rewriting( ntk, roots, make_opt, wps, &st );
+    return st;
+  }
+
+} /* namespace oracle */